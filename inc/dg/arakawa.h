@@ -115,6 +115,21 @@ struct ArakawaX
     }
 
   private:
+    //apply each derivative to lhs and rhs in a single sweep
+    template<class ContainerType0>
+    void derivatives( const ContainerType0& lhs, const ContainerType0& rhs)
+    {
+        blas2::symv( m_bdxf, {&lhs, &rhs}, {&m_dxlhs, &m_dxrhs});
+        blas2::symv( m_bdyf, {&lhs, &rhs}, {&m_dylhs, &m_dyrhs});
+    }
+    template<class ContainerType0, class ContainerType1>
+    void derivatives( const ContainerType0& lhs, const ContainerType1& rhs)
+    {
+        blas2::symv( m_bdxf, lhs, m_dxlhs);
+        blas2::symv( m_bdyf, lhs, m_dylhs);
+        blas2::symv( m_bdxf, rhs, m_dxrhs);
+        blas2::symv( m_bdyf, rhs, m_dyrhs);
+    }
     Container m_dxlhs, m_dxrhs, m_dylhs, m_dyrhs, m_helper;
     Matrix m_bdxf, m_bdyf;
     Container m_chi, m_perp_vol;
@@ -160,10 +175,7 @@ template<class ContainerType0, class ContainerType1, class ContainerType2>
 void ArakawaX< Geometry, Matrix, Container>::operator()( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result)
 {
     //compute derivatives in x-space
-    blas2::symv( m_bdxf, lhs, m_dxlhs);
-    blas2::symv( m_bdyf, lhs, m_dylhs);
-    blas2::symv( m_bdxf, rhs, m_dxrhs);
-    blas2::symv( m_bdyf, rhs, m_dyrhs);
+    derivatives( lhs, rhs);
     blas1::subroutine( ArakawaFunctor<get_value_type<Container>>(), lhs, rhs, m_dxlhs, m_dylhs, m_dxrhs, m_dyrhs);
 
     blas2::symv( 1., m_bdxf, m_dylhs, 1., m_dyrhs);
@@ -33,7 +33,8 @@ template<class value_type>
 void average( SerialTag, unsigned nx, unsigned ny, const value_type* in0, const value_type* in1, value_type* out)
 {
     static_assert( std::is_same<value_type, double>::value, "Value type must be double!");
-    static thrust::host_vector<int64_t> h_accumulator;
+    //thread_local such that several threads may average concurrently
+    static thread_local thrust::host_vector<int64_t> h_accumulator;
     h_accumulator.resize( ny*exblas::BIN_COUNT);
     int status = 0;
     for( unsigned i=0; i<ny; i++)
@@ -50,8 +51,8 @@ template<class value_type>
 void average_mpi( SerialTag, unsigned nx, unsigned ny, const value_type* in0, const value_type* in1, value_type* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce )
 {
     static_assert( std::is_same<value_type, double>::value, "Value type must be double!");
-    static thrust::host_vector<int64_t> h_accumulator;
-    static thrust::host_vector<int64_t> h_accumulator2;
+    static thread_local thrust::host_vector<int64_t> h_accumulator;
+    static thread_local thrust::host_vector<int64_t> h_accumulator2;
     h_accumulator2.resize( ny*exblas::BIN_COUNT);
     int status = 0;
     for( unsigned i=0; i<ny; i++)
@@ -23,6 +23,17 @@ inline std::vector<int64_t> doDot_dispatch( CudaTag, unsigned size, PointerOrVal
     cudaMemcpy( &h_superacc[0], d_ptr, exblas::BIN_COUNT*sizeof(int64_t), cudaMemcpyDeviceToHost);
     return h_superacc;
 }
+//the products are computed one after the other on the device
+template<class PointerOrValue1, class PointerOrValue2>
+inline std::vector<int64_t> doDots_dispatch( CudaTag, unsigned size, const std::vector<PointerOrValue1>& x_ptrs, const std::vector<PointerOrValue2>& y_ptrs) {
+    std::vector<int64_t> h_superacc(x_ptrs.size()*exblas::BIN_COUNT);
+    for( unsigned k=0; k<x_ptrs.size(); k++)
+    {
+        std::vector<int64_t> acc = doDot_dispatch( CudaTag(), size, x_ptrs[k], y_ptrs[k]);
+        std::copy( acc.begin(), acc.end(), h_superacc.begin() + k*exblas::BIN_COUNT);
+    }
+    return h_superacc;
+}
 template<class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
 inline std::vector<int64_t> doDot_dispatch( CudaTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr) {
     static thrust::device_vector<int64_t> d_superacc(exblas::BIN_COUNT);
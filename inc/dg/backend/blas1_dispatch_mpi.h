@@ -81,6 +81,27 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, MPIVect
     return receive;
 }
 
+template< class Vector>
+std::vector<int64_t> doDots_superacc( const std::vector<const Vector*>& x, const std::vector<const Vector*>& y, MPIVectorTag)
+{
+    using container_type = typename Vector::container_type;
+    unsigned num = x.size();
+    std::vector<const container_type*> x_data( num), y_data( num);
+    for( unsigned k=0; k<num; k++)
+    {
+#ifdef DG_DEBUG
+        mpi_assert( *x[k], *y[k]);
+#endif //DG_DEBUG
+        x_data[k] = &x[k]->data(), y_data[k] = &y[k]->data();
+    }
+    //local computation
+    std::vector<int64_t> acc = doDots_superacc( x_data, y_data);
+    std::vector<int64_t> receive(num*exblas::BIN_COUNT, (int64_t)0);
+    //a single reduction for all products
+    exblas::reduce_mpi_cpu( num, acc.data(), receive.data(), x[0]->communicator(),
+        x[0]->communicator_mod(), x[0]->communicator_mod_reduce());
+    return receive;
+}
 
 template< class Subroutine, class container, class ...Containers>
 inline void doSubroutine( MPIVectorTag, Subroutine f, container&& x, Containers&&... xs)
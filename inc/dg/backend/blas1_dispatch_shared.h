@@ -48,6 +48,8 @@ namespace detail
 {
 template< class ContainerType1, class ContainerType2>
 inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const ContainerType2& y);
+template< class ContainerType>
+inline std::vector<int64_t> doDots_superacc( const std::vector<const ContainerType*>& x, const std::vector<const ContainerType*>& y);
 //we need to distinguish between Scalars and Vectors
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +75,21 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, SharedV
             do_get_pointer_or_reference(y, get_tensor_category<Vector2>()));
 }
 
+template< class Vector>
+std::vector<int64_t> doDots_superacc( const std::vector<const Vector*>& x, const std::vector<const Vector*>& y, SharedVectorTag)
+{
+    static_assert( std::is_convertible<get_value_type<Vector>, double>::value, "We only support double precision dot products at the moment!");
+    using pointer_type = get_pointer_type<const Vector&>;
+    std::vector<pointer_type> x_ptrs( x.size()), y_ptrs( y.size());
+    for( unsigned k=0; k<x.size(); k++)
+    {
+        x_ptrs[k] = do_get_pointer_or_reference( *x[k], SharedVectorTag());
+        y_ptrs[k] = do_get_pointer_or_reference( *y[k], SharedVectorTag());
+    }
+    return dg::blas1::detail::doDots_dispatch( get_execution_policy<Vector>(),
+            x[0]->size(), x_ptrs, y_ptrs);
+}
+
 template< class Subroutine, class ContainerType, class ...ContainerTypes>
 inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
 {
@@ -155,6 +155,33 @@ inline std::vector<int64_t> doDot_superacc( const Vector1& x1, const Vector2& x2
     }
     return acc;
 }
+template< class Vector>
+inline std::vector<int64_t> doDots_superacc( const std::vector<const Vector*>& x, const std::vector<const Vector*>& y, RecursiveVectorTag)
+{
+    using element_type = typename Vector::value_type;
+    unsigned num = x.size(), size = x[0]->size();
+    std::vector<int64_t> acc( num*exblas::BIN_COUNT, (int64_t)0);
+    std::vector<const element_type*> x_i( num), y_i( num);
+    for( unsigned i=0; i<size; i++)
+    {
+        for( unsigned k=0; k<num; k++)
+            x_i[k] = &(*x[k])[i], y_i[k] = &(*y[k])[i];
+        std::vector<int64_t> temp = doDots_superacc( x_i, y_i);
+        for( unsigned k=0; k<num; k++)
+        {
+            int imin = exblas::IMIN, imax = exblas::IMAX;
+            exblas::cpu::Normalize( &(temp[k*exblas::BIN_COUNT]), imin, imax);
+            for( int j=exblas::IMIN; j<=exblas::IMAX; j++)
+                acc[k*exblas::BIN_COUNT+j] += temp[k*exblas::BIN_COUNT+j];
+            if( (i+1)%128 == 0)
+            {
+                imin = exblas::IMIN, imax = exblas::IMAX;
+                exblas::cpu::Normalize( &(acc[k*exblas::BIN_COUNT]), imin, imax);
+            }
+        }
+    }
+    return acc;
+}
 /////////////////////////////////////////////////////////////////////////////////////
 #ifdef _OPENMP
 //omp tag implementation
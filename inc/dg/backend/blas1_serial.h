@@ -20,6 +20,15 @@ inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrV
         throw dg::Error(dg::Message(_ping_)<<"CPU Dot failed since one of the inputs contains NaN or Inf");
     return h_superacc;
 }
+template<class PointerOrValue1, class PointerOrValue2>
+inline std::vector<int64_t> doDots_dispatch( SerialTag, unsigned size, const std::vector<PointerOrValue1>& x_ptrs, const std::vector<PointerOrValue2>& y_ptrs) {
+    std::vector<int64_t> h_superacc(x_ptrs.size()*exblas::BIN_COUNT);
+    int status = 0;
+    exblas::exdots_cpu( size, x_ptrs.size(), x_ptrs.data(), y_ptrs.data(), &h_superacc[0], &status) ;
+    if(status != 0)
+        throw dg::Error(dg::Message(_ping_)<<"CPU Dot failed since one of the inputs contains NaN or Inf");
+    return h_superacc;
+}
 template<class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
 inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr) {
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
@@ -7,12 +7,14 @@
 
 #include <typeinfo>
 #include <limits.h>
+#include <vector>
 #include <cusp/multiply.h>
 #include <cusp/convert.h>
 #include <cusp/array1d.h>
 
 #include "config.h"
 #include "tensor_traits.h"
+#include "exceptions.h"
 
 ///@cond
 namespace dg{
@@ -115,6 +117,141 @@ inline void doSymv( Matrix&& m,
         doSymv( std::forward<Matrix>(m), x[i], y[i], CuspMatrixTag(), get_tensor_category<inner_container>());
 }
 
+//////////////////Apply the same matrix to several vectors////////////////
+//The accumulation follows the single vector symv of the same execution
+//policy (DG_FMA for OmpTag, a plain multiply-add like cusp::multiply for
+//SerialTag) such that for alpha = 1 and beta = 0 the results are bitwise
+//identical to applying the matrix to one vector after the other
+template< bool use_fma, class index_type, class value_type>
+inline void doSymv_cusp_batch_row( int i, value_type alpha,
+                    const value_type* RESTRICT val_ptr,
+                    const index_type* RESTRICT row_ptr,
+                    const index_type* RESTRICT col_ptr,
+                    unsigned num, const value_type* const * x_ptr,
+                    value_type beta, value_type* const * y_ptr)
+{
+    //the row is read once and then stays in cache for all vectors
+    for( unsigned v=0; v<num; v++)
+    {
+        value_type temp = 0.;
+        for (index_type jj = row_ptr[i]; jj < row_ptr[i+1]; jj++)
+        {
+            index_type j = col_ptr[jj];
+            if( use_fma)
+                temp = DG_FMA( val_ptr[jj], x_ptr[v][j], temp);
+            else
+                temp = temp + val_ptr[jj]*x_ptr[v][j];
+        }
+        if( beta == 0)
+            y_ptr[v][i] = alpha*temp;
+        else
+            y_ptr[v][i] = DG_FMA( alpha, temp, beta*y_ptr[v][i]);
+    }
+}
+
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_cusp_batch_dispatch(
+                    get_value_type<Vector1> alpha,
+                    Matrix&& m,
+                    const std::vector<const Vector1*>& x,
+                    get_value_type<Vector1> beta,
+                    const std::vector<Vector2*>& y,
+                    cusp::csr_format,
+                    SerialTag)
+{
+    typedef typename std::decay_t<Matrix>::index_type index_type;
+    using value_type = get_value_type<Vector1>;
+    unsigned num = x.size();
+    std::vector<const value_type*> x_ptr(num);
+    std::vector<value_type*> y_ptr(num);
+    for( unsigned v=0; v<num; v++)
+    {
+        x_ptr[v] = thrust::raw_pointer_cast(x[v]->data());
+        y_ptr[v] = thrust::raw_pointer_cast(y[v]->data());
+    }
+    const value_type* val_ptr = thrust::raw_pointer_cast( &m.values[0]);
+    const index_type* row_ptr = thrust::raw_pointer_cast( &m.row_offsets[0]);
+    const index_type* col_ptr = thrust::raw_pointer_cast( &m.column_indices[0]);
+    int rows = m.num_rows;
+    for(int i = 0; i < rows; i++)
+        doSymv_cusp_batch_row<false>( i, alpha, val_ptr, row_ptr, col_ptr, num,
+                x_ptr.data(), beta, y_ptr.data());
+}
+#ifdef _OPENMP
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_cusp_batch_dispatch(
+                    get_value_type<Vector1> alpha,
+                    Matrix&& m,
+                    const std::vector<const Vector1*>& x,
+                    get_value_type<Vector1> beta,
+                    const std::vector<Vector2*>& y,
+                    cusp::csr_format,
+                    OmpTag)
+{
+    typedef typename std::decay_t<Matrix>::index_type index_type;
+    using value_type = get_value_type<Vector1>;
+    unsigned num = x.size();
+    std::vector<const value_type*> x_ptr(num);
+    std::vector<value_type*> y_ptr(num);
+    for( unsigned v=0; v<num; v++)
+    {
+        x_ptr[v] = thrust::raw_pointer_cast(x[v]->data());
+        y_ptr[v] = thrust::raw_pointer_cast(y[v]->data());
+    }
+    const value_type* val_ptr = thrust::raw_pointer_cast( &m.values[0]);
+    const index_type* row_ptr = thrust::raw_pointer_cast( &m.row_offsets[0]);
+    const index_type* col_ptr = thrust::raw_pointer_cast( &m.column_indices[0]);
+    const value_type* const * xx = x_ptr.data();
+    value_type* const * yy = y_ptr.data();
+    int rows = m.num_rows;
+    #pragma omp parallel for
+    for(int i = 0; i < rows; i++)
+        doSymv_cusp_batch_row<true>( i, alpha, val_ptr, row_ptr, col_ptr, num,
+                xx, beta, yy);
+}
+#endif// _OPENMP
+
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_cusp_batch_dispatch(
+                    get_value_type<Vector1> alpha,
+                    Matrix&& m,
+                    const std::vector<const Vector1*>& x,
+                    get_value_type<Vector1> beta,
+                    const std::vector<Vector2*>& y,
+                    cusp::sparse_format,
+                    AnyPolicyTag)
+{
+    //no fused kernel available: apply m to one vector after the other
+    if( alpha != 1 || beta != 0)
+        throw Error( Message(_ping_)<<"Cusp matrices only support alpha = 1 and beta = 0 and not "<<alpha<<" and "<<beta);
+    for( unsigned v=0; v<x.size(); v++)
+        doSymv( std::forward<Matrix>(m), *x[v], *y[v], CuspMatrixTag(),
+                get_tensor_category<Vector1>());
+}
+
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch( get_value_type<Vector1> alpha,
+                    Matrix&& m,
+                    const std::vector<const Vector1*>& x,
+                    get_value_type<Vector1> beta,
+                    const std::vector<Vector2*>& y,
+                    CuspMatrixTag)
+{
+    static_assert( std::is_base_of<SharedVectorTag, get_tensor_category<Vector1>>::value,
+        "Batched symv with a cusp matrix needs shared vectors!");
+    static_assert( std::is_same< get_execution_policy<Vector1>, get_execution_policy<Vector2> >::value, "Execution policies must be equal!");
+    for( unsigned v=0; v<x.size(); v++)
+    {
+        if( x[v]->size() != (unsigned)m.num_cols)
+            throw Error( Message(_ping_)<<"x["<<v<<"] has the wrong size "<<x[v]->size()<<" and not "<<m.num_cols);
+        if( y[v]->size() != (unsigned)m.num_rows)
+            throw Error( Message(_ping_)<<"y["<<v<<"] has the wrong size "<<y[v]->size()<<" and not "<<m.num_rows);
+    }
+    doSymv_cusp_batch_dispatch( alpha, std::forward<Matrix>(m), x, beta, y,
+            typename std::decay_t<Matrix>::format(),
+            get_execution_policy<Vector1>());
+}
+
 } //namespace detail
 } //namespace blas2
 } //namespace dg
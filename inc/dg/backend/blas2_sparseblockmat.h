@@ -1,5 +1,6 @@
 #ifndef _DG_BLAS_SPARSEBLOCKMAT_
 #define _DG_BLAS_SPARSEBLOCKMAT_
+#include <vector>
 #include "tensor_traits.h"
 #include "tensor_traits.h"
 #include "sparseblockmat.h"
@@ -91,6 +92,81 @@ inline void doSymv_dispatch(
 }
 #endif//_OPENMP
 
+//////////////////Apply the same matrix to several vectors////////////////
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch_dispatch(
+              get_value_type<Vector1> alpha,
+              Matrix&& m,
+              const std::vector<const Vector1*>& x,
+              get_value_type<Vector1> beta,
+              const std::vector<Vector2*>& y,
+              SparseBlockMatrixTag,
+              SharedVectorTag,
+              AnyPolicyTag)
+{
+    using value_type = get_value_type<Vector1>;
+    unsigned num = x.size();
+    std::vector<const value_type*> x_ptr(num);
+    std::vector<value_type*> y_ptr(num);
+    for( unsigned v=0; v<num; v++)
+    {
+        if( (int)x[v]->size() != m.total_num_cols()) {
+            throw Error( Message(_ping_)<<"x["<<v<<"] has the wrong size "<<x[v]->size()<<" and not "<<m.total_num_cols());
+        }
+        if( (int)y[v]->size() != m.total_num_rows()) {
+            throw Error( Message(_ping_)<<"y["<<v<<"] has the wrong size "<<y[v]->size()<<" and not "<<m.total_num_rows());
+        }
+        x_ptr[v] = thrust::raw_pointer_cast(x[v]->data());
+        y_ptr[v] = thrust::raw_pointer_cast(y[v]->data());
+    }
+    m.symv( SharedVectorTag(), get_execution_policy<Vector1>(), alpha, num, x_ptr.data(), beta, y_ptr.data());
+}
+
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch_dispatch(
+              get_value_type<Vector1> alpha,
+              Matrix&& m,
+              const std::vector<const Vector1*>& x,
+              get_value_type<Vector1> beta,
+              const std::vector<Vector2*>& y,
+              SparseBlockMatrixTag,
+              RecursiveVectorTag,
+              AnyPolicyTag)
+{
+    using inner_vector1 = typename Vector1::value_type;
+    using inner_vector2 = typename Vector2::value_type;
+    unsigned num = x.size();
+    std::vector<const inner_vector1*> x_i(num);
+    std::vector<inner_vector2*> y_i(num);
+    for(unsigned i=0; i<x[0]->size(); i++)
+    {
+        for( unsigned v=0; v<num; v++)
+        {
+            x_i[v] = &(*x[v])[i];
+            y_i[v] = &(*y[v])[i];
+        }
+        doSymv_batch_dispatch( alpha, std::forward<Matrix>(m), x_i, beta, y_i,
+                SparseBlockMatrixTag(),
+                get_tensor_category<inner_vector1>(),
+                get_execution_policy<Vector1>());
+    }
+}
+
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch(
+              get_value_type<Vector1> alpha,
+              Matrix&& m,
+              const std::vector<const Vector1*>& x,
+              get_value_type<Vector1> beta,
+              const std::vector<Vector2*>& y,
+              SparseBlockMatrixTag)
+{
+    doSymv_batch_dispatch(alpha, std::forward<Matrix>(m), x, beta, y,
+            SparseBlockMatrixTag(),
+            get_tensor_category<Vector1>(),
+            get_execution_policy<Vector1>()
+            );
+}
 
 template< class Matrix, class Vector1, class Vector2>
 inline void doSymv(
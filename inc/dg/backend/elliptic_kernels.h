@@ -0,0 +1,436 @@
+#pragma once
+
+#include <vector>
+#include <initializer_list>
+#include <type_traits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+#include "config.h"
+#include "execution_policy.h"
+
+//for the fmas it is important to activate -mfma compiler flag
+
+namespace dg{
+///@cond
+//Raw pointer view of the ell sparse block format (host or omp device matrix)
+template<class value_type>
+struct EllKernelView
+{
+    const value_type* data;
+    const int* cols_idx;
+    const int* data_idx;
+    int num_rows, num_cols, blocks_per_line, n, left_size, right_size;
+    int right_range0, right_range1;
+};
+
+//Interior stencil of a matrix acting on the fastest index: if all rows but
+//the first and last use the same blocks at the same relative columns the
+//blocks are kept in a dense array
+template<class value_type>
+struct EllStencil
+{
+    EllStencil( const EllKernelView<value_type>& m)
+    {
+        const int bpl = m.blocks_per_line, n = m.n;
+        trivial = m.num_rows > 2;
+        if( !trivial) return;
+        off.resize( bpl);
+        for( int d=0; d<bpl; d++)
+            off[d] = m.cols_idx[bpl+d]-1;
+        for( int i=1; i<m.num_rows-1; i++)
+            for( int d=0; d<bpl; d++)
+                if( m.data_idx[i*bpl+d] != m.data_idx[bpl+d] ||
+                    m.cols_idx[i*bpl+d] != i + off[d])
+                    trivial = false;
+        dense.resize( n*bpl*n);
+        for( int k=0; k<n; k++)
+        for( int d=0; d<bpl; d++)
+        for( int q=0; q<n; q++)
+            dense[(k*bpl+d)*n+q] = m.data[(m.data_idx[bpl+d]*n+k)*n+q];
+    }
+    bool trivial;
+    std::vector<int> off;
+    std::vector<value_type> dense;
+};
+
+//Scratch memory of one thread in ell_elliptic2d_kernel
+template<class value_type>
+struct EllEllipticScratch
+{
+    std::vector<int> key;
+    std::vector<value_type> fx, fy, tmp, gx, gy;
+};
+//Memory of ell_elliptic2d_kernel that is kept between calls: the stencils of
+//rx, lx and jx are computed in the first call, the scratch memory of each
+//thread is allocated in the first call
+template<class value_type>
+struct EllEllipticWorkspace
+{
+    std::vector<EllStencil<value_type>> stencils;
+    std::vector<EllEllipticScratch<value_type>> scratch;
+};
+
+//out[k*row+j] = a*( M_x in)[k*row+j] + out[k*row+j]
+//M_x acts on the fastest index; in and out point to the beginning of a
+//cell row in y, i.e. to n lines of length row = n*Nx
+template<class value_type>
+inline void ell_kernel_x_row( value_type a, const EllKernelView<value_type>& m,
+        const int n, const int k, const int i,
+        const value_type* RESTRICT in, value_type* RESTRICT out)
+{
+    const int bpl = m.blocks_per_line, row = n*m.num_rows;
+    for( int kk=0; kk<n; kk++)
+    {
+        value_type temp = 0;
+        for( int d=0; d<bpl; d++)
+        {
+            const value_type* B = &m.data[(m.data_idx[i*bpl+d]*n+kk)*n];
+            const value_type* X = &in[k*row + m.cols_idx[i*bpl+d]*n];
+            for( int q=0; q<n; q++)
+                temp = DG_FMA( B[q], X[q], temp);
+        }
+        out[k*row+i*n+kk] = DG_FMA( a, temp, out[k*row+i*n+kk]);
+    }
+}
+template<class value_type, int n, int blocks_per_line>
+inline void ell_kernel_x( value_type a, const EllKernelView<value_type>& m,
+        const EllStencil<value_type>& st,
+        const value_type* RESTRICT in, value_type* RESTRICT out)
+{
+    const int row = n*m.num_rows;
+    if( !st.trivial)
+    {
+        for( int k=0; k<n; k++)
+            for( int i=0; i<m.num_rows; i++)
+                ell_kernel_x_row( a, m, n, k, i, in, out);
+        return;
+    }
+    value_type dprivate[n*blocks_per_line*n];
+    int off[blocks_per_line];
+    for( int p=0; p<n*blocks_per_line*n; p++)
+        dprivate[p] = st.dense[p];
+    for( int d=0; d<blocks_per_line; d++)
+        off[d] = st.off[d];
+    for( int k=0; k<n; k++)
+    {
+        ell_kernel_x_row( a, m, n, k, 0, in, out);
+        const value_type* RESTRICT X = &in[k*row];
+        value_type* RESTRICT Y = &out[k*row];
+        for( int i=1; i<m.num_rows-1; i++)
+            for( int kk=0; kk<n; kk++)
+            {
+                value_type temp = 0;
+                for( int d=0; d<blocks_per_line; d++)
+                    for( int q=0; q<n; q++)
+                        temp = DG_FMA( dprivate[(kk*blocks_per_line+d)*n+q],
+                            X[(i+off[d])*n+q], temp);
+                Y[i*n+kk] = DG_FMA( a, temp, Y[i*n+kk]);
+            }
+        ell_kernel_x_row( a, m, n, k, m.num_rows-1, in, out);
+    }
+}
+
+//out[k*row+j] = a*(M_y x)[cell row c of plane s] + out[k*row+j]
+//rows(d) gives the cell rows of the input
+template<class value_type, int n, int blocks_per_line, class Rows>
+inline void ell_kernel_y( value_type a, const EllKernelView<value_type>& m,
+        const int c, Rows rows, value_type* RESTRICT out)
+{
+    const int row = m.right_size;
+    const value_type* X[blocks_per_line];
+    value_type dprivate[n*blocks_per_line*n];
+    for( int d=0; d<blocks_per_line; d++)
+    {
+        X[d] = rows( m.cols_idx[c*blocks_per_line+d]);
+        for( int k=0; k<n; k++)
+            for( int q=0; q<n; q++)
+                dprivate[(k*blocks_per_line+d)*n+q] =
+                    a*m.data[(m.data_idx[c*blocks_per_line+d]*n+k)*n+q];
+    }
+    for( int k=0; k<n; k++)
+    {
+        value_type* RESTRICT Y = &out[k*row];
+        for( int j=0; j<row; j++)
+        {
+            value_type temp = Y[j];
+            for( int d=0; d<blocks_per_line; d++)
+                for( int q=0; q<n; q++)
+                    temp = DG_FMA( dprivate[(k*blocks_per_line+d)*n+q],
+                        X[d][q*row+j], temp);
+            Y[j] = temp;
+        }
+    }
+}
+
+//general polynomial order and number of blocks
+template<class value_type>
+inline void ell_kernel_x( value_type a, const EllKernelView<value_type>& m,
+        const int n, const value_type* RESTRICT in, value_type* RESTRICT out)
+{
+    for( int k=0; k<n; k++)
+        for( int i=0; i<m.num_rows; i++)
+            ell_kernel_x_row( a, m, n, k, i, in, out);
+}
+template<class value_type, class Rows>
+inline void ell_kernel_y( value_type a, const EllKernelView<value_type>& m,
+        const int n, const int c, Rows rows, value_type* RESTRICT out)
+{
+    const int bpl = m.blocks_per_line, row = m.right_size;
+    for( int d=0; d<bpl; d++)
+    {
+        const value_type* X = rows( m.cols_idx[c*bpl+d]);
+        for( int k=0; k<n; k++)
+        for( int q=0; q<n; q++)
+        {
+            const value_type b = a*m.data[(m.data_idx[c*bpl+d]*n+k)*n+q];
+            for( int j=0; j<row; j++)
+                out[k*row+j] = DG_FMA( b, X[q*row+j], out[k*row+j]);
+        }
+    }
+}
+
+//dispatch the number of blocks per line (n_t == 0 means any n)
+template<class value_type, int n_t>
+inline void call_ell_kernel_x( value_type a, const EllKernelView<value_type>& m,
+        const EllStencil<value_type>& st, const int n,
+        const value_type* RESTRICT in, value_type* RESTRICT out)
+{
+    constexpr int n_c = n_t > 0 ? n_t : 1;
+    if( n_t == 0)
+        ell_kernel_x( a, m, n, in, out);
+    else if( m.blocks_per_line == 1)
+        ell_kernel_x<value_type, n_c, 1>( a, m, st, in, out);
+    else if( m.blocks_per_line == 2)
+        ell_kernel_x<value_type, n_c, 2>( a, m, st, in, out);
+    else if( m.blocks_per_line == 3)
+        ell_kernel_x<value_type, n_c, 3>( a, m, st, in, out);
+    else if( m.blocks_per_line == 4)
+        ell_kernel_x<value_type, n_c, 4>( a, m, st, in, out);
+    else
+        ell_kernel_x( a, m, n, in, out);
+}
+template<class value_type, int n_t, class Rows>
+inline void call_ell_kernel_y( value_type a, const EllKernelView<value_type>& m,
+        const int n, const int c, Rows rows, value_type* RESTRICT out)
+{
+    constexpr int n_c = n_t > 0 ? n_t : 1;
+    if( n_t == 0)
+        ell_kernel_y( a, m, n, c, rows, out);
+    else if( m.blocks_per_line == 1)
+        ell_kernel_y<value_type, n_c, 1>( a, m, c, rows, out);
+    else if( m.blocks_per_line == 2)
+        ell_kernel_y<value_type, n_c, 2>( a, m, c, rows, out);
+    else if( m.blocks_per_line == 3)
+        ell_kernel_y<value_type, n_c, 3>( a, m, c, rows, out);
+    else if( m.blocks_per_line == 4)
+        ell_kernel_y<value_type, n_c, 4>( a, m, c, rows, out);
+    else
+        ell_kernel_y( a, m, n, c, rows, out);
+}
+
+//call row( i) for 0 <= i < size
+template<class Row>
+inline void ell_for_each_row( SerialTag, int size, Row&& row)
+{
+    for( int i=0; i<size; i++)
+        row( i);
+}
+//distribute the rows among the threads of the enclosing parallel region
+template<class Row>
+inline void ell_for_each_row( OmpTag, int size, Row&& row)
+{
+#ifdef _OPENMP
+    #pragma omp for schedule(static) //consecutive rows share the cache
+#endif //_OPENMP
+    for( int i=0; i<size; i++)
+        row( i);
+}
+
+/* Fused matrix-free application of the two-dimensional elliptic operator
+ * y = alpha W ( -L_x f_x - L_y f_y + j ( J_x x + J_y x) ) + beta y
+ * with f_x = sigma( t_xx R_x x + t_xy R_y x), f_y = sigma( t_yx R_x x + t_yy R_y x)
+ * (the jump terms are multiplied by sigma t if chi_weight_jump) and W = w or
+ * W = 1/w if divide.
+ * The vector is processed cell row (in y) by cell row. The fluxes of the few
+ * cell rows that the y-divergence needs are kept in a small per-thread cache,
+ * such that no full size temporaries are written and each input vector is
+ * streamed only once.
+ * The x-matrices have right_size 1 and left_size Nz*Ny*n, the y-matrices have
+ * right_size n*Nx and left_size Nz.
+ * With OmpTag the cell rows are shared among the threads of the enclosing
+ * parallel region, with SerialTag the calling thread computes all rows.
+ * The stencils in ws must be computed and ws.scratch must hold one element
+ * per thread (cf. ell_elliptic2d).
+ */
+template<class value_type, int n_t, class ExecutionPolicy>
+void ell_elliptic2d_kernel( ExecutionPolicy policy, value_type alpha,
+        const EllKernelView<value_type>& rx, const EllKernelView<value_type>& ry,
+        const EllKernelView<value_type>& lx, const EllKernelView<value_type>& ly,
+        const EllKernelView<value_type>& jx, const EllKernelView<value_type>& jy,
+        const int n_rt, value_type jfactor, bool chi_weight_jump,
+        const value_type* RESTRICT sigma,
+        const value_type* RESTRICT txx, const value_type* RESTRICT txy,
+        const value_type* RESTRICT tyx, const value_type* RESTRICT tyy,
+        const value_type* RESTRICT w, bool divide,
+        const value_type* RESTRICT x, value_type beta, value_type* RESTRICT y,
+        EllEllipticWorkspace<value_type>& ws)
+{
+    const int n = n_t > 0 ? n_t : n_rt;
+    const int Ny = ry.num_rows, Nz = ry.left_size;
+    const int row = ry.right_size, cell_row = n*row;
+    int thread = 0;
+#ifdef _OPENMP
+    if( std::is_same<ExecutionPolicy, OmpTag>::value)
+        thread = omp_get_thread_num();
+#endif //_OPENMP
+    //the cache holds the fluxes of the last computed cell rows
+    const int slots = ly.blocks_per_line + 1;
+    EllEllipticScratch<value_type>& scratch = ws.scratch[thread];
+    scratch.key.assign( slots, -1);
+    std::vector<int>& key = scratch.key;
+    std::vector<value_type>& fx = scratch.fx, & fy = scratch.fy,
+        & tmp = scratch.tmp, & gx = scratch.gx, & gy = scratch.gy;
+    fx.resize( slots*cell_row), fy.resize( slots*cell_row);
+    tmp.resize( cell_row), gx.resize( cell_row), gy.resize( cell_row);
+    const EllStencil<value_type>& srx = ws.stencils[0], & slx = ws.stencils[1],
+        & sjx = ws.stencils[2];
+    int next = 0;
+    auto flux = [&]( int s, int c) -> int
+    {
+        const int sc = s*Ny + c;
+        for( int l=0; l<slots; l++)
+            if( key[l] == sc)
+                return l;
+        const int l = next;
+        next = (next+1)%slots, key[l] = sc;
+        value_type* RESTRICT fxl = &fx[l*cell_row];
+        value_type* RESTRICT fyl = &fy[l*cell_row];
+        for( int p=0; p<cell_row; p++)
+            fxl[p] = fyl[p] = 0;
+        call_ell_kernel_x<value_type, n_t>( 1., rx, srx, n, &x[sc*cell_row], fxl);
+        call_ell_kernel_y<value_type, n_t>( 1., ry, n, c, [&](int cc){
+                return &x[(s*Ny+cc)*cell_row];}, fyl);
+        const int I0 = sc*cell_row;
+        for( int p=0; p<cell_row; p++)
+        {
+            value_type dx = fxl[p], dy = fyl[p];
+            fxl[p] = sigma[I0+p]*DG_FMA( txx[I0+p], dx, txy[I0+p]*dy);
+            fyl[p] = sigma[I0+p]*DG_FMA( tyx[I0+p], dx, tyy[I0+p]*dy);
+        }
+        return l;
+    };
+    ell_for_each_row( policy, Nz*Ny, [&]( int sc)
+    {
+        const int s = sc/Ny, i = sc%Ny;
+        for( int p=0; p<cell_row; p++)
+            tmp[p] = 0;
+        //now take divergence
+        call_ell_kernel_y<value_type, n_t>( -1., ly, n, i, [&](int cc){
+                return &fy[flux( s, cc)*cell_row];}, tmp.data());
+        call_ell_kernel_x<value_type, n_t>( -1., lx, slx, n, &fx[flux( s, i)*cell_row], tmp.data());
+        const int I0 = sc*cell_row;
+        //add jump terms
+        if( 0 != jfactor)
+        {
+            if( chi_weight_jump)
+            {
+                for( int p=0; p<cell_row; p++)
+                    gx[p] = gy[p] = 0;
+                call_ell_kernel_x<value_type, n_t>( jfactor, jx, sjx, n, &x[I0], gx.data());
+                call_ell_kernel_y<value_type, n_t>( jfactor, jy, n, i, [&](int cc){
+                        return &x[(s*Ny+cc)*cell_row];}, gy.data());
+                for( int p=0; p<cell_row; p++)
+                    tmp[p] += sigma[I0+p]*(
+                        DG_FMA( txx[I0+p], gx[p], txy[I0+p]*gy[p]) +
+                        DG_FMA( tyx[I0+p], gx[p], tyy[I0+p]*gy[p]));
+            }
+            else
+            {
+                call_ell_kernel_x<value_type, n_t>( jfactor, jx, sjx, n, &x[I0], tmp.data());
+                call_ell_kernel_y<value_type, n_t>( jfactor, jy, n, i, [&](int cc){
+                        return &x[(s*Ny+cc)*cell_row];}, tmp.data());
+            }
+        }
+        if( beta == 0)
+        {
+            if( divide)
+                for( int p=0; p<cell_row; p++)
+                    y[I0+p] = alpha*tmp[p]/w[I0+p];
+            else
+                for( int p=0; p<cell_row; p++)
+                    y[I0+p] = alpha*tmp[p]*w[I0+p];
+        }
+        else
+        {
+            if( divide)
+                for( int p=0; p<cell_row; p++)
+                    y[I0+p] = DG_FMA( beta, y[I0+p], alpha*tmp[p]/w[I0+p]);
+            else
+                for( int p=0; p<cell_row; p++)
+                    y[I0+p] = DG_FMA( beta, y[I0+p], alpha*tmp[p]*w[I0+p]);
+        }
+    });
+}
+
+//checks that the matrices have the layout assumed by ell_elliptic2d_kernel
+template<class value_type>
+bool ell_elliptic2d_layout( const EllKernelView<value_type>& rx,
+        const EllKernelView<value_type>& ry, const EllKernelView<value_type>& lx,
+        const EllKernelView<value_type>& ly, const EllKernelView<value_type>& jx,
+        const EllKernelView<value_type>& jy, int size)
+{
+    const int n = rx.n, Nx = rx.num_rows, Ny = ry.num_rows, Nz = ry.left_size;
+    if( n*n*Nx*Ny*Nz != size)
+        return false;
+    for( auto m : {rx, lx, jx})
+        if( m.n != n || m.num_rows != Nx || m.num_cols != Nx ||
+            m.left_size != Nz*Ny*n || m.right_size != 1 ||
+            m.right_range0 != 0 || m.right_range1 != 1)
+            return false;
+    for( auto m : {ry, ly, jy})
+        if( m.n != n || m.num_rows != Ny || m.num_cols != Ny ||
+            m.left_size != Nz || m.right_size != n*Nx ||
+            m.right_range0 != 0 || m.right_range1 != n*Nx)
+            return false;
+    return true;
+}
+
+template<class value_type, class ExecutionPolicy>
+void ell_elliptic2d( ExecutionPolicy policy, value_type alpha,
+        const EllKernelView<value_type>& rx, const EllKernelView<value_type>& ry,
+        const EllKernelView<value_type>& lx, const EllKernelView<value_type>& ly,
+        const EllKernelView<value_type>& jx, const EllKernelView<value_type>& jy,
+        value_type jfactor, bool chi_weight_jump,
+        const value_type* sigma, const value_type* txx, const value_type* txy,
+        const value_type* tyx, const value_type* tyy,
+        const value_type* w, bool divide,
+        const value_type* x, value_type beta, value_type* y,
+        EllEllipticWorkspace<value_type>& ws)
+{
+    //specialize for the most common polynomial orders
+    switch( rx.n)
+    {
+        case 1: ell_elliptic2d_kernel<value_type, 1>( policy, alpha, rx, ry, lx, ly,
+            jx, jy, 1, jfactor, chi_weight_jump, sigma, txx, txy, tyx, tyy,
+            w, divide, x, beta, y, ws);
+            break;
+        case 2: ell_elliptic2d_kernel<value_type, 2>( policy, alpha, rx, ry, lx, ly,
+            jx, jy, 2, jfactor, chi_weight_jump, sigma, txx, txy, tyx, tyy,
+            w, divide, x, beta, y, ws);
+            break;
+        case 3: ell_elliptic2d_kernel<value_type, 3>( policy, alpha, rx, ry, lx, ly,
+            jx, jy, 3, jfactor, chi_weight_jump, sigma, txx, txy, tyx, tyy,
+            w, divide, x, beta, y, ws);
+            break;
+        case 4: ell_elliptic2d_kernel<value_type, 4>( policy, alpha, rx, ry, lx, ly,
+            jx, jy, 4, jfactor, chi_weight_jump, sigma, txx, txy, tyx, tyy,
+            w, divide, x, beta, y, ws);
+            break;
+        default: ell_elliptic2d_kernel<value_type, 0>( policy, alpha, rx, ry, lx, ly,
+            jx, jy, rx.n, jfactor, chi_weight_jump, sigma, txx, txy, tyx, tyy,
+            w, divide, x, beta, y, ws);
+    }
+}
+///@endcond
+}//namespace dg
@@ -24,6 +24,7 @@
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
+#include "exdot_serial.h"
 #include <omp.h>
 
 namespace dg
@@ -242,6 +243,50 @@ void ExDOTFPE(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c, in
     for ( int i=0; i<maxthreads; i++)
         if( error[i] == true) *err = true;
 }
+
+template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2>
+void ExDOTSFPE(int N, unsigned num, const PointerOrValue1* a, const PointerOrValue2* b, int64_t* h_superacc, bool* err) {
+    int maxthreads = omp_get_max_threads();
+    std::vector<int64_t> acc(maxthreads*num*BIN_COUNT,0);
+    std::vector<bool> error( maxthreads, false);
+    int tnum_used = 1;
+
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int tnum = omp_get_num_threads();
+        #pragma omp single
+        tnum_used = tnum;
+        int l = ((tid * int64_t(N)) / tnum) & ~7ul; // & ~7ul == round down to multiple of 8
+        int r = tid+1 == tnum ? N : ((((tid+1) * int64_t(N)) / tnum) & ~7ul);
+        bool thread_error = false;
+        ExDOTSFPE_range<CACHE>( l, r, num, a, b, &acc[tid*num*BIN_COUNT], &thread_error);
+        error[tid] = thread_error;
+        for( unsigned k=0; k<num; k++)
+        {
+            int imin=IMIN, imax=IMAX;
+            Normalize(&acc[(tid*num+k)*BIN_COUNT], imin, imax);
+        }
+    }
+    //sum the normalized thread results
+    for( unsigned k=0; k<num; k++)
+    {
+        for( int i=0; i<BIN_COUNT; i++)
+            h_superacc[k*BIN_COUNT+i] = acc[k*BIN_COUNT+i];
+        for( int t=1; t<tnum_used; t++)
+        {
+            for( int i=0; i<BIN_COUNT; i++)
+                h_superacc[k*BIN_COUNT+i] += acc[(t*num+k)*BIN_COUNT+i];
+            if( t%128 == 0)
+            {
+                int imin=IMIN, imax=IMAX;
+                Normalize(&h_superacc[k*BIN_COUNT], imin, imax);
+            }
+        }
+    }
+    for ( int i=0; i<maxthreads; i++)
+        if( error[i] == true) *err = true;
+}
 }//namespace cpu
 ///@endcond
 
@@ -279,5 +324,22 @@ void exdot_omp(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
     if( error ) *status = 1;
 }
 
+
+///@brief OpenMP parallel version of several exact dot products in one pass
+///@copydoc hide_exdots
+template<class PointerOrValue1, class PointerOrValue2, size_t NBFPE=8>
+void exdots_omp(unsigned size, unsigned num, const PointerOrValue1* x1_ptrs, const PointerOrValue2* x2_ptrs, int64_t* h_superacc, int* status){
+    static_assert( has_floating_value<PointerOrValue1>::value, "PointerOrValue1 needs to be T or T* with T one of (const) float or (const) double");
+    static_assert( has_floating_value<PointerOrValue2>::value, "PointerOrValue2 needs to be T or T* with T one of (const) float or (const) double");
+    bool error = false;
+#ifndef _WITHOUT_VCL
+    cpu::ExDOTSFPE<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size, num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#else
+    cpu::ExDOTSFPE<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size, num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#endif//_WITHOUT_VCL
+    *status = 0;
+    if( error ) *status = 1;
+}
+
 }//namespace exblas
 } //namespace dg
@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
@@ -136,6 +137,45 @@ void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c
 #endif// _WITHOUT_VCL
     cache.Flush();
 }
+
+//Accumulate num dot products x_k^T y_k over the index range [l,r) into acc[k*BIN_COUNT]
+//The range is traversed in chunks that fit into cache and all products are
+//accumulated chunk by chunk, such that vectors appearing in several pairs are
+//read from memory only once (l must be a multiple of 8)
+template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2>
+void ExDOTSFPE_range(int l, int r, unsigned num, const PointerOrValue1* a, const PointerOrValue2* b, int64_t* acc, bool* error) {
+    const int chunk = 4096;
+    for( int c = l; c < r; c += chunk)
+    {
+        int e = std::min( c + chunk, r);
+        for( unsigned k=0; k<num; k++)
+        {
+            CACHE cache(&acc[k*BIN_COUNT]);
+#ifndef _WITHOUT_VCL
+            int i = c;
+            for(; i+8 <= e; i+=8) {
+                vcl::Vec8d x  = make_vcl_vec8d(a[k],i)*make_vcl_vec8d(b[k],i);
+                vcl::Vec8db finite = vcl::is_finite( x);
+                if( !vcl::horizontal_and( finite) ) *error = true;
+                cache.Accumulate(x);
+            }
+            if( i != e) {
+                vcl::Vec8d x  = make_vcl_vec8d(a[k],i,e-i)*make_vcl_vec8d(b[k],i,e-i);
+                vcl::Vec8db finite = vcl::is_finite( x);
+                if( !vcl::horizontal_and( finite) ) *error = true;
+                cache.Accumulate(x);
+            }
+#else// _WITHOUT_VCL
+            for(int i = c; i < e; i++) {
+                double x = get_element(a[k],i)*get_element(b[k],i);
+                if( !std::isfinite(x) ) *error = true;
+                cache.Accumulate(x);
+            }
+#endif// _WITHOUT_VCL
+            cache.Flush();
+        }
+    }
+}
 }//namespace cpu
 ///@endcond
 
@@ -193,6 +233,26 @@ void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c
  * @param status 0 indicates success, 1 indicates an input value was NaN or Inf
  */
 
+/*!@class hide_exdots
+ *
+ * Accumulate \c num exact sums \f[ \sum_{i=0}^{N-1} x_{1,k,i} x_{2,k,i} \f] into
+ * superaccumulators. The arrays are traversed in chunks that fit into cache and all products
+ * of a chunk are accumulated before the next chunk is read. This saves memory
+ * bandwidth when the same array appears in several pairs. Each result is the
+ * same as the one of the corresponding single dot product.
+ * @ingroup highlevel
+ * @tparam NBFPE size of the floating point expansion (should be between 3 and 8)
+ * @tparam PointerOrValue must be one of <tt> T, T&&, T&, const T&, T* or const T* </tt>, where \c T is either \c float or \c double. If it is a pointer type, then we iterate through the pointed data from 0 to \c size, else we consider the value constant in every iteration.
+ * @param size size N of the arrays to sum
+ * @param num number of dot products
+ * @param x1_ptrs \c num first arrays
+ * @param x2_ptrs \c num second arrays
+ * @param h_superacc pointer to an array of 64 bit integegers in **host memory**
+ * with size at least \c num*exblas::BIN_COUNT; the k-th superaccumulator
+ * starts at \c h_superacc+k*exblas::BIN_COUNT (contents are overwritten)
+ * @param status 0 indicates success, 1 indicates an input value was NaN or Inf
+ */
+
 ///@brief Serial version of exact dot product
 ///@copydoc hide_exdot2
 ///@copydoc hide_hostacc
@@ -234,5 +294,24 @@ void exdot_cpu(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
 
 
 
+
+///@brief Serial version of several exact dot products in one pass
+///@copydoc hide_exdots
+template<class PointerOrValue1, class PointerOrValue2, size_t NBFPE=8>
+void exdots_cpu(unsigned size, unsigned num, const PointerOrValue1* x1_ptrs, const PointerOrValue2* x2_ptrs, int64_t* h_superacc, int* status){
+    static_assert( has_floating_value<PointerOrValue1>::value, "PointerOrValue1 needs to be T or T* with T one of (const) float or (const) double");
+    static_assert( has_floating_value<PointerOrValue2>::value, "PointerOrValue2 needs to be T or T* with T one of (const) float or (const) double");
+    for( unsigned i=0; i<num*exblas::BIN_COUNT; i++)
+        h_superacc[i] = 0;
+    bool error = false;
+#ifndef _WITHOUT_VCL
+    cpu::ExDOTSFPE_range<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >(0, (int)size, num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#else
+    cpu::ExDOTSFPE_range<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >(0, (int)size, num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#endif//_WITHOUT_VCL
+    *status = 0;
+    if( error ) *status = 1;
+}
+
 }//namespace exblas
 } //namespace dg
@@ -10,6 +10,7 @@
 #include <array>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include "accumulate.h"
 
 namespace dg
@@ -20,53 +21,210 @@ namespace exblas {
 namespace detail{
 //we keep track of communicators that were created in the past
 static std::map<MPI_Comm, std::array<MPI_Comm, 2>> comm_mods;
+
+//A shared memory window on a node communicator: one slot of superaccumulators
+//per process plus one slot for the result, twice. Consecutive reductions
+//alternate between the two halves such that a process can write its next
+//input while rank 0 still reads the previous ones (the counters are the same
+//on all processes since reductions are collective)
+struct NodeWindow
+{
+    MPI_Win win = MPI_WIN_NULL;
+    int64_t* base = nullptr;
+    unsigned capacity = 0; //number of superaccumulators per slot
+    unsigned starts = 0, finishes = 0;
+    //the node leaders sum their results in blocks of at most max_groups
+    //processes: blocks[0] contains the calling process, blocks[l+1] the
+    //rank 0 processes of blocks[l] (MPI_COMM_NULL if the calling process is
+    //not among them); empty if not rank 0 in comm_mod
+    std::vector<MPI_Comm> blocks;
+};
+//the node communicators created by mpi_reduce_communicator
+static std::map<MPI_Comm, NodeWindow> node_windows;
+
+//return the window of comm_mod large enough for num_superacc (collective in comm_mod)
+//or nullptr if the processes in comm_mod do not share memory
+static NodeWindow* node_window( MPI_Comm comm_mod, unsigned num_superacc)
+{
+    auto it = node_windows.find( comm_mod);
+    if( it == node_windows.end())
+        return nullptr;
+    NodeWindow& w = it->second;
+    if( w.capacity < num_superacc)
+    {
+        if( w.win != MPI_WIN_NULL)
+        {
+            MPI_Win_unlock_all( w.win);
+            MPI_Win_free( &w.win);
+        }
+        int rank, size;
+        MPI_Comm_rank( comm_mod, &rank);
+        MPI_Comm_size( comm_mod, &size);
+        MPI_Aint bytes = rank == 0 ?
+            (MPI_Aint)2*(size+1)*num_superacc*BIN_COUNT*sizeof(int64_t) : 0;
+        int64_t* local;
+        MPI_Win_allocate_shared( bytes, sizeof(int64_t), MPI_INFO_NULL,
+            comm_mod, &local, &w.win); //collective
+        MPI_Aint seg_size;
+        int disp_unit;
+        MPI_Win_shared_query( w.win, 0, &seg_size, &disp_unit, &w.base);
+        MPI_Win_lock_all( MPI_MODE_NOCHECK, w.win);
+        w.capacity = num_superacc;
+    }
+    return &w;
+}
+//split comm into groups of at most mod processes that share memory and
+//block the group leaders such that no more than max_groups normalized
+//superaccumulators are summed at once
+static void mpi_reduce_communicator(MPI_Comm comm, MPI_Comm* comm_mod, MPI_Comm* comm_mod_reduce, int mod, int max_groups){
+    assert( comm != MPI_COMM_NULL);
+    assert( max_groups > 1);
+    if( comm_mods.count(comm) == 1 )
+    {
+        *comm_mod = comm_mods[comm][0];
+        *comm_mod_reduce = comm_mods[comm][1];
+        return;
+    }
+    int rank, node_rank;
+    MPI_Comm_rank( comm, &rank);
+    MPI_Comm node;
+    MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node); //collective call
+    MPI_Comm_rank( node, &node_rank);
+    //all processes in comm_mod share memory; rank 0 in comm is rank 0 in comm_mod
+    MPI_Comm_split( node, node_rank/mod, rank, comm_mod); //collective call
+    MPI_Comm_free( &node);
+    int rank_mod;
+    MPI_Comm_rank( *comm_mod, &rank_mod);
+    MPI_Comm_split( comm, rank_mod == 0 ? 0 : MPI_UNDEFINED, rank,
+        comm_mod_reduce); //collective
+    //returns MPI_COMM_NULL to processes that are not in the group
+    NodeWindow w;
+    MPI_Comm leaders = *comm_mod_reduce;
+    while( leaders != MPI_COMM_NULL)
+    {
+        int rank_l, size_l;
+        MPI_Comm_rank( leaders, &rank_l);
+        MPI_Comm_size( leaders, &size_l);
+        if( size_l <= max_groups)
+        {
+            w.blocks.push_back( leaders);
+            break;
+        }
+        MPI_Comm block;
+        MPI_Comm_split( leaders, rank_l/max_groups, rank_l, &block); //collective in leaders
+        int rank_b;
+        MPI_Comm_rank( block, &rank_b);
+        w.blocks.push_back( block);
+        MPI_Comm next;
+        MPI_Comm_split( leaders, rank_b == 0 ? 0 : MPI_UNDEFINED, rank_l, &next);
+        if( next == MPI_COMM_NULL) //the result comes from rank 0 in block
+            w.blocks.push_back( MPI_COMM_NULL);
+        if( leaders != *comm_mod_reduce)
+            MPI_Comm_free( &leaders);
+        leaders = next;
+    }
+    node_windows[*comm_mod] = w;
+    comm_mods[comm] = {*comm_mod, *comm_mod_reduce};
+}
 }
 ///@endcond
 /**
  * @brief This function can be used to partition communicators for the \c exblas::reduce_mpi_cpu function
  *
+ * The communicator is split by shared memory node (\c MPI_Comm_split_type) and
+ * nodes with more than 128 processes are split further. Inside a node the
+ * reduction functions combine the superaccumulators through a shared memory
+ * window such that only the processes in \c comm_mod_reduce (one per node)
+ * communicate via messages. These sum their results in blocks of at most 128
+ * processes with a normalization between the levels, so there is no limit
+ * on the number of nodes.
  * @ingroup highlevel
  * @param comm the input communicator (unmodified, may not be \c MPI_COMM_NULL)
- * @param comm_mod a subgroup of comm (comm is split)
+ * @param comm_mod a subgroup of comm (comm is split), the processes on the same node (at most 128)
  * @param comm_mod_reduce a subgroup of comm, consists of all rank 0 processes in comm_mod
  * @note the creation of new communicators involves communication between all participation processes (comm in this case).
  * @attention In order to avoid excessive creation of new MPI communicators (there is a limit to how many a program can create), the function keeps record of which communicators it has been called with. If you repeatedly call this function with the same \c comm only the first call will actually create new communicators.
  */
 static void mpi_reduce_communicator(MPI_Comm comm, MPI_Comm* comm_mod, MPI_Comm* comm_mod_reduce){
-    assert( comm != MPI_COMM_NULL);
-    if( detail::comm_mods.count(comm) == 1 )
+    //a sum of 128 normalized superaccumulators cannot overflow
+    detail::mpi_reduce_communicator( comm, comm_mod, comm_mod_reduce, 128, 128);
+}
+
+///@cond
+namespace detail{
+static void normalize_superacc( unsigned num_superacc, int64_t* acc)
+{
+    for( unsigned i=0; i<num_superacc; i++)
     {
-        *comm_mod = detail::comm_mods[comm][0];
-        *comm_mod_reduce = detail::comm_mods[comm][1];
-        return;
+        int imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize(&acc[i*exblas::BIN_COUNT], imin, imax);
     }
-    else
+}
+//Sum the normalized superaccumulators in of all processes in comm_mod through
+//the shared window and start the reduction of the node results in the first
+//block of node leaders; the request is MPI_REQUEST_NULL on all other processes
+static void node_reduce_start( unsigned num_superacc, const int64_t* in, int64_t* out, MPI_Comm comm_mod, NodeWindow* w, MPI_Request* request)
+{
+    int rank, size;
+    MPI_Comm_rank( comm_mod, &rank);
+    MPI_Comm_size( comm_mod, &size);
+    const unsigned slot = w->capacity*BIN_COUNT;
+    int64_t* slots = w->base + (w->starts++ % 2)*size*slot;
+    std::copy( in, in+num_superacc*BIN_COUNT, slots + rank*slot);
+    MPI_Win_sync( w->win);
+    MPI_Barrier( comm_mod);
+    MPI_Win_sync( w->win);
+    *request = MPI_REQUEST_NULL;
+    if( rank != 0)
+        return;
+    std::copy( slots, slots+num_superacc*BIN_COUNT, out);
+    for( int r=1; r<size; r++)
+        for( unsigned k=0; k<num_superacc*BIN_COUNT; k++)
+            out[k] += slots[r*slot+k];
+    normalize_superacc( num_superacc, out);
+    MPI_Iallreduce( MPI_IN_PLACE, out, num_superacc*BIN_COUNT, MPI_LONG, MPI_SUM, w->blocks[0], request);
+}
+//Wait for the reduction among nodes and distribute the result on the node
+static void node_reduce_finish( unsigned num_superacc, int64_t* out, MPI_Comm comm_mod, NodeWindow* w, MPI_Request* request)
+{
+    MPI_Wait( request, MPI_STATUS_IGNORE);
+    //sum the normalized block results level by level and broadcast back
+    const unsigned levels = w->blocks.size();
+    for( unsigned l=1; l<levels; l++)
     {
-        int mod = 128;
-        int rank, size;
-        MPI_Comm_rank( comm, &rank);
-        MPI_Comm_size( comm, &size);
-        MPI_Comm_split( comm, rank/mod, rank%mod, comm_mod); //collective call
-        MPI_Group group, reduce_group;
-        MPI_Comm_group( comm, &group); //local call
-        int reduce_size=(int)ceil((double)size/(double)mod);
-        std::vector<int> reduce_ranks(reduce_size);
-        for( int i=0; i<reduce_size; i++)
-            reduce_ranks[i] = i*mod;
-        MPI_Group_incl( group, reduce_size, reduce_ranks.data(), &reduce_group); //local
-        MPI_Comm_create( comm, reduce_group, comm_mod_reduce); //collective
-        MPI_Group_free( &group);
-        MPI_Group_free( &reduce_group);
-        detail::comm_mods[comm] = {*comm_mod, *comm_mod_reduce};
-        //returns MPI_COMM_NULL to processes that are not in the group
+        if( w->blocks[l] == MPI_COMM_NULL)
+            break;
+        normalize_superacc( num_superacc, out);
+        MPI_Allreduce( MPI_IN_PLACE, out, num_superacc*BIN_COUNT, MPI_LONG, MPI_SUM, w->blocks[l]);
     }
+    for( unsigned l=levels; l>1; l--)
+        MPI_Bcast( out, num_superacc*BIN_COUNT, MPI_LONG, 0, w->blocks[l-2]);
+    int rank, size;
+    MPI_Comm_rank( comm_mod, &rank);
+    MPI_Comm_size( comm_mod, &size);
+    if( size == 1)
+        return;
+    int64_t* result = w->base + (2*size + w->finishes++ % 2)*w->capacity*BIN_COUNT;
+    if( rank == 0)
+        std::copy( out, out+num_superacc*BIN_COUNT, result);
+    MPI_Win_sync( w->win);
+    MPI_Barrier( comm_mod);
+    MPI_Win_sync( w->win);
+    if( rank != 0)
+        std::copy( result, result+num_superacc*BIN_COUNT, out);
 }
+}//namespace detail
+///@endcond
 
 /*! @brief reduce a number of superaccumulators distributed among mpi processes
 
 We cannot sum more than 256 accumulators before we need to normalize again, so we need to split the reduction into several steps if more than 256 processes are involved. This function normalizes,
 reduces, normalizes, reduces and broadcasts the result to all participating
 processes.  As usual the resulting superaccumulator is unnormalized.
+
+If the communicators were generated by \c exblas::mpi_reduce_communicator the
+first level is a sum over a shared memory window on each node, and only
+one process per node takes part in the reduction among nodes.
  * @ingroup highlevel
 @param num_superacc number of Superaccumulators eaach process holds
 @param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, undefined on out)
@@ -78,23 +236,89 @@ processes.  As usual the resulting superaccumulator is unnormalized.
 */
 static void reduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce )
 {
-    for( unsigned i=0; i<num_superacc; i++)
+    detail::normalize_superacc( num_superacc, in);
+    detail::NodeWindow* w = detail::node_window( comm_mod, num_superacc);
+    if( w != nullptr)
     {
-        int imin=exblas::IMIN, imax=exblas::IMAX;
-        cpu::Normalize(&in[i*exblas::BIN_COUNT], imin, imax);
+        MPI_Request request;
+        detail::node_reduce_start( num_superacc, in, out, comm_mod, w, &request);
+        detail::node_reduce_finish( num_superacc, out, comm_mod, w, &request);
+        return;
     }
     MPI_Reduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, 0, comm_mod);
-    int rank;
-    MPI_Comm_rank( comm_mod, &rank);
     if(comm_mod_reduce != MPI_COMM_NULL)
     {
-        for( unsigned i=0; i<num_superacc; i++)
-        {
-            int imin=exblas::IMIN, imax=exblas::IMAX;
-            cpu::Normalize(&out[i*exblas::BIN_COUNT], imin, imax);
-            for( int k=0; k<exblas::BIN_COUNT; k++)
-                in[i*BIN_COUNT+k] = out[i*BIN_COUNT+k];
-        }
+        detail::normalize_superacc( num_superacc, out);
+        std::copy( out, out+num_superacc*BIN_COUNT, in);
+        MPI_Reduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, 0, comm_mod_reduce);
+    }
+    MPI_Bcast( out, num_superacc*exblas::BIN_COUNT, MPI_LONG, 0, comm);
+}
+
+/*! @brief Start a non-blocking reduction of superaccumulators (split-phase version of \c exblas::reduce_mpi_cpu)
+
+The request is the handle of the pending reduction; the caller can overlap
+it with other work and complete it with \c exblas::reduce_mpi_cpu_finish
+(with the same arguments). The final result is the same as the one of
+\c exblas::reduce_mpi_cpu.
+
+If the communicators were generated by \c exblas::mpi_reduce_communicator the
+superaccumulators are first summed through shared memory on each node
+(this synchronizes the processes of a node) and the reduction among
+nodes, which carries the network latency, is started with \c MPI_Iallreduce.
+Else the first level of the reduction (inside \c comm_mod) is started with \c MPI_Iallreduce.
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, must not be touched until the reduction is finished)
+@param out each process contains the result after \c exblas::reduce_mpi_cpu_finish ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (write, may not alias in, must not be touched until the reduction is finished)
+@param comm The complete MPI communicator
+@param comm_mod This is comm modulo 128 ( or any other number <256)
+@param comm_mod_reduce This is the communicator consisting of all rank 0 processes in comm_mod, may be \c MPI_COMM_NULL
+@param request (write only) the request handle of the pending reduction
+@attention Requires an MPI-3 implementation
+@sa \c exblas::mpi_reduce_communicator to generate the required communicators
+*/
+static void reduce_mpi_cpu_start(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce, MPI_Request* request )
+{
+    detail::normalize_superacc( num_superacc, in);
+    detail::NodeWindow* w = detail::node_window( comm_mod, num_superacc);
+    if( w != nullptr)
+        detail::node_reduce_start( num_superacc, in, out, comm_mod, w, request);
+    else
+        MPI_Iallreduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, comm_mod, request);
+}
+
+/*! @brief Complete a reduction started with \c exblas::reduce_mpi_cpu_start
+
+Waits for the pending reduction and distributes the result to all processes.
+As usual the resulting superaccumulator is unnormalized.
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in same as in \c exblas::reduce_mpi_cpu_start (undefined on out)
+@param out each process contains the result on output
+@param comm The complete MPI communicator
+@param comm_mod This is comm modulo 128 ( or any other number <256)
+@param comm_mod_reduce This is the communicator consisting of all rank 0 processes in comm_mod, may be \c MPI_COMM_NULL
+@param request the request handle returned by \c exblas::reduce_mpi_cpu_start
+*/
+static void reduce_mpi_cpu_finish(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce, MPI_Request* request )
+{
+    detail::NodeWindow* w = detail::node_window( comm_mod, num_superacc);
+    if( w != nullptr)
+    {
+        detail::node_reduce_finish( num_superacc, out, comm_mod, w, request);
+        return;
+    }
+    MPI_Wait( request, MPI_STATUS_IGNORE);
+    int size, size_mod;
+    MPI_Comm_size( comm, &size);
+    MPI_Comm_size( comm_mod, &size_mod);
+    if( size == size_mod) //only one group: everyone has the result
+        return;
+    if(comm_mod_reduce != MPI_COMM_NULL)
+    {
+        detail::normalize_superacc( num_superacc, out);
+        std::copy( out, out+num_superacc*BIN_COUNT, in);
         MPI_Reduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, 0, comm_mod_reduce);
     }
     MPI_Bcast( out, num_superacc*exblas::BIN_COUNT, MPI_LONG, 0, comm);
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <mpi.h>
+#include "exblas/exdot_serial.h"
+#include "exblas/mpi_accumulate.h"
+
+//Test the reduction of superaccumulators against the serial exblas dot of
+//the gathered vectors. Small group sizes emulate a machine with more nodes
+//than can be summed without normalization.
+
+const unsigned num = 2, N = 1000;
+//values that span many orders of magnitude and cancel
+double value( unsigned vec, int rank, unsigned i)
+{
+    double x = sin( 1.+i+17.*rank+31.*vec)*pow( 10., (int)((i*7+rank*3+vec)%40) - 20);
+    return i%2 ? x : -0.999999*x;
+}
+
+int main( int argc, char* argv[])
+{
+    MPI_Init( &argc, &argv);
+    int rank, size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    MPI_Comm_size( MPI_COMM_WORLD, &size);
+    if(rank==0)std::cout << "Test the MPI reduction of superaccumulators on "<<size<<" processes\n";
+    std::vector<double> x( num*N), y( N, 1.);
+    for( unsigned k=0; k<num; k++)
+        for( unsigned i=0; i<N; i++)
+            x[k*N+i] = value( k, rank, i);
+    //reference: every process computes the dots of the gathered vectors
+    std::vector<double> global( size*num*N), ones( size*N, 1.), reference( num);
+    MPI_Allgather( x.data(), num*N, MPI_DOUBLE, global.data(), num*N, MPI_DOUBLE, MPI_COMM_WORLD);
+    for( unsigned k=0; k<num; k++)
+    {
+        std::vector<double> xk( size*N);
+        for( int r=0; r<size; r++)
+            for( unsigned i=0; i<N; i++)
+                xk[r*N+i] = global[(r*num+k)*N+i];
+        std::vector<int64_t> acc( dg::exblas::BIN_COUNT);
+        int status = 0;
+        dg::exblas::exdot_cpu( size*N, xk.data(), ones.data(), acc.data(), &status);
+        reference[k] = dg::exblas::cpu::Round( acc.data());
+    }
+    std::vector<const double*> xs( num), ys( num, y.data());
+    for( unsigned k=0; k<num; k++)
+        xs[k] = &x[k*N];
+
+    // processes per node, maximum number of summed groups
+    std::vector<std::array<int,2>> configs = {{128, 128}, {1, 2}, {2, 2}, {1, 3}};
+    bool passed = true;
+    for( auto config : configs)
+    {
+        MPI_Comm comm, comm_mod, comm_mod_reduce;
+        MPI_Comm_dup( MPI_COMM_WORLD, &comm);
+        if( config[0] == 128 && config[1] == 128)
+            dg::exblas::mpi_reduce_communicator( comm, &comm_mod, &comm_mod_reduce);
+        else
+            dg::exblas::detail::mpi_reduce_communicator( comm, &comm_mod,
+                &comm_mod_reduce, config[0], config[1]);
+        int size_reduce = 0, levels = 0;
+        if( comm_mod_reduce != MPI_COMM_NULL)
+        {
+            MPI_Comm_size( comm_mod_reduce, &size_reduce);
+            for( auto block : dg::exblas::detail::node_windows[comm_mod].blocks)
+                levels += block != MPI_COMM_NULL;
+        }
+        MPI_Allreduce( MPI_IN_PLACE, &levels, 1, MPI_INT, MPI_MAX, comm);
+        if(rank==0)std::cout << "Groups of at most "<<config[0]<<" processes, "
+            <<size_reduce<<" groups summed in "<<levels<<" level(s) of at most "<<config[1]<<"\n";
+        std::vector<int64_t> in( num*dg::exblas::BIN_COUNT), out( in), in2( in), out2( in);
+        int status = 0;
+        //blocking reduction
+        dg::exblas::exdots_cpu( N, num, xs.data(), ys.data(), in.data(), &status);
+        dg::exblas::reduce_mpi_cpu( num, in.data(), out.data(), comm, comm_mod, comm_mod_reduce);
+        bool equal = true;
+        for( unsigned k=0; k<num; k++)
+            if( dg::exblas::cpu::Round( &out[k*dg::exblas::BIN_COUNT]) != reference[k])
+                equal = false;
+        //two interleaved split-phase reductions
+        MPI_Request request, request2;
+        dg::exblas::exdots_cpu( N, num, xs.data(), ys.data(), in.data(), &status);
+        dg::exblas::exdots_cpu( N, num, xs.data(), ys.data(), in2.data(), &status);
+        dg::exblas::reduce_mpi_cpu_start( num, in.data(), out.data(), comm, comm_mod, comm_mod_reduce, &request);
+        dg::exblas::reduce_mpi_cpu_start( num, in2.data(), out2.data(), comm, comm_mod, comm_mod_reduce, &request2);
+        dg::exblas::reduce_mpi_cpu_finish( num, in.data(), out.data(), comm, comm_mod, comm_mod_reduce, &request);
+        dg::exblas::reduce_mpi_cpu_finish( num, in2.data(), out2.data(), comm, comm_mod, comm_mod_reduce, &request2);
+        for( unsigned k=0; k<num; k++)
+            if( dg::exblas::cpu::Round( &out[k*dg::exblas::BIN_COUNT]) != reference[k]
+             || dg::exblas::cpu::Round( &out2[k*dg::exblas::BIN_COUNT]) != reference[k])
+                equal = false;
+        int all_equal = equal;
+        MPI_Allreduce( MPI_IN_PLACE, &all_equal, 1, MPI_INT, MPI_LAND, comm);
+        if(rank==0)std::cout << (all_equal ? "PASSED\n" : "FAILED\n");
+        passed = passed && all_equal;
+    }
+    if(rank==0)std::cout << "Reference "<<reference[0]<<" "<<reference[1]<<"\n";
+
+    MPI_Finalize();
+    return passed ? 0 : 1;
+}
@@ -110,62 +110,77 @@ struct RowColDistMat
     /**
     * @brief Matrix Vector product
     *
-    * First the inner elements are computed with a call to doSymv then
-    * the global_gather function of the communication object is called.
-    * Finally the outer elements are added with a call to doSymv for the outer matrix
+    * The halo exchange is initiated first, then the inner elements are computed with a call to doSymv
+    * while the messages are in flight. After the global_gather_wait function of the
+    * communication object returns the outer elements are added with a call to doSymv for the outer matrix.
+    *
+    * With \c OmpTag execution policy and more than one thread everything happens in one
+    * parallel region: the threads share the gather of the halo, then the master thread
+    * progresses the communication by polling \c global_gather_test() while the
+    * other threads work on the inner elements. The master joins the inner
+    * computation once all messages have arrived.
     * @tparam ContainerType container class of the vector elements
     * @param alpha scalar
     * @param x input
     * @param beta scalar
     * @param y output
+    * @note If compiled with the \c DG_BENCHMARK macro the time spent in each phase is accumulated in \c timings()
     */
     template<class ContainerType1, class ContainerType2>
     void symv( value_type alpha, const ContainerType1& x, value_type beta, ContainerType2& y) const
     {
-        //the blas2 functions should make enough static assertions on tpyes
-        if( !m_c.isCommunicating()) //no communication needed
-        {
-            dg::blas2::symv( alpha, m_i, x.data(), beta, y.data());
-            return;
-
-        }
-        int result;
-        MPI_Comm_compare( x.communicator(), y.communicator(), &result);
-        assert( result == MPI_CONGRUENT || result == MPI_IDENT);
-        MPI_Comm_compare( x.communicator(), m_c.communicator(), &result);
-        assert( result == MPI_CONGRUENT || result == MPI_IDENT);
-
-        //1.1 initiate communication
-        MPI_Request rqst[4];
-        const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
-              value_type * y_ptr = thrust::raw_pointer_cast(y.data().data());
-        m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
-        //1.2 compute inner points
-        dg::blas2::symv( alpha, m_i, x.data(), beta, y.data());
-        //2. wait for communication to finish
-        m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
-        //3. compute and add outer points
-        const value_type** b_ptr = thrust::raw_pointer_cast(m_buffer.data().data());
-        m_o.symv( SharedVectorTag(), get_execution_policy<ContainerType1>(), alpha, b_ptr, beta, y_ptr);
+        do_symv( alpha, x, beta, y);
     }
 
     /**
     * @brief Matrix Vector product
     *
-    * First the inner elements are computed with a call to doSymv then
-    * the collect function of the communication object is called.
-    * Finally the outer elements are added with a call to doSymv for the outer matrix
+    * Same as <tt> symv( 1., x, 0., y) </tt>
     * @tparam ContainerType container class of the vector elements
     * @param x input
     * @param y output
     */
     template<class ContainerType1, class ContainerType2>
     void symv( const ContainerType1& x, ContainerType2& y) const
+    {
+        do_symv( 1., x, 0., y);
+    }
+
+    /**
+    * @brief Wall times (in seconds) spent in the phases of \c symv, accumulated over all calls
+    *
+    * Only measured if compiled with the \c DG_BENCHMARK macro (otherwise all zero).
+    * The communication is hidden behind the computation if \c comm is smaller than \c inner.
+    */
+    struct Timings
+    {
+        double gather = 0; //!< gather of the halo and posting of the messages
+        double inner = 0; //!< from posting the messages until the inner elements are done
+        double comm = 0; //!< from posting the messages until all messages have arrived
+        double outer = 0; //!< computation of the outer elements
+        unsigned calls = 0; //!< number of communicating \c symv calls
+    };
+    ///@brief Access accumulated timings of \c symv
+    ///@return the timings
+    const Timings& timings() const{ return m_timings;}
+    ///@brief Set all timings to zero
+    void reset_timings() const{ m_timings = Timings();}
+
+    private:
+    static double wtime() {
+#ifdef DG_BENCHMARK
+        return MPI_Wtime();
+#else
+        return 0.;
+#endif //DG_BENCHMARK
+    }
+    template<class ContainerType1, class ContainerType2>
+    void do_symv( value_type alpha, const ContainerType1& x, value_type beta, ContainerType2& y) const
     {
         //the blas2 functions should make enough static assertions on tpyes
         if( !m_c.isCommunicating()) //no communication needed
         {
-            dg::blas2::symv( m_i, x.data(), y.data());
+            dg::blas2::symv( alpha, m_i, x.data(), beta, y.data());
             return;
 
         }
@@ -175,25 +190,77 @@ struct RowColDistMat
         MPI_Comm_compare( x.communicator(), m_c.communicator(), &result);
         assert( result == MPI_CONGRUENT || result == MPI_IDENT);
 
-        //1.1 initiate communication
-        MPI_Request rqst[4];
         const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
               value_type * y_ptr = thrust::raw_pointer_cast(y.data().data());
+        do_symv( get_execution_policy<ContainerType1>(), alpha, x_ptr, beta, y_ptr);
+        m_timings.calls++;
+    }
+    template<class ExecutionPolicy>
+    void do_symv( ExecutionPolicy, value_type alpha, const value_type* x_ptr, value_type beta, value_type* y_ptr) const
+    {
+        double t0 = wtime();
+        //1.1 initiate communication
+        MPI_Request rqst[4];
         m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
+        double t1 = wtime();
         //1.2 compute inner points
-        dg::blas2::symv( m_i, x.data(), y.data());
+        m_i.symv( SharedVectorTag(), ExecutionPolicy(), alpha, x_ptr, beta, y_ptr);
+        double t2 = wtime();
         //2. wait for communication to finish
         m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
+        double t3 = wtime();
         //3. compute and add outer points
         const value_type** b_ptr = thrust::raw_pointer_cast(m_buffer.data().data());
-        m_o.symv( SharedVectorTag(), get_execution_policy<ContainerType1>(), 1., b_ptr, 1., y_ptr);
+        m_o.symv( SharedVectorTag(), ExecutionPolicy(), alpha, b_ptr, 1., y_ptr);
+        double t4 = wtime();
+        m_timings.gather += t1-t0, m_timings.inner += t2-t1;
+        m_timings.comm += t3-t1, m_timings.outer += t4-t3;
     }
+#ifdef _OPENMP
+    void do_symv( OmpTag, value_type alpha, const value_type* x_ptr, value_type beta, value_type* y_ptr) const
+    {
+        if( omp_get_max_threads() == 1) //nobody to overlap with
+        {
+            do_symv<OmpTag>( OmpTag(), alpha, x_ptr, beta, y_ptr);
+            return;
+        }
+        MPI_Request rqst[4];
+        const value_type** b_ptr = thrust::raw_pointer_cast(m_buffer.data().data());
+        double t0 = wtime(), t1 = 0, t2 = 0, t3 = 0;
+        #pragma omp parallel
+        {
+            //1.1 gather (work-shared) and initiate communication (master)
+            m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
+            #pragma omp master
+            {
+                t1 = wtime();
+                //the master progresses the communication ...
+                while( !m_c.global_gather_test( rqst))
+                    ;
+                m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
+                t2 = wtime();
+            }
+            //1.2 ... while the others start with the inner points (nowait);
+            //the rows are scheduled dynamically, so the others also take
+            //over the share of the master
+            m_i.symv( SharedVectorTag(), OmpTag(), alpha, x_ptr, beta, y_ptr);
+            #pragma omp barrier
+            #pragma omp master
+            t3 = wtime();
+            //3. compute and add outer points
+            m_o.symv( SharedVectorTag(), OmpTag(), alpha, b_ptr, 1., y_ptr);
+        }
+        double t4 = wtime();
+        m_timings.gather += t1-t0, m_timings.inner += t3-t1;
+        m_timings.comm += t2-t1, m_timings.outer += t4-t3;
+    }
+#endif //_OPENMP
 
-    private:
     LocalMatrixInner m_i;
     LocalMatrixOuter m_o;
     Collective m_c;
     Buffer< typename Collective::buffer_type>  m_buffer;
+    mutable Timings m_timings;
 };
 
 
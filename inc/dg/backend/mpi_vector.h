@@ -71,7 +71,7 @@ struct MPI_Vector
     ///@brief Get the communicator to which this vector belongs
     ///@return read access to MPI communicator
     MPI_Comm communicator() const{return m_comm;}
-    ///@brief Returns a communicator of fixed size 128
+    ///@brief Returns a communicator of the processes on the same shared memory node (at most 128)
     MPI_Comm communicator_mod() const{return m_comm128;}
 
     /**
@@ -278,38 +278,42 @@ struct NearestNeighborComm
     * @param input from which to gather data (it is @b unsafe to change values on return)
     * @param buffer (write only) pointers to the received data after \c global_gather_wait() was called (must be allocated by \c allocate_buffer())
     * @param rqst four request variables that can be used to call MPI_Waitall
+    * @note If the Vector has \c OmpTag execution policy this function may be
+    * called by all threads of an OpenMP parallel region. Then the gather is
+    * work-shared among the threads (including a barrier) and only the master
+    * thread initiates the MPI communication (\c MPI_THREAD_FUNNELED suffices). \c buffer and
+    * \c rqst must be shared variables and must not be used before \c global_gather_wait()
+    * was called by the master thread.
     */
     void global_gather_init( const_pointer_type input, buffer_type& buffer, MPI_Request rqst[4])const
     {
-        unsigned size = buffer_size();
-        //init pointers on host
-        const_pointer_type host_ptr[6];
-        if(m_trivial)
-        {
-            host_ptr[0] = thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]);
-            host_ptr[1] = input;
-            host_ptr[2] = input+size;
-            host_ptr[3] = input+(m_outer_size-2)*size;
-            host_ptr[4] = input+(m_outer_size-1)*size;
-            host_ptr[5] = thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]);
-        }
-        else
-        {
-            host_ptr[0] = thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]);
-            host_ptr[1] = thrust::raw_pointer_cast(&m_internal_buffer.data()[1*size]);
-            host_ptr[2] = thrust::raw_pointer_cast(&m_internal_buffer.data()[2*size]);
-            host_ptr[3] = thrust::raw_pointer_cast(&m_internal_buffer.data()[3*size]);
-            host_ptr[4] = thrust::raw_pointer_cast(&m_internal_buffer.data()[4*size]);
-            host_ptr[5] = thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]);
-        }
-        //copy pointers to device
-        thrust::copy( host_ptr, host_ptr+6, buffer.begin());
         //fill internal_buffer if !trivial
         do_global_gather_init( get_execution_policy<Vector>(), input, rqst);
-        sendrecv( host_ptr[1], host_ptr[4],
-                  thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]), //host_ptr is const!
-                  thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]), //host_ptr is const!
-                  rqst);
+#ifdef _OPENMP
+        if( std::is_same<get_execution_policy<Vector>, OmpTag>::value && omp_in_parallel())
+        {
+            #pragma omp master
+            global_gather_post( input, buffer, rqst);
+            return;
+        }
+#endif //_OPENMP
+        global_gather_post( input, buffer, rqst);
+    }
+    /**
+    * @brief Test for completion of the asynchronous communication
+    *
+    * Calls \c MPI_Testall on the \c rqst variables, which also progresses
+    * the communication in the MPI library. Useful to poll while computing
+    * something else.
+    * @param rqst the same four request variables that were used in \c global_gather_init()
+    * @return true if all messages have arrived (\c global_gather_wait() will return immediately)
+    * @note must be called from the same thread that called \c global_gather_init()
+    */
+    bool global_gather_test( MPI_Request rqst[4]) const
+    {
+        int flag;
+        MPI_Testall( 4, rqst, &flag, MPI_STATUSES_IGNORE);
+        return flag;
     }
     /**
     * @brief Wait for asynchronous communication to finish and gather received data into buffer
@@ -337,6 +341,37 @@ struct NearestNeighborComm
 #endif
     }
     private:
+    //set buffer pointers and initiate sendrecv (the gather must be finished)
+    void global_gather_post( const_pointer_type input, buffer_type& buffer, MPI_Request rqst[4])const
+    {
+        unsigned size = buffer_size();
+        //init pointers on host
+        const_pointer_type host_ptr[6];
+        if(m_trivial)
+        {
+            host_ptr[0] = thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]);
+            host_ptr[1] = input;
+            host_ptr[2] = input+size;
+            host_ptr[3] = input+(m_outer_size-2)*size;
+            host_ptr[4] = input+(m_outer_size-1)*size;
+            host_ptr[5] = thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]);
+        }
+        else
+        {
+            host_ptr[0] = thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]);
+            host_ptr[1] = thrust::raw_pointer_cast(&m_internal_buffer.data()[1*size]);
+            host_ptr[2] = thrust::raw_pointer_cast(&m_internal_buffer.data()[2*size]);
+            host_ptr[3] = thrust::raw_pointer_cast(&m_internal_buffer.data()[3*size]);
+            host_ptr[4] = thrust::raw_pointer_cast(&m_internal_buffer.data()[4*size]);
+            host_ptr[5] = thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]);
+        }
+        //copy pointers to device
+        thrust::copy( host_ptr, host_ptr+6, buffer.begin());
+        sendrecv( host_ptr[1], host_ptr[4],
+                  thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]), //host_ptr is const!
+                  thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]), //host_ptr is const!
+                  rqst);
+    }
     void do_global_gather_init( OmpTag, const_pointer_type, MPI_Request rqst[4])const;
     void do_global_gather_init( SerialTag, const_pointer_type, MPI_Request rqst[4])const;
     void do_global_gather_init( CudaTag, const_pointer_type, MPI_Request rqst[4])const;
@@ -465,6 +500,14 @@ void NearestNeighborComm<I,B,V>::do_global_gather_init( OmpTag, const_pointer_ty
     if(!m_trivial)
     {
         unsigned size = buffer_size();
+        if( omp_in_parallel())
+        {
+            //work-share among the threads of the calling region
+            #pragma omp for
+            for( unsigned i=0; i<4*size; i++)
+                m_internal_buffer.data()[size+i] = input[m_gather_map_middle[i]];
+            return;
+        }
         #pragma omp parallel for
         for( unsigned i=0; i<4*size; i++)
             m_internal_buffer.data()[size+i] = input[m_gather_map_middle[i]];
@@ -61,8 +61,24 @@ struct EllSparseBlockMatDevice
     void symv(SharedVectorTag, CudaTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const;
 #ifdef _OPENMP
     void symv(SharedVectorTag, OmpTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const;
+#endif //_OPENMP
+    /**
+    * @brief Apply the matrix to several vectors in one sweep
+    *
+    * \f[  y_v= \alpha M x_v + \beta y_v,\quad v=0,\dots,num-1\f]
+    * @param alpha multiplies input
+    * @param num number of vectors
+    * @param x array of \c num input pointers (host array of device pointers)
+    * @param beta premultiplies output
+    * @param y array of \c num output pointers (may not alias any input)
+    * @note On the gpu this launches one kernel per vector
+    */
+    void symv(SharedVectorTag, CudaTag, value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const;
+#ifdef _OPENMP
+    void symv(SharedVectorTag, OmpTag, value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const;
 #endif //_OPENMP
     void launch_multiply_kernel(value_type alpha, const value_type* x, value_type beta, value_type* y) const;
+    void launch_multiply_kernel(value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const;
 
     thrust::device_vector<value_type> data;
     thrust::device_vector<int> cols_idx, data_idx;
@@ -142,6 +158,12 @@ inline void EllSparseBlockMatDevice<value_type>::symv(SharedVectorTag, CudaTag,
     launch_multiply_kernel( alpha, x, beta, y);
 }
 template<class value_type>
+inline void EllSparseBlockMatDevice<value_type>::symv(SharedVectorTag, CudaTag,
+        value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const
+{
+    launch_multiply_kernel( alpha, num, x, beta, y);
+}
+template<class value_type>
 inline void CooSparseBlockMatDevice<value_type>::symv(SharedVectorTag, CudaTag,
         value_type alpha, const value_type** x, value_type beta, value_type* y) const
 {
@@ -163,6 +185,19 @@ inline void EllSparseBlockMatDevice<value_type>::symv(SharedVectorTag, OmpTag, v
     }
     launch_multiply_kernel(alpha, x, beta, y);
 }
+template<class value_type>
+inline void EllSparseBlockMatDevice<value_type>::symv(SharedVectorTag, OmpTag, value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const
+{
+    if( !omp_in_parallel())
+    {
+        #pragma omp parallel
+        {
+            launch_multiply_kernel(alpha, num, x, beta, y);
+        }
+        return;
+    }
+    launch_multiply_kernel(alpha, num, x, beta, y);
+}
 
 template<class value_type>
 inline void CooSparseBlockMatDevice<value_type>::symv(SharedVectorTag, OmpTag, value_type alpha, const value_type** x, value_type beta, value_type* y) const
@@ -86,6 +86,20 @@ struct EllSparseBlockMat
     * @param y output may not alias input
     */
     void symv(SharedVectorTag, SerialTag, value_type alpha, const value_type* RESTRICT x, value_type beta, value_type* RESTRICT y) const;
+    /**
+    * @brief Apply the matrix to several vectors in one sweep
+    *
+    * \f[  y_v= \alpha M x_v + \beta y_v,\quad v=0,\dots,num-1\f]
+    * The indices and blocks of a row are read once and then applied to all
+    * vectors. The order of operations for each \c y_v is the same as in a
+    * single call to symv.
+    * @param alpha multiplies input
+    * @param num number of vectors
+    * @param x array of \c num input pointers
+    * @param beta premultiplies output
+    * @param y array of \c num output pointers (may not alias any input)
+    */
+    void symv(SharedVectorTag, SerialTag, value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const;
 
     ///@brief Sets right_range from 0 to right_size
     void set_default_range(){
@@ -249,6 +263,30 @@ void EllSparseBlockMat<value_type>::symv(SharedVectorTag, SerialTag, value_type
     }
 }
 
+template<class value_type>
+void EllSparseBlockMat<value_type>::symv(SharedVectorTag, SerialTag, value_type alpha, unsigned num, const value_type* const * x, value_type beta, value_type* const * y) const
+{
+    //same order of operations as the single vector version
+    for( int s=0; s<left_size; s++)
+    for( int i=0; i<num_rows; i++)
+    for( int k=0; k<n; k++)
+    for( unsigned v=0; v<num; v++)
+    for( int j=right_range[0]; j<right_range[1]; j++)
+    {
+        int I = ((s*num_rows + i)*n+k)*right_size+j;
+        y[v][I]*= beta;
+        for( int d=0; d<blocks_per_line; d++)
+        {
+            int B = (data_idx[i*blocks_per_line+d]*n + k)*n;
+            int J = (s*num_cols + cols_idx[i*blocks_per_line+d])*n;
+            value_type temp = 0;
+            for( int q=0; q<n; q++) //multiplication-loop
+                temp = DG_FMA( data[B+q], x[v][(J+q)*right_size+j], temp);
+            y[v][I] = DG_FMA( alpha,temp, y[v][I]);
+        }
+    }
+}
+
 template<class value_type>
 void CooSparseBlockMat<value_type>::symv( SharedVectorTag, SerialTag, value_type alpha, const value_type** x, value_type beta, value_type* RESTRICT y) const
 {
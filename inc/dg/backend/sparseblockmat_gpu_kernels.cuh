@@ -178,6 +178,13 @@ void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alp
             n, size, right_size, right_range_ptr,  x_ptr,y_ptr);
     }
 }
+template<class value_type>
+void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alpha, unsigned num, const value_type* const * x_ptr, value_type beta, value_type* const * y_ptr) const
+{
+    //the threads of one kernel already share the matrix in the cache
+    for( unsigned v=0; v<num; v++)
+        launch_multiply_kernel( alpha, x_ptr[v], beta, y_ptr[v]);
+}
 
 //////////////////// COO multiply kernel
 template<class value_type>
@@ -1,10 +1,19 @@
 #include <omp.h>
+#include <algorithm>
 #include "config.h"
 
 //for the fmas it is important to activate -mfma compiler flag
 
 namespace dg{
 
+//The rows are distributed dynamically such that the other threads take over
+//the share of a thread that starts late (cf. the overlap of communication
+//and computation in dg::RowColDistMat)
+inline int ell_chunk( int size)
+{
+    return std::max( 1, size/(8*omp_get_num_threads()));
+}
+
 // general multiply kernel
 template<class value_type>
 void ell_multiply_kernel( value_type alpha, value_type beta,
@@ -17,7 +26,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
          const value_type * RESTRICT x, value_type * RESTRICT y
          )
 {
-#pragma omp for nowait //manual collapse(2)
+#pragma omp for schedule(dynamic, ell_chunk( left_size*num_rows)) nowait //manual collapse(2)
 	for( int si = 0; si<left_size*num_rows; si++)
 	{
 		int s = si / num_rows;
@@ -88,7 +97,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
         int B = data_idx[blocks_per_line+d];
         dprivate[(k*blocks_per_line+d)*n+q] = data[(B*n+k)*n+q];
     }
-    #pragma omp for nowait
+    #pragma omp for schedule(dynamic, ell_chunk( left_size)) nowait
     for( int s=0; s<left_size; s++)
     {
         for( int i=0; i<1; i++)
@@ -164,7 +173,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
     else // not trivial
     {
     value_type xprivate[blocks_per_line*n];
-    #pragma omp for nowait
+    #pragma omp for schedule(dynamic, ell_chunk( left_size)) nowait
     for( int s=0; s<left_size; s++)
     for( int i=0; i<num_rows; i++)
     {
@@ -197,7 +206,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
     int J[blocks_per_line];
     if( !( (right_range[1]-right_range[0]) > 100*left_size*num_rows*n )) //typically a derivative in y ( Ny*Nz >~ Nx)
     {
-        #pragma omp for nowait
+        #pragma omp for schedule(dynamic, ell_chunk( left_size*num_rows*n)) nowait
         for (int sik = 0; sik < left_size*num_rows*n; sik++)
         {
             int s = sik / (num_rows*n);
@@ -247,7 +256,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
                 for(int q=0; q<n; q++)
                     dprivate[d*n+q] = data[B+q];
             }
-            #pragma omp for SIMD nowait
+            #pragma omp for SIMD schedule(dynamic, ell_chunk( right_range[1]-right_range[0])) nowait
             for( int j=right_range[0]; j<right_range[1]; j++)
             {
                 int I = ((s*num_rows + i)*n+k)*right_size+j;
@@ -334,6 +343,257 @@ void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alp
         right_size, right_range_ptr,  x_ptr,y_ptr);
 }
 
+// general multiply kernel for several vectors
+template<class value_type>
+void ell_multiply_kernel( value_type alpha, value_type beta,
+         const value_type * RESTRICT data, const int * RESTRICT cols_idx,
+         const int * RESTRICT data_idx,
+         const int num_rows, const int num_cols, const int blocks_per_line,
+         const int n,
+         const int left_size, const int right_size,
+         const int * RESTRICT right_range,
+         const unsigned num,
+         const value_type * const * x, value_type * const * y
+         )
+{
+#pragma omp for schedule(dynamic, ell_chunk( left_size*num_rows)) nowait //manual collapse(2)
+	for( int si = 0; si<left_size*num_rows; si++)
+	{
+		int s = si / num_rows;
+		int i = si % num_rows;
+#ifdef _MSC_VER //MSVC does not support variable lenght arrays...
+		int* J = (int*)alloca(blocks_per_line * sizeof(int));
+		int* B = (int*)alloca(blocks_per_line * sizeof(int));
+#else
+        int J[blocks_per_line];
+        int B[blocks_per_line];
+#endif
+        for( int d=0; d<blocks_per_line; d++)
+            J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+        for( int k=0; k<n; k++)
+        {
+            for( int d=0; d<blocks_per_line; d++)
+                B[d] = (data_idx[i*blocks_per_line+d]*n+k)*n;
+            for( unsigned v=0; v<num; v++)
+            {
+                const value_type * RESTRICT xv = x[v];
+                value_type * RESTRICT yv = y[v];
+                for( int j=right_range[0]; j<right_range[1]; j++)
+                {
+                    int I = ((s*num_rows + i)*n+k)*right_size+j;
+                    yv[I]*= beta;
+                    for( int d=0; d<blocks_per_line; d++)
+                    {
+                        value_type temp = 0;
+                        for( int q=0; q<n; q++) //multiplication-loop
+                            temp = DG_FMA(data[ B[d]+q],
+                                    xv[(J[d]+q)*right_size+j],
+                                    temp);
+                        yv[I] = DG_FMA(alpha, temp, yv[I]);
+                    }
+                }
+            }
+        }
+    }
+}
+//specialized multiply kernel for several vectors
+//the blocks and column indices of a row are loaded once and then applied to all vectors
+template<class value_type, int n, int blocks_per_line>
+void ell_multiply_kernel( value_type alpha, value_type beta,
+         const value_type * RESTRICT data, const int * RESTRICT cols_idx,
+         const int * RESTRICT data_idx,
+         const int num_rows, const int num_cols,
+         const int left_size, const int right_size,
+         const int * RESTRICT right_range,
+         const unsigned num,
+         const value_type * const * x, value_type * const * y
+         )
+{
+    if(right_size==1)
+    {
+    value_type dprivate[blocks_per_line*n*n];
+    int J[blocks_per_line];
+    #pragma omp for schedule(dynamic, ell_chunk( left_size*num_rows)) nowait
+    for( int si=0; si<left_size*num_rows; si++)
+    {
+        int s = si / num_rows;
+        int i = si % num_rows;
+        for( int d=0; d<blocks_per_line; d++)
+        {
+            J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+            int B = data_idx[i*blocks_per_line+d]*n*n;
+            for( int kq=0; kq<n*n; kq++)
+                dprivate[d*n*n+kq] = data[B+kq];
+        }
+        for( unsigned v=0; v<num; v++)
+        {
+            const value_type * RESTRICT xv = x[v];
+            value_type * RESTRICT yv = y[v];
+            for( int k=0; k<n; k++)
+            {
+                value_type temp[blocks_per_line] = {0};
+                for( int d=0; d<blocks_per_line; d++)
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp[d] = DG_FMA( dprivate[(d*n+k)*n+q], xv[J[d]+q], temp[d]);
+                int I = ((s*num_rows + i)*n+k);
+                yv[I]*= beta;
+                for( int d=0; d<blocks_per_line; d++)
+                    yv[I] = DG_FMA(alpha, temp[d], yv[I]);
+            }
+        }
+    }
+    }// right_size==1
+    else // right_size != 1
+    {
+    value_type dprivate[blocks_per_line*n];
+    int J[blocks_per_line];
+    if( !( (right_range[1]-right_range[0]) > 100*left_size*num_rows*n )) //typically a derivative in y ( Ny*Nz >~ Nx)
+    {
+    #pragma omp for schedule(dynamic, ell_chunk( left_size*num_rows*n)) nowait
+    for (int sik = 0; sik < left_size*num_rows*n; sik++)
+    {
+        int s = sik / (num_rows*n);
+        int i = (sik % (num_rows*n)) / n;
+        int k = (sik % (num_rows*n)) % n;
+
+        for( int d=0; d<blocks_per_line; d++)
+        {
+            J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+            int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
+            for(int q=0; q<n; q++)
+                dprivate[d*n+q] = data[B+q];
+        }
+        for( unsigned v=0; v<num; v++)
+        {
+            const value_type * RESTRICT xv = x[v];
+            value_type * RESTRICT yv = y[v];
+            #ifndef _MSC_VER
+            #pragma omp SIMD //very important for KNL
+            #endif
+            for( int j=right_range[0]; j<right_range[1]; j++)
+            {
+                int I = ((s*num_rows + i)*n+k)*right_size+j;
+                yv[I]*= beta;
+                for( int d=0; d<blocks_per_line; d++)
+                {
+                    value_type temp = 0;
+                    int Jd = J[d];
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp = DG_FMA( dprivate[ d*n+q],
+                                    xv[(Jd+q)*right_size+j],
+                                    temp);
+                    yv[I] = DG_FMA(alpha, temp, yv[I]);
+                }
+            }
+        }
+    }
+    }
+    else //typically a derivative in z (since n*n*Nx*Ny > 100*Nz)
+    {
+        for (int sik = 0; sik < left_size*num_rows*n; sik++)
+        {
+            int s = sik / (num_rows*n);
+            int i = (sik % (num_rows*n)) / n;
+            int k = (sik % (num_rows*n)) % n;
+
+            for( int d=0; d<blocks_per_line; d++)
+            {
+                J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
+                for(int q=0; q<n; q++)
+                    dprivate[d*n+q] = data[B+q];
+            }
+            for( unsigned v=0; v<num; v++)
+            {
+                const value_type * RESTRICT xv = x[v];
+                value_type * RESTRICT yv = y[v];
+                #pragma omp for SIMD schedule(dynamic, ell_chunk( right_range[1]-right_range[0])) nowait
+                for( int j=right_range[0]; j<right_range[1]; j++)
+                {
+                    int I = ((s*num_rows + i)*n+k)*right_size+j;
+                    yv[I]*= beta;
+                    for( int d=0; d<blocks_per_line; d++)
+                    {
+                        value_type temp = 0;
+                        int Jd = J[d];
+                        for( int q=0; q<n; q++) //multiplication-loop
+                            temp = DG_FMA( dprivate[ d*n+q],
+                                        xv[(Jd+q)*right_size+j],
+                                        temp);
+                        yv[I] = DG_FMA(alpha, temp, yv[I]);
+                    }
+                }
+            }
+        }
+    }
+    }
+}
+
+template<class value_type, int n>
+void call_ell_multiply_kernel( value_type alpha, value_type beta,
+         const value_type * RESTRICT data_ptr, const int * RESTRICT cols_ptr,
+         const int * RESTRICT block_ptr,
+         const int num_rows, const int num_cols, const int blocks_per_line,
+         const int left_size, const int right_size,
+         const int * RESTRICT right_range_ptr,
+         const unsigned num,
+         const value_type * const * x_ptr, value_type * const * y_ptr)
+{
+    if( blocks_per_line == 1)
+        ell_multiply_kernel<value_type, n, 1>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        right_range_ptr, num, x_ptr,y_ptr);
+    else if (blocks_per_line == 2)
+        ell_multiply_kernel<value_type, n, 2>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        right_range_ptr, num, x_ptr,y_ptr);
+    else if (blocks_per_line == 3)
+        ell_multiply_kernel<value_type, n, 3>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        right_range_ptr, num, x_ptr,y_ptr);
+    else if (blocks_per_line == 4)
+        ell_multiply_kernel<value_type, n, 4>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        right_range_ptr, num, x_ptr,y_ptr);
+    else
+        ell_multiply_kernel<value_type>  (alpha, beta, data_ptr, cols_ptr,
+        block_ptr, num_rows, num_cols, blocks_per_line, n, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+}
+
+template<class value_type>
+void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alpha, unsigned num, const value_type* const * x_ptr, value_type beta, value_type* const * y_ptr) const
+{
+    const value_type* data_ptr = thrust::raw_pointer_cast( &data[0]);
+    const int* cols_ptr = thrust::raw_pointer_cast( &cols_idx[0]);
+    const int* block_ptr = thrust::raw_pointer_cast( &data_idx[0]);
+    const int* right_range_ptr = thrust::raw_pointer_cast( &right_range[0]);
+    if( n == 1)
+        call_ell_multiply_kernel<value_type, 1>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+    else if( n == 2)
+        call_ell_multiply_kernel<value_type, 2>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+    else if( n == 3)
+        call_ell_multiply_kernel<value_type, 3>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+    else if( n == 4)
+        call_ell_multiply_kernel<value_type, 4>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+    else if( n == 5)
+        call_ell_multiply_kernel<value_type, 5>  (alpha, beta, data_ptr,
+        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+    else
+        ell_multiply_kernel<value_type> ( alpha, beta, data_ptr, cols_ptr,
+        block_ptr, num_rows, num_cols, blocks_per_line, n, left_size,
+        right_size, right_range_ptr, num, x_ptr,y_ptr);
+}
+
 template<class value_type>
 void coo_multiply_kernel( value_type alpha, const value_type** x, value_type beta, value_type* RESTRICT y, const CooSparseBlockMatDevice<value_type>& m )
 {
@@ -4,6 +4,7 @@
  * just includes the blas headers
  */
 #include "blas1.h"
+#include "blas1_lazy.h"
 #include "blas2.h"
 
 #include "backend/typedefs.h"
@@ -90,6 +90,54 @@ inline get_value_type<ContainerType1> dot( const ContainerType1& x, const Contai
     return exblas::cpu::Round(acc.data());
 }
 
+/*! @brief \f$ x_k^T y_k\f$ Several binary reproducible dot products in one pass
+ *
+ * This routine computes \f[ x_k^T y_k = \sum_{i=0}^{N-1} x_{k,i} y_{k,i} \f]
+ * for all given pairs of vectors with one pass over the data (on the cpu) and
+ * a single global reduction (in MPI). Each result is bitwise identical to the
+ * one of the corresponding \c dg::blas1::dot.
+For example
+@code
+dg::DVec x( 100,2), y(100,3), z(100,4);
+std::vector<double> result = dg::blas1::dots( {{&x, &y}, {&x, &z}, {&y, &y}});
+// result = {600, 800, 900}
+@endcode
+ * @param xy pairs of pointers to the vectors to multiply (all vectors must have the same type and size, may alias each other)
+ * @return Scalar products in the order of \c xy
+ * @note This routine is always executed synchronously due to the
+        implicit memcpy of the result. With mpi the result is broadcasted to all processes.
+ * @note On the GPU the products are computed one after the other (but still
+ * with a single reduction in MPI)
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType>
+std::vector<get_value_type<ContainerType>> dots( const std::vector<std::array<const ContainerType*,2>>& xy)
+{
+    std::vector<get_value_type<ContainerType>> result( xy.size());
+    if( xy.empty())
+        return result;
+    std::vector<const ContainerType*> x( xy.size()), y( xy.size());
+    for( unsigned k=0; k<xy.size(); k++)
+        x[k] = xy[k][0], y[k] = xy[k][1];
+    std::vector<int64_t> acc = dg::blas1::detail::doDots_superacc( x,y);
+    for( unsigned k=0; k<xy.size(); k++)
+        result[k] = exblas::cpu::Round(&acc[k*exblas::BIN_COUNT]);
+    return result;
+}
+///@copydoc dots(const std::vector<std::array<const ContainerType*,2>>&)
+template< class ContainerType>
+std::vector<get_value_type<ContainerType>> dots( std::initializer_list<std::initializer_list<const ContainerType*>> xy)
+{
+    std::vector<std::array<const ContainerType*,2>> pairs;
+    for( auto pair : xy)
+    {
+        if( pair.size() != 2)
+            throw dg::Error( dg::Message(_ping_)<<"dots needs pairs of vectors but got "<<pair.size());
+        pairs.push_back( {*pair.begin(), *(pair.begin()+1)});
+    }
+    return dots( pairs);
+}
+
 /*! @brief \f$ x_0 \otimes x_1 \otimes \dots \otimes x_{N-1} \f$ Custom reduction
  *
  * This routine computes \f[ s = s_0 + x_0 \otimes x_1 \otimes \dots \otimes x_i \otimes \dots \otimes x_{N-1} \f]
@@ -558,6 +606,14 @@ inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const Conta
     return doDot_superacc( x, y, tensor_category());
 }
 
+template< class ContainerType>
+inline std::vector<int64_t> doDots_superacc( const std::vector<const ContainerType*>& x, const std::vector<const ContainerType*>& y)
+{
+    static_assert( dg::is_vector<ContainerType>::value,
+        "All container types must have a vector data layout (AnyVector)!");
+    return doDots_superacc( x, y, get_tensor_category<ContainerType>());
+}
+
 }//namespace detail
 ///@endcond
 
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <type_traits>
+#include "backend/config.h"
+#include "blas1.h"
+#include "subroutines.h"
+
+/*!@file
+ *
+ * Lazy expressions that fuse chains of elementwise blas1 operations into one loop
+ */
+
+namespace dg{
+namespace blas1{
+/*! @brief Lazy expressions that fuse chains of elementwise vector operations
+ *
+ * Long sequences of \c dg::blas1::axpby, \c dg::blas1::pointwiseDot, \c
+ * dg::blas1::transform ... on the same vectors each sweep through memory. This
+ * namespace allows to write such a sequence as a single statement on
+ * placeholders \c _0, \c _1, ... that is recorded at compile time and
+ * executed by \c dg::blas1::lazy::evaluate in one loop (a single call to \c
+ * dg::blas1::subroutine, so it works for all vector types that \c subroutine
+ * supports, in particular shared, recursive and MPI vectors)
+@code
+using namespace dg::blas1::lazy;
+// y = 2x + y; z = y*w; (in one memory sweep)
+dg::blas1::lazy::evaluate( ( _0 = 2.*_1 + _0, _2 = _0*_3), y, x, z, w);
+// v = exp( u ) + 1
+dg::blas1::lazy::evaluate( _0 = call( dg::EXP<double>(), _1) + 1., v, u);
+@endcode
+ * Placeholder \c _i refers to the i-th container given to \c evaluate.
+ * Statements are assignments \c =, \c +=, \c -=, \c *=, \c /= to a
+ * placeholder and are separated by the comma operator (mind the parenthesis).
+ * Expressions combine placeholders and scalars with \c +, \c -, \c *, \c /
+ * and \c call( f, e1 [,e2]) applies a functor \c f elementwise.
+ * For each element the statements are executed in order such that the
+ * result is the same as the one of the corresponding sequence of blas1
+ * calls (if operands are evaluated in the same order).
+ * @note Element \c i of the output depends on element \c i of the inputs only
+ * (as for all blas1 functions), so outputs may alias inputs
+ * @ingroup blas1
+ */
+namespace lazy{
+
+///@cond
+namespace detail{
+//return the I-th argument
+template<unsigned I>
+struct Get
+{
+    template<class T, class ...Ts>
+    DG_DEVICE static auto& apply( T&, Ts&... xs){
+        return Get<I-1>::apply( xs...);
+    }
+};
+template<>
+struct Get<0>
+{
+    template<class T, class ...Ts>
+    DG_DEVICE static T& apply( T& x, Ts&...){
+        return x;
+    }
+};
+struct Base{};
+template<class E>
+using is_expression = std::is_base_of<Base, E>;
+
+struct Plus{
+    template<class T1, class T2>
+    DG_DEVICE auto operator()( T1 x, T2 y) const { return x+y;}
+};
+struct Minus{
+    template<class T1, class T2>
+    DG_DEVICE auto operator()( T1 x, T2 y) const { return x-y;}
+};
+struct Times{
+    template<class T1, class T2>
+    DG_DEVICE auto operator()( T1 x, T2 y) const { return x*y;}
+};
+struct Divides{
+    template<class T1, class T2>
+    DG_DEVICE auto operator()( T1 x, T2 y) const { return x/y;}
+};
+struct Negate{
+    template<class T>
+    DG_DEVICE auto operator()( T x) const { return -x;}
+};
+
+template<class T>
+struct Value : public Base
+{
+    Value( T value): m_value(value){}
+    template<class ...Ts>
+    DG_DEVICE T eval( Ts&...) const { return m_value;}
+    private:
+    T m_value;
+};
+template<class F, class E>
+struct Unary : public Base
+{
+    Unary( F f, E e): m_f(f), m_e(e){}
+    template<class ...Ts>
+    DG_DEVICE auto eval( Ts&... xs) const { return m_f( m_e.eval( xs...));}
+    private:
+    F m_f;
+    E m_e;
+};
+template<class F, class E1, class E2>
+struct Binary : public Base
+{
+    Binary( F f, E1 e1, E2 e2): m_f(f), m_e1(e1), m_e2(e2){}
+    template<class ...Ts>
+    DG_DEVICE auto eval( Ts&... xs) const {
+        return m_f( m_e1.eval( xs...), m_e2.eval( xs...));
+    }
+    private:
+    F m_f;
+    E1 m_e1;
+    E2 m_e2;
+};
+
+//wrap scalars into Value
+template<class T, bool expression = is_expression<T>::value>
+struct Wrap
+{
+    static_assert( std::is_arithmetic<T>::value, "Operands of lazy expressions must be expressions or arithmetic scalars!");
+    using type = Value<T>;
+};
+template<class T>
+struct Wrap<T,true>
+{
+    using type = T;
+};
+template<class T>
+using wrap_t = typename Wrap<std::decay_t<T>>::type;
+template<class T1, class T2>
+using enable_if_expression = std::enable_if_t<is_expression<T1>::value || is_expression<T2>::value>;
+
+struct StatementBase{};
+template<class S>
+using is_statement = std::is_base_of<StatementBase, S>;
+
+template<unsigned I, class E, class Op>
+struct Assign : public StatementBase
+{
+    Assign( E e): m_e(e){}
+    template<class ...Ts>
+    DG_DEVICE void eval( Ts&... xs) const {
+        Op()( m_e.eval( xs...), Get<I>::apply( xs...));
+    }
+    private:
+    E m_e;
+};
+template<class S1, class S2>
+struct Sequence : public StatementBase
+{
+    Sequence( S1 s1, S2 s2): m_s1(s1), m_s2(s2){}
+    template<class ...Ts>
+    DG_DEVICE void eval( Ts&... xs) const {
+        m_s1.eval( xs...);
+        m_s2.eval( xs...);
+    }
+    private:
+    S1 m_s1;
+    S2 m_s2;
+};
+
+template<class Statement>
+struct Kernel
+{
+    Kernel( Statement s): m_s(s){}
+    template<class ...Ts>
+    DG_DEVICE void operator()( Ts&&... xs) const {
+        m_s.eval( xs...);
+    }
+    private:
+    Statement m_s;
+};
+}//namespace detail
+///@endcond
+
+///@addtogroup blas1
+///@{
+
+/**
+ * @brief Placeholder for the I-th container in \c dg::blas1::lazy::evaluate
+ *
+ * Placeholders can be used in expressions and assigned to
+ * @tparam I index of the container
+ */
+template<unsigned I>
+struct Arg : public detail::Base
+{
+    ///@cond
+    template<class ...Ts>
+    DG_DEVICE auto& eval( Ts&... xs) const { return detail::Get<I>::apply( xs...);}
+    ///@endcond
+    ///@brief \f$ x_I = e\f$
+    template<class E>
+    detail::Assign<I, detail::wrap_t<E>, dg::equals> operator=( const E& e) const {return {e};}
+    ///@brief \f$ x_I = x_I + e\f$
+    template<class E>
+    detail::Assign<I, detail::wrap_t<E>, dg::plus_equals> operator+=( const E& e) const {return {e};}
+    ///@brief \f$ x_I = x_I - e\f$
+    template<class E>
+    detail::Assign<I, detail::wrap_t<E>, dg::minus_equals> operator-=( const E& e) const {return {e};}
+    ///@brief \f$ x_I = x_I e\f$
+    template<class E>
+    detail::Assign<I, detail::wrap_t<E>, dg::times_equals> operator*=( const E& e) const {return {e};}
+    ///@brief \f$ x_I = x_I / e\f$
+    template<class E>
+    detail::Assign<I, detail::wrap_t<E>, dg::divides_equals> operator/=( const E& e) const {return {e};}
+};
+
+static const Arg<0> _0; //!< placeholder for the 0th container
+static const Arg<1> _1; //!< placeholder for the 1st container
+static const Arg<2> _2; //!< placeholder for the 2nd container
+static const Arg<3> _3; //!< placeholder for the 3rd container
+static const Arg<4> _4; //!< placeholder for the 4th container
+static const Arg<5> _5; //!< placeholder for the 5th container
+static const Arg<6> _6; //!< placeholder for the 6th container
+static const Arg<7> _7; //!< placeholder for the 7th container
+static const Arg<8> _8; //!< placeholder for the 8th container
+static const Arg<9> _9; //!< placeholder for the 9th container
+
+///@cond
+template<class E1, class E2, class = detail::enable_if_expression<E1,E2>>
+detail::Binary<detail::Plus, detail::wrap_t<E1>, detail::wrap_t<E2>> operator+( const E1& e1, const E2& e2){ return {detail::Plus(), e1, e2};}
+template<class E1, class E2, class = detail::enable_if_expression<E1,E2>>
+detail::Binary<detail::Minus, detail::wrap_t<E1>, detail::wrap_t<E2>> operator-( const E1& e1, const E2& e2){ return {detail::Minus(), e1, e2};}
+template<class E1, class E2, class = detail::enable_if_expression<E1,E2>>
+detail::Binary<detail::Times, detail::wrap_t<E1>, detail::wrap_t<E2>> operator*( const E1& e1, const E2& e2){ return {detail::Times(), e1, e2};}
+template<class E1, class E2, class = detail::enable_if_expression<E1,E2>>
+detail::Binary<detail::Divides, detail::wrap_t<E1>, detail::wrap_t<E2>> operator/( const E1& e1, const E2& e2){ return {detail::Divides(), e1, e2};}
+template<class E, class = std::enable_if_t<detail::is_expression<E>::value>>
+detail::Unary<detail::Negate, E> operator-( const E& e){ return {detail::Negate(), e};}
+template<class S1, class S2, class = std::enable_if_t<detail::is_statement<S1>::value && detail::is_statement<S2>::value>>
+detail::Sequence<S1, S2> operator,( const S1& s1, const S2& s2){ return {s1, s2};}
+///@endcond
+
+/**
+ * @brief \f$ f(e)\f$ Apply a functor elementwise
+ *
+ * @param f a functor callable on the device (s.a. \ref DG_DEVICE), e.g. one of the \ref functions
+ * @param e an expression or placeholder
+ * @return an expression
+ */
+template<class UnaryOp, class E>
+detail::Unary<UnaryOp, detail::wrap_t<E>> call( UnaryOp f, const E& e){ return {f, e};}
+/**
+ * @brief \f$ f(e_1, e_2)\f$ Apply a binary functor elementwise
+ *
+ * @param f a functor callable on the device (s.a. \ref DG_DEVICE)
+ * @param e1 an expression or placeholder
+ * @param e2 an expression or placeholder
+ * @return an expression
+ */
+template<class BinaryOp, class E1, class E2>
+detail::Binary<BinaryOp, detail::wrap_t<E1>, detail::wrap_t<E2>> call( BinaryOp f, const E1& e1, const E2& e2){ return {f, e1, e2};}
+
+/**
+ * @brief Execute a lazy statement in one loop over the given containers
+ *
+ * The statement is executed for all elements \c i as
+ * \f[ s( x_{0i}, x_{1i}, ...) \f] in a single call to \c dg::blas1::subroutine
+ * @copydoc hide_iterations
+ *
+@code
+using namespace dg::blas1::lazy;
+//equivalent to dg::blas1::axpby( 2., x, 1., y); dg::blas1::pointwiseDot( y, w, z);
+dg::blas1::lazy::evaluate( ( _0 = 2.*_1 + _0, _2 = _0*_3), y, x, z, w);
+@endcode
+ * @param statement one or more (separated by comma) assignments to placeholders
+ * @param x the container for placeholder \c _0
+ * @param xs the containers for placeholders \c _1, \c _2, ... (in this order)
+ * @attention Containers that are assigned to must be non-const lvalues
+ * @copydoc hide_ContainerType
+ */
+template<class Statement, class ContainerType, class ...ContainerTypes>
+inline void evaluate( const Statement& statement, ContainerType&& x, ContainerTypes&&... xs)
+{
+    static_assert( detail::is_statement<Statement>::value, "The first argument must be an assignment to a placeholder (or a comma separated list of those)!");
+    dg::blas1::subroutine( detail::Kernel<Statement>( statement),
+        std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...);
+}
+///@}
+
+}//namespace lazy
+}//namespace blas1
+}//namespace dg
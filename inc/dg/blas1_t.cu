@@ -4,6 +4,7 @@
 #include <array>
 
 #include "blas1.h"
+#include "blas1_lazy.h"
 #include "functors.h"
 
 
@@ -119,6 +120,15 @@ int main()
     dg::blas1::scal( w2, 0.6);
     dg::blas1::plus( w3, -7.0);
     std::cout << "e^2-7 = " << w3[0][0] <<" (0.389056...)"<< std::endl;
+    {
+    using namespace dg::blas1::lazy;
+    dg::blas1::lazy::evaluate( ( _2 = 2.*_0 + _1, _3 = _2*_0 - 1.), w1, w2, w3, w4);
+    std::cout << "lazy 2*2+3 = " << w3[0][0] <<" (7)"<< std::endl;
+    std::cout << "lazy 7*2-1 = " << w4[0][0] <<" (13)"<< std::endl;
+    dg::blas1::lazy::evaluate( ( _0 += -_1/2., _1 *= call( dg::EXP<>(), _0 - 0.5)), w1, w2);
+    std::cout << "lazy 2-3/2 = " << w1[0][0] <<" (0.5)"<< std::endl;
+    std::cout << "lazy 3*e^0 = " << w2[0][0] <<" (3)"<< std::endl;
+    }
     std::cout << "\nFINISHED! Continue with topology/evaluation_t.cu !\n\n";
 
     return 0;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <initializer_list>
 #include "backend/tensor_traits.h"
 #include "backend/tensor_traits_std.h"
 #include "backend/tensor_traits_thrust.h"
@@ -173,6 +174,19 @@ inline void doSymv( MatrixType&& M,
             get_tensor_category<ContainerType1>());
 }
 
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void doSymv_batch( get_value_type<ContainerType1> alpha,
+                  MatrixType&& M,
+                  const std::vector<const ContainerType1*>& x,
+                  get_value_type<ContainerType1> beta,
+                  const std::vector<ContainerType2*>& y,
+                  AnyMatrixTag)
+{
+    //no fused kernel available: apply M to one vector after the other
+    for( unsigned v=0; v<x.size(); v++)
+        dg::blas2::symv( alpha, std::forward<MatrixType>(M), *x[v], beta, *y[v]);
+}
+
 }//namespace detail
 ///@endcond
 
@@ -225,6 +239,116 @@ inline void symv( MatrixType&& M,
 {
     dg::blas2::detail::doSymv( std::forward<MatrixType>(M), x, y, get_tensor_category<MatrixType>());
 }
+/*! @brief \f$ y_v = \alpha M x_v + \beta y_v\f$ for several vectors
+ *
+ * This routine computes \f[ y_v = \alpha M x_v + \beta y_v \f]
+ * for \f$ v = 0,\dots,N-1\f$ where \f$ M\f$ is a matrix.
+ * The result is the same as
+ * @code
+ * for( unsigned v=0; v<N; v++)
+ *     dg::blas2::symv( alpha, M, *x[v], beta, *y[v]);
+ * @endcode
+ * If \c M has the \c SparseBlockMatrixTag (the derivatives in \c dg::DMatrix)
+ * the matrix is applied to all vectors in a single sweep over its block
+ * structure, i.e. the indices and blocks are read only once.
+ * The same holds for csr matrices with the \c CuspMatrixTag (the
+ * interpolation matrices in \c dg::IHMatrix) with \c SerialTag or \c OmpTag,
+ * where every row is read once and applied to all vectors.
+ * For all other matrix types the vectors are simply processed one after the
+ * other.
+ * @code
+ * dg::blas2::symv( 1., dx, {&lhs, &rhs}, 0., {&dxlhs, &dxrhs});
+ * @endcode
+ * @param alpha A Scalar
+ * @param M The Matrix
+ * @param x list of pointers to input vectors
+ * @param beta A Scalar
+ * @param y list of pointers to output vectors (must have the same size as \c x;
+ *  no output may alias any input)
+ * @copydoc hide_matrix
+ * @copydoc hide_ContainerType
+ */
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void symv( get_value_type<ContainerType1> alpha,
+                  MatrixType&& M,
+                  std::initializer_list<const ContainerType1*> x,
+                  get_value_type<ContainerType1> beta,
+                  std::initializer_list<ContainerType2*> y)
+{
+    if( x.size() != y.size())
+        throw Error( Message(_ping_)<<"Number of input vectors "<<x.size()<<" does not match number of output vectors "<<y.size());
+    if(alpha == (get_value_type<ContainerType1>)0) {
+        for( auto yy : y)
+            dg::blas1::scal( *yy, beta);
+        return;
+    }
+    dg::blas2::detail::doSymv_batch( alpha, std::forward<MatrixType>(M),
+            std::vector<const ContainerType1*>(x), beta,
+            std::vector<ContainerType2*>(y), get_tensor_category<MatrixType>());
+}
+
+/*! @brief \f$ y_v = M x_v\f$ for several vectors
+ *
+ * Equivalent to \c dg::blas2::symv( 1., M, x, 0., y)
+ * @code
+ * dg::blas2::symv( dx, {&lhs, &rhs}, {&dxlhs, &dxrhs});
+ * @endcode
+ * @param M The Matrix
+ * @param x list of pointers to input vectors
+ * @param y list of pointers to output vectors (must have the same size as \c x;
+ *  no output may alias any input)
+ * @copydoc hide_matrix
+ * @copydoc hide_ContainerType
+ */
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void symv( MatrixType&& M,
+                  std::initializer_list<const ContainerType1*> x,
+                  std::initializer_list<ContainerType2*> y)
+{
+    dg::blas2::symv( 1., std::forward<MatrixType>(M), x, 0., y);
+}
+
+/*! @brief \f$ y_v = M x_v\f$ for a number of vectors only known at runtime
+ *
+ * Same as \c dg::blas2::symv( M, {x[0],...}, {y[0],...}), i.e. the matrix
+ * is applied to all vectors in a single sweep if possible
+ * @code
+ * std::vector<const dg::View<const dg::DVec>*> x_ptr( Nz);
+ * std::vector<dg::View<dg::DVec>*> y_ptr( Nz);
+ * for( unsigned i=0; i<Nz; i++)
+ *     x_ptr[i] = &x[i], y_ptr[i] = &y[i];
+ * dg::blas2::symv( interpolate, x_ptr, y_ptr);
+ * @endcode
+ * @param M The Matrix
+ * @param x pointers to input vectors
+ * @param y pointers to output vectors (must have the same size as \c x;
+ *  no output may alias any input)
+ * @copydoc hide_matrix
+ * @copydoc hide_ContainerType
+ */
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void symv( MatrixType&& M,
+                  const std::vector<const ContainerType1*>& x,
+                  const std::vector<ContainerType2*>& y)
+{
+    if( x.size() != y.size())
+        throw Error( Message(_ping_)<<"Number of input vectors "<<x.size()<<" does not match number of output vectors "<<y.size());
+    dg::blas2::detail::doSymv_batch( (get_value_type<ContainerType1>)1,
+            std::forward<MatrixType>(M), x, (get_value_type<ContainerType1>)0,
+            y, get_tensor_category<MatrixType>());
+}
+///@cond
+//a non-const y would otherwise be taken by the single vector symv
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void symv( MatrixType&& M,
+                  const std::vector<const ContainerType1*>& x,
+                  std::vector<ContainerType2*>& y)
+{
+    const std::vector<ContainerType2*>& y_const = y;
+    dg::blas2::symv( std::forward<MatrixType>(M), x, y_const);
+}
+///@endcond
+
 /*! @brief \f$ y = \alpha M x + \beta y \f$;
  * (alias for symv)
  *
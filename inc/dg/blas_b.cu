@@ -131,6 +131,22 @@ int main()
         dg::blas1::subroutine( test_inplace(), x, y, z, u, v);
     t.toc();
     std::cout<<"Subroutine ( G Cdot x = x)       "<<t.diff()/multi<<"s\t"<<7*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+    {
+        dg::blas1::axpby( 2., x, 1., y);
+        dg::blas1::pointwiseDot( y, u, z);
+    }
+    t.toc();
+    std::cout<<"Separate (2x+y=y, yu=z)          "<<t.diff()/multi<<"s\t"<<5*gbytes*multi/t.diff()<<"GB/s\n";
+    {
+    using namespace dg::blas1::lazy;
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::lazy::evaluate( ( _1 = 2.*_0 + _1, _3 = _1*_2), x, y, u, z);
+    t.toc();
+    std::cout<<"Lazy fused (2x+y=y, yu=z)        "<<t.diff()/multi<<"s\t"<<5*gbytes*multi/t.diff()<<"GB/s\n";
+    }
     /////////////////////SYMV////////////////////////////////
     std::cout<<"\nLocal communication\n";
     Matrix M;
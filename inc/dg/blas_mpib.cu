@@ -158,11 +158,19 @@ int main( int argc, char* argv[])
 
     dg::blas2::transfer(dg::create::dx( grid, dg::centered), M);
     dg::blas2::symv( M, x, y);//warm up
+    M.reset_timings();
     t.tic();
     for( int i=0; i<multi; i++)
         dg::blas2::symv( M, x, y);
     t.toc();
     if(rank==0)std::cout<<"centered x derivative took       "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+#ifdef DG_BENCHMARK
+    if(rank==0 && M.timings().calls > 0)
+    {
+        std::cout<<"    gather "<<M.timings().gather/multi<<"s\t inner "<<M.timings().inner/multi<<"s\t";
+        std::cout<<" comm "<<M.timings().comm/multi<<"s\t outer "<<M.timings().outer/multi<<"s\n";
+    }
+#endif //DG_BENCHMARK
 
     dg::blas2::transfer(dg::create::dy( grid, dg::centered), M);
     dg::blas2::symv( M, x, y);//warm up
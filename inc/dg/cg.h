@@ -2,6 +2,9 @@
 #define _DG_CG_
 
 #include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
 
 #include "blas.h"
 #include "functors.h"
@@ -236,17 +239,19 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
         blas1::axpby( -alpha, ap, 1., r);
         if( 0 == i%save_on_dots )
         {
+            //dot is collective, so all ranks must compute it
+            value_type nrmr = sqrt( blas2::dot(S,r));
 #ifdef DG_DEBUG
 #ifdef MPI_VERSION
             if(rank==0)
 #endif //MPI
             {
-                std::cout << "# Absolute r*S*r "<<sqrt( blas2::dot(S,r)) <<"\t ";
+                std::cout << "# Absolute r*S*r "<<nrmr <<"\t ";
                 std::cout << "#  < Critical "<<eps*nrmb + eps <<"\t ";
-                std::cout << "# (Relative "<<sqrt( blas2::dot(S,r) )/nrmb << ")\n";
+                std::cout << "# (Relative "<<nrmr/nrmb << ")\n";
             }
 #endif //DG_DEBUG
-                if( sqrt( blas2::dot(S,r)) < eps*(nrmb + nrmb_correction))
+                if( nrmr < eps*(nrmb + nrmb_correction))
                     return i;
         }
         blas2::symv(P,r,ap);
@@ -258,6 +263,539 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
 }
 ///@endcond
 
+///@cond
+namespace detail{
+//Exact scalar products (r,u), (w,u) and (r,S,r) of the pipelined CG method
+//The generic version computes them directly (no global communication to fuse)
+template<class ContainerType, class Category = get_tensor_category<ContainerType>>
+struct PipelinedDots
+{
+    using value_type = get_value_type<ContainerType>;
+    template<class SquareNorm>
+    void start( const ContainerType& r, const ContainerType& u,
+        const ContainerType& w, const SquareNorm& S, bool with_norm)
+    {
+        m_result[0] = blas1::dot( r, u);
+        m_result[1] = blas1::dot( w, u);
+        m_result[2] = with_norm ? blas2::dot( r, S, r) : 0;
+    }
+    std::array<value_type,3> finish( ) { return m_result;}
+    private:
+    std::array<value_type,3> m_result;
+};
+#ifdef MPI_VERSION
+//The MPI version accumulates the local superaccumulators and starts a single
+//non-blocking reduction that is completed in finish
+template<class ContainerType>
+struct PipelinedDots<ContainerType, MPIVectorTag>
+{
+    using value_type = get_value_type<ContainerType>;
+    template<class SquareNorm>
+    void start( const ContainerType& r, const ContainerType& u,
+        const ContainerType& w, const SquareNorm& S, bool with_norm)
+    {
+        m_num = with_norm ? 3 : 2;
+        m_in.resize( 3*exblas::BIN_COUNT), m_out.resize( 3*exblas::BIN_COUNT);
+        std::vector<int64_t> acc = blas1::detail::doDot_superacc( r.data(), u.data());
+        std::copy( acc.begin(), acc.end(), m_in.begin());
+        acc = blas1::detail::doDot_superacc( w.data(), u.data());
+        std::copy( acc.begin(), acc.end(), m_in.begin() + exblas::BIN_COUNT);
+        if( with_norm)
+        {
+            acc = blas2::detail::doDot_superacc( r.data(),
+                do_get_data( S, get_tensor_category<SquareNorm>()), r.data());
+            std::copy( acc.begin(), acc.end(), m_in.begin() + 2*exblas::BIN_COUNT);
+        }
+        m_comm = r.communicator(), m_comm_mod = r.communicator_mod();
+        m_comm_red = r.communicator_mod_reduce();
+        exblas::reduce_mpi_cpu_start( m_num, m_in.data(), m_out.data(),
+            m_comm, m_comm_mod, m_comm_red, &m_request);
+    }
+    std::array<value_type,3> finish( )
+    {
+        exblas::reduce_mpi_cpu_finish( m_num, m_in.data(), m_out.data(),
+            m_comm, m_comm_mod, m_comm_red, &m_request);
+        std::array<value_type,3> result{0,0,0};
+        for( unsigned k=0; k<m_num; k++)
+            result[k] = exblas::cpu::Round( &m_out[k*exblas::BIN_COUNT]);
+        return result;
+    }
+    private:
+    unsigned m_num;
+    std::vector<int64_t> m_in, m_out;
+    MPI_Comm m_comm, m_comm_mod, m_comm_red;
+    MPI_Request m_request;
+};
+#endif //MPI_VERSION
+
+template<class T>
+struct PipelinedCGUpdate
+{
+    PipelinedCGUpdate( T alpha, T beta): m_alpha(alpha), m_beta(beta){}
+    DG_DEVICE
+    void operator()( T n, T m, T& z, T& q, T& s, T& p, T& x, T& r, T& u, T& w) const
+    {
+        z = DG_FMA( m_beta, z, n);
+        q = DG_FMA( m_beta, q, m);
+        s = DG_FMA( m_beta, s, w);
+        p = DG_FMA( m_beta, p, u);
+        x = DG_FMA( m_alpha, p, x);
+        r = DG_FMA( -m_alpha, s, r);
+        u = DG_FMA( -m_alpha, q, u);
+        w = DG_FMA( -m_alpha, z, w);
+    }
+    private:
+    T m_alpha, m_beta;
+};
+}//namespace detail
+///@endcond
+
+/**
+* @brief Pipelined preconditioned conjugate gradient method to solve
+* \f[ M^{-1}Ax=M^{-1}b\f]
+*
+* @ingroup invert
+*
+* Mathematically equivalent to \c dg::CG but the recurrences are rearranged
+* such that all scalar products of one iteration are computed with a single
+* global reduction. With MPI this reduction is non-blocking and overlaps with
+* the application of the preconditioner and the matrix. This hides the latency
+* of the reduction when many processes are involved at the price of 6 more
+* vectors in memory and slightly more floating point rounding.
+* The scalar products remain binary reproducible.
+* @sa P. Ghysels and W. Vanroose, Hiding global synchronization latency in the preconditioned Conjugate Gradient algorithm, Parallel Computing 40, 224-238 (2014)
+* @note Use it as a drop-in replacement for \c dg::CG e.g. in \c dg::Invert or \c dg::MultigridCG2d
+* @attention beware the sign: a negative definite matrix does @b not work in Conjugate gradient
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class PipelinedCG
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    PipelinedCG(){}
+    ///@copydoc construct()
+    PipelinedCG( const ContainerType& copyable, unsigned max_iterations){
+        construct( copyable, max_iterations);
+    }
+    ///@copydoc CG::set_max()
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@copydoc CG::get_max()
+    unsigned get_max() const {return m_max_iter;}
+    ///@copydoc CG::copyable()
+    const ContainerType& copyable()const{ return m_r;}
+
+    ///@copydoc CG::construct()
+    void construct( const ContainerType& copyable, unsigned max_iterations) {
+        m_r = m_u = m_w = m_m = m_n = m_z = m_q = m_s = m_p = copyable;
+        m_max_iter = max_iterations;
+    }
+    /**
+     * @brief Solve the system A*x = b using a pipelined preconditioned conjugate gradient method
+     *
+     * The iteration stops if \f$ ||b - Ax||_P < \epsilon( ||b||_P + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$
+     * @param A A symmetric, positive definit matrix
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @return Number of iterations used to achieve desired precision
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A class for which the <tt> blas2::symv(const Preconditioner&, const ContainerType&, ContainerType&) and
+     blas2::dot( const Preconditioner&, const ContainerType&) </tt> functions are callable.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner >
+    unsigned operator()( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P , value_type eps = 1e-12, value_type nrmb_correction = 1){
+        return this->operator()( A, x, b, P, P, eps, nrmb_correction, 1);
+    }
+    /**
+     * @brief Solve \f$ Ax = b\f$ using a pipelined preconditioned conjugate gradient method
+     *
+     * The iteration stops if \f$ ||Ax||_S < \epsilon( ||b||_S + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$ and \f$ S \f$ defines a square norm
+     * @param A A symmetric positive definit matrix
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @param test_frequency if set to 1 then the norm of the error is computed in every iteration to test if the loop can be terminated. The norm is part of the single reduction per iteration, so a value larger than 1 only saves the local computation.
+     *
+     * @return Number of iterations used to achieve desired precision
+     * @note Required memops per iteration (\c P and \c S are assumed vectors):
+             - 21  reads + 8 writes
+             - plus the number of memops for \c A;
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned operator()( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1, int test_frequency = 1);
+  private:
+    ContainerType m_r, m_u, m_w, m_m, m_n, m_z, m_q, m_s, m_p;
+    detail::PipelinedDots<ContainerType> m_dots;
+    unsigned m_max_iter;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+unsigned PipelinedCG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction, int test_frequency )
+{
+    value_type nrmb = sqrt( blas2::dot( S, b));
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if(rank==0)
+#endif //MPI
+    {
+    std::cout << "# Norm of S b "<<nrmb <<"\n";
+    std::cout << "# Residual errors: \n";
+    }
+#endif //DG_DEBUG
+    if( nrmb == 0)
+    {
+        blas1::copy( b, x);
+        return 0;
+    }
+    blas2::symv( A,x,m_r);
+    blas1::axpby( 1., b, -1., m_r);
+    blas2::symv( P, m_r, m_u);
+    blas2::symv( A, m_u, m_w);
+    //z, q, s, p are multiplied by beta = 0 in the first iteration
+    blas1::copy( 0., m_z), blas1::copy( 0., m_q);
+    blas1::copy( 0., m_s), blas1::copy( 0., m_p);
+    value_type alpha = 0, beta = 0, gamma_old = 0;
+    for( unsigned i=0; i<m_max_iter; i++)
+    {
+        bool test = ( 0 == i%test_frequency);
+        m_dots.start( m_r, m_u, m_w, S, test);
+        //overlap the reduction with preconditioner and matrix
+        blas2::symv( P, m_w, m_m);
+        blas2::symv( A, m_m, m_n);
+        std::array<value_type,3> dots = m_dots.finish();
+        value_type gamma = dots[0], delta = dots[1];
+        if( test)
+        {
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+            if(rank==0)
+#endif //MPI
+            {
+                std::cout << "# Absolute r*S*r "<<sqrt( dots[2]) <<"\t ";
+                std::cout << "#  < Critical "<<eps*nrmb + eps <<"\t ";
+                std::cout << "# (Relative "<<sqrt( dots[2])/nrmb << ")\n";
+            }
+#endif //DG_DEBUG
+            if( sqrt( dots[2]) < eps*(nrmb + nrmb_correction))
+                return i;
+        }
+        if( i > 0)
+        {
+            beta = gamma/gamma_old;
+            alpha = gamma/(delta - beta*gamma/alpha);
+        }
+        else
+        {
+            beta = 0;
+            alpha = gamma/delta;
+        }
+        blas1::subroutine( detail::PipelinedCGUpdate<value_type>( alpha, beta),
+            m_n, m_m, m_z, m_q, m_s, m_p, x, m_r, m_u, m_w);
+        gamma_old = gamma;
+    }
+    return m_max_iter;
+}
+///@endcond
+
+///@cond
+namespace detail{
+//Collect a batch of scalar products and reduce them together
+//The generic version computes weighted products directly (no global
+//communication to fuse) and the products of two ContainerTypes in one pass
+template<class ContainerType, class Category = get_tensor_category<ContainerType>>
+struct MultiDots
+{
+    using value_type = get_value_type<ContainerType>;
+    void clear() { m_result.clear(), m_pairs.clear(), m_idx.clear();}
+    void add( const ContainerType& x, const ContainerType& y) {
+        m_idx.push_back( m_result.size());
+        m_pairs.push_back( {&x, &y});
+        m_result.push_back( 0);
+    }
+    template<class ContainerType1, class ContainerType2>
+    void add( const ContainerType1& x, const ContainerType2& y) {
+        m_result.push_back( blas1::dot( x, y));
+    }
+    template<class ContainerType1, class MatrixType, class ContainerType2>
+    void add( const ContainerType1& x, const MatrixType& m, const ContainerType2& y) {
+        m_result.push_back( blas2::dot( x, m, y));
+    }
+    const std::vector<value_type>& reduce() {
+        std::vector<value_type> dots = blas1::dots( m_pairs);
+        for( unsigned k=0; k<dots.size(); k++)
+            m_result[m_idx[k]] = dots[k];
+        m_pairs.clear(), m_idx.clear();
+        return m_result;
+    }
+    private:
+    std::vector<value_type> m_result;
+    std::vector<std::array<const ContainerType*,2>> m_pairs;
+    std::vector<unsigned> m_idx;
+};
+#ifdef MPI_VERSION
+//The MPI version accumulates the local superaccumulators of all scalar
+//products and reduces them in a single call to exblas::reduce_mpi_cpu
+template<class ContainerType>
+struct MultiDots<ContainerType, MPIVectorTag>
+{
+    using value_type = get_value_type<ContainerType>;
+    void clear() { m_in.clear(), m_x.clear(), m_y.clear(), m_idx.clear();}
+    //the products of two ContainerTypes are computed in one pass in reduce
+    void add( const ContainerType& x, const ContainerType& y) {
+        m_idx.push_back( m_in.size()/exblas::BIN_COUNT);
+        m_x.push_back( &x.data()), m_y.push_back( &y.data());
+        append( std::vector<int64_t>( exblas::BIN_COUNT, 0), x);
+    }
+    template<class ContainerType1, class ContainerType2>
+    void add( const ContainerType1& x, const ContainerType2& y) {
+        append( blas1::detail::doDot_superacc( x.data(), y.data()), x);
+    }
+    template<class ContainerType1, class MatrixType, class ContainerType2>
+    void add( const ContainerType1& x, const MatrixType& m, const ContainerType2& y) {
+        append( blas2::detail::doDot_superacc( x.data(),
+            do_get_data( m, get_tensor_category<MatrixType>()), y.data()), x);
+    }
+    const std::vector<value_type>& reduce()
+    {
+        unsigned num = m_in.size()/exblas::BIN_COUNT;
+        m_result.resize( num);
+        if( num == 0)
+            return m_result;
+        if( !m_x.empty())
+        {
+            std::vector<int64_t> acc = blas1::detail::doDots_superacc( m_x, m_y);
+            for( unsigned k=0; k<m_idx.size(); k++)
+                std::copy( acc.begin() + k*exblas::BIN_COUNT,
+                    acc.begin() + (k+1)*exblas::BIN_COUNT,
+                    m_in.begin() + m_idx[k]*exblas::BIN_COUNT);
+            m_x.clear(), m_y.clear(), m_idx.clear();
+        }
+        m_out.resize( m_in.size());
+        exblas::reduce_mpi_cpu( num, m_in.data(), m_out.data(), m_comm,
+            m_comm_mod, m_comm_red);
+        for( unsigned k=0; k<num; k++)
+            m_result[k] = exblas::cpu::Round( &m_out[k*exblas::BIN_COUNT]);
+        return m_result;
+    }
+    private:
+    template<class ContainerType1>
+    void append( const std::vector<int64_t>& acc, const ContainerType1& x)
+    {
+        m_in.insert( m_in.end(), acc.begin(), acc.end());
+        m_comm = x.communicator(), m_comm_mod = x.communicator_mod();
+        m_comm_red = x.communicator_mod_reduce();
+    }
+    using container_type = typename ContainerType::container_type;
+    std::vector<int64_t> m_in, m_out;
+    std::vector<value_type> m_result;
+    std::vector<const container_type*> m_x, m_y;
+    std::vector<unsigned> m_idx;
+    MPI_Comm m_comm, m_comm_mod, m_comm_red;
+};
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
+/**
+* @brief Preconditioned conjugate gradient method to solve
+* \f[ M^{-1}Ax_i=M^{-1}b_i\f] for several right hand sides \f$ b_i\f$ at once
+*
+* @ingroup invert
+*
+* Runs one \c dg::CG iteration for each right hand side in lockstep. Each
+* iteration applies the matrix and the preconditioner to all unconverged
+* systems and then reduces the scalar products of all systems together,
+* such that the number of global reductions per iteration does not depend on
+* the number of right hand sides. With MPI this means that k systems cost as
+* many reductions as a single one. Converged systems drop out of the
+* iteration.
+* @note For a single right hand side the iterates are the same as the ones of \c dg::CG
+* @attention beware the sign: a negative definite matrix does @b not work in Conjugate gradient
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class MultiCG
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    MultiCG(){}
+    ///@copydoc construct()
+    MultiCG( const ContainerType& copyable, unsigned max_iterations){
+        construct( copyable, max_iterations);
+    }
+    ///@copydoc CG::set_max()
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@copydoc CG::get_max()
+    unsigned get_max() const {return m_max_iter;}
+    ///@copydoc CG::copyable()
+    const ContainerType& copyable()const{ return m_copyable;}
+
+    /**
+     * @brief Allocate memory for the pcg method
+     *
+     * @param copyable A ContainerType must be copy-constructible from this
+     * @param max_iterations Maximum number of iterations to be used
+     * @note The workspace for the individual right hand sides is allocated
+     * in the first call to the solve method (and whenever their number changes)
+     */
+    void construct( const ContainerType& copyable, unsigned max_iterations) {
+        m_copyable = copyable;
+        m_r.clear(), m_p.clear(), m_ap.clear();
+        m_max_iter = max_iterations;
+    }
+    /**
+     * @brief Solve \f$ Ax_i = b_i\f$ for all i using a preconditioned conjugate gradient method
+     *
+     * The iteration for system i stops if \f$ ||b_i - Ax_i||_S < \epsilon( ||b_i||_S + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$ and \f$ S \f$ defines a square norm
+     * @param A A symmetric positive definit matrix
+     * @param x Contains initial values on input and the solutions on output (same size as \c b)
+     * @param b The right hand side vectors.
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @param test_frequency if set to 1 then the norm of the error is computed in every iteration to test if the loop can be terminated. The norm is part of the single reduction per iteration, so a value larger than 1 only saves the local computation.
+     *
+     * @return Number of iterations used to achieve desired precision in all
+     * systems (\c get_max() indicates that at least one system did not converge)
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned operator()( MatrixType& A, std::vector<ContainerType0>& x, const std::vector<ContainerType1>& b, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1, int test_frequency = 1);
+  private:
+    ContainerType m_copyable;
+    std::vector<ContainerType> m_r, m_p, m_ap;
+    detail::MultiDots<ContainerType> m_dots;
+    unsigned m_max_iter;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+unsigned MultiCG< ContainerType>::operator()( Matrix& A, std::vector<ContainerType0>& x, const std::vector<ContainerType1>& b, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction, int test_frequency )
+{
+    unsigned k = b.size();
+    if( m_r.size() != k)
+    {
+        m_r.assign( k, m_copyable);
+        m_p = m_ap = m_r;
+    }
+    m_dots.clear();
+    for( unsigned j=0; j<k; j++)
+        m_dots.add( b[j], S, b[j]);
+    std::vector<value_type> nrmb = m_dots.reduce();
+    // the systems that still iterate
+    std::vector<unsigned> active;
+    for( unsigned j=0; j<k; j++)
+    {
+        nrmb[j] = sqrt( nrmb[j]);
+        if( nrmb[j] == 0)
+        {
+            blas1::copy( b[j], x[j]);
+            continue;
+        }
+        active.push_back(j);
+        blas2::symv( A, x[j], m_r[j]);
+        blas1::axpby( 1., b[j], -1., m_r[j]);
+    }
+    m_dots.clear();
+    for( auto j : active)
+        m_dots.add( m_r[j], S, m_r[j]);
+    std::vector<value_type> dots = m_dots.reduce();
+    std::vector<unsigned> next;
+    for( unsigned l=0; l<active.size(); l++)
+        //if x happens to be the solution
+        if( !(sqrt( dots[l]) < eps*(nrmb[active[l]] + nrmb_correction)))
+            next.push_back( active[l]);
+    active.swap( next);
+    if( active.empty())
+        return 0;
+    m_dots.clear();
+    for( auto j : active)
+    {
+        blas2::symv( P, m_r[j], m_p[j]);//<-- compute p_0
+        m_dots.add( m_p[j], m_r[j]);
+    }
+    std::vector<value_type> nrmzr_old( k);
+    dots = m_dots.reduce();
+    for( unsigned l=0; l<active.size(); l++)
+        nrmzr_old[active[l]] = dots[l];
+    for( unsigned i=1; i<m_max_iter; i++)
+    {
+        m_dots.clear();
+        for( auto j : active)
+        {
+            blas2::symv( A, m_p[j], m_ap[j]);
+            m_dots.add( m_p[j], m_ap[j]);
+        }
+        dots = m_dots.reduce();
+        bool test = ( 0 == i%test_frequency);
+        m_dots.clear();
+        for( unsigned l=0; l<active.size(); l++)
+        {
+            unsigned j = active[l];
+            value_type alpha = nrmzr_old[j]/dots[l];
+            blas1::axpby( alpha, m_p[j], 1., x[j]);
+            blas1::axpby( -alpha, m_ap[j], 1., m_r[j]);
+            blas2::symv( P, m_r[j], m_ap[j]);
+            m_dots.add( m_ap[j], m_r[j]);
+            if( test)
+                m_dots.add( m_r[j], S, m_r[j]);
+        }
+        dots = m_dots.reduce();
+        unsigned stride = test ? 2 : 1;
+        next.clear();
+        for( unsigned l=0; l<active.size(); l++)
+        {
+            unsigned j = active[l];
+            if( test && sqrt( dots[stride*l+1]) < eps*(nrmb[j] + nrmb_correction))
+                continue;
+            value_type nrmzr_new = dots[stride*l];
+            blas1::axpby(1., m_ap[j], nrmzr_new/nrmzr_old[j], m_p[j] );
+            nrmzr_old[j] = nrmzr_new;
+            next.push_back( j);
+        }
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if(rank==0)
+#endif //MPI
+        std::cout << "# Iteration "<<i<<": "<<next.size()<<" of "<<k<<" systems not yet converged\n";
+#endif //DG_DEBUG
+        active.swap( next);
+        if( active.empty())
+            return i;
+    }
+    return m_max_iter;
+}
+///@endcond
+
 /**
 * @brief Extrapolate a polynomial passing through up to three points
 *
@@ -305,10 +843,10 @@ struct Extrapolation
         m_t.assign( max, 0);
         m_max = max;
     }
-    ///return the current extrapolation max
-    ///This may not coincide with the max set in the constructor if values have not been updated yet
+    ///return the extrapolation max set in the constructor
+    ///(if values have not been updated yet fewer values are used in \c extrapolate)
     unsigned get_max( ) const{
-        return m_counter;
+        return m_max;
     }
 
     /**
@@ -462,6 +1000,147 @@ struct Extrapolation
 };
 
 
+/**
+* @brief Initial guess from the projection onto the space of previous solutions
+*
+* This class provides an initial guess for iterative solvers of
+* \f[ A x = b \f]
+* with a symmetric positive definite matrix \f$ A\f$ and a sequence of right
+* hand sides \f$ b\f$ (Fischer's method). It keeps a window of up to \c max
+* previous solutions \f$ \tilde x_i\f$ that are orthonormal with respect to
+* \f$ A\f$ and returns the Galerkin projection of the solution onto their span
+* \f[ x_{init} = \sum_i (\tilde x_i^T b) \tilde x_i\f]
+* This is the vector in the span that minimizes the A-norm of the error.
+* Since \f$ \tilde x_i^T A x = \tilde x_i^T b\f$ all necessary scalar products
+* can be computed from the right hand side alone, such that neither
+* \c extrapolate nor \c update need to apply \f$ A\f$. Each of them involves
+* a single (batched) global reduction.
+*
+* The new solution passed to \c update is orthonormalized against the
+* window (classical Gram-Schmidt); when the window is full the oldest
+* solution is dropped. Solutions that (numerically) lie in the span of the
+* window are not inserted.
+* @note The orthogonality holds for fixed \f$ A\f$. If \f$ A\f$ changes
+* slowly (e.g. the polarisation equation) the guess remains good but is no
+* longer optimal
+* @copydoc hide_ContainerType
+* @ingroup invert
+* @sa P. F. Fischer, Projection techniques for iterative solution of Ax = b with successive right-hand sides, Comput. Methods Appl. Mech. Engrg. 163, 193-204 (1998)
+*/
+template<class ContainerType>
+struct ProjectionExtrapolation
+{
+    using value_type = get_value_type<ContainerType>;
+    using container_type = ContainerType;
+    ///@brief Leave values uninitialized
+    ProjectionExtrapolation( ){ m_max = m_counter = 0; }
+    /*! @brief Set maximum number of solutions and allocate memory
+     * @param max maximum number of previous solutions to project onto (up to 10 is a good choice)
+     * @param copyable the memory is allocated based on this vector
+     */
+    ProjectionExtrapolation( unsigned max, const ContainerType& copyable) {
+        set_max(max, copyable);
+    }
+    ///@copydoc ProjectionExtrapolation(unsigned,const ContainerType&)
+    void set_max( unsigned max, const ContainerType& copyable)
+    {
+        m_counter = 0;
+        m_x.assign( max, copyable);
+        m_max = max;
+    }
+    ///return the maximum number of solutions set in the constructor
+    unsigned get_max( ) const{
+        return m_max;
+    }
+    ///return the current number of solutions in the window
+    ///This may not coincide with the max if values have not been updated yet
+    unsigned get_size( ) const{
+        return m_counter;
+    }
+
+    /**
+    * @brief Project onto the space of previous solutions
+    *
+    * @param b the right hand side of the new equation
+    * @param x (write only) contains the initial guess on output (may not alias \c b)
+    * @tparam ContainerTypes must be usable with \c ContainerType in \ref dispatch
+    * @attention If the update function has never been called \c x is zero
+    */
+    template<class ContainerType0, class ContainerType1>
+    void extrapolate( const ContainerType1& b, ContainerType0& x) const{
+        if( m_counter == 0)
+        {
+            blas1::copy( 0, x);
+            return;
+        }
+        m_dots.clear();
+        for( unsigned i=0; i<m_counter; i++)
+            m_dots.add( m_x[i], b);
+        std::vector<value_type> alpha = m_dots.reduce();
+        blas1::axpby( alpha[0], m_x[0], 0., x);
+        for( unsigned i=1; i<m_counter; i++)
+            blas1::axpby( alpha[i], m_x[i], 1., x);
+    }
+
+    /**
+    * @brief insert a new solution
+    *
+    * @param x the solution of \f$ Ax = b\f$
+    * @param b the right hand side that was used to compute \c x
+    * @tparam ContainerTypes must be usable with \c ContainerType in \ref dispatch
+    */
+    template<class ContainerType0, class ContainerType1>
+    void update( const ContainerType0& x, const ContainerType1& b){
+        if( m_max == 0) return;
+        //the last slot is either free or holds the oldest solution
+        unsigned keep = std::min( m_counter, m_max-1);
+        m_dots.clear();
+        for( unsigned i=0; i<keep; i++)
+            m_dots.add( m_x[i], b);
+        m_dots.add( x, b);
+        std::vector<value_type> beta = m_dots.reduce();
+        // ||x - sum_i beta_i x_i||_A^2 = x^T A x - sum_i beta_i^2
+        value_type norm2 = beta[keep];
+        for( unsigned i=0; i<keep; i++)
+            norm2 -= beta[i]*beta[i];
+        if( !( norm2 > 1e-10*beta[keep])) //lies in the span (or A is not positive)
+            return;
+        value_type nrm = sqrt( norm2);
+        blas1::axpby( 1./nrm, x, 0., m_x[m_max-1]);
+        for( unsigned i=0; i<keep; i++)
+            blas1::axpby( -beta[i]/nrm, m_x[i], 1., m_x[m_max-1]);
+        std::rotate( m_x.rbegin(), m_x.rbegin()+1, m_x.rend());
+        m_counter = keep+1;
+    }
+
+    private:
+    unsigned m_max, m_counter;
+    std::vector<ContainerType> m_x;
+    mutable detail::MultiDots<ContainerType> m_dots;
+};
+
+///@cond
+namespace detail{
+//Invert can use either one of the initial guess generators
+template<class ContainerType, class ContainerType0, class ContainerType1>
+void predict( const Extrapolation<ContainerType>& ex, const ContainerType1& b, ContainerType0& x){
+    ex.extrapolate( x);
+}
+template<class ContainerType, class ContainerType0, class ContainerType1>
+void predict( const ProjectionExtrapolation<ContainerType>& ex, const ContainerType1& b, ContainerType0& x){
+    ex.extrapolate( b, x);
+}
+template<class ContainerType, class ContainerType0, class ContainerType1>
+void predictor_update( Extrapolation<ContainerType>& ex, const ContainerType0& x, const ContainerType1& b){
+    ex.update( x);
+}
+template<class ContainerType, class ContainerType0, class ContainerType1>
+void predictor_update( ProjectionExtrapolation<ContainerType>& ex, const ContainerType0& x, const ContainerType1& b){
+    ex.update( x, b);
+}
+}//namespace detail
+///@endcond
+
 /**
  * @brief Wrapper around CG and Extrapolation to solve the Equation \f[ Ax = W  b \f]
  *
@@ -482,13 +1161,18 @@ struct Extrapolation
  * symmetric matrix equation. The inverse of \f$W\f$ is
  * a good general purpose preconditioner.
  * @attention beware the sign: a negative definite matrix does @b not work in Conjugate gradient
- * @sa Extrapolation MultigridCG2d
+ * @sa Extrapolation ProjectionExtrapolation MultigridCG2d
  * @copydoc hide_ContainerType
+ * @tparam Solver The iterative solver, either \c dg::CG or \c dg::PipelinedCG
+ * (the latter saves global reductions when many MPI processes are involved)
+ * @tparam Predictor The generator of the initial guess, either \c dg::Extrapolation
+ * or \c dg::ProjectionExtrapolation (then \c extrapolationType is the maximum number of solutions to project onto)
  */
-template<class ContainerType>
+template<class ContainerType, class Solver = dg::CG<ContainerType>, class Predictor = dg::Extrapolation<ContainerType>>
 struct Invert
 {
     typedef typename TensorTraits<ContainerType>::value_type value_type;
+    using solver_type = Solver;
 
     ///@brief Allocate nothing
     Invert() { multiplyWeights_ = true; nrmb_correction_ = 1.; }
@@ -508,7 +1192,7 @@ struct Invert
      * @param copyable Needed to construct the two previous solutions
      * @param max_iter maximum iteration in conjugate gradient
      * @param eps relative error in conjugate gradient
-     * @param extrapolationType number of last values to use for extrapolation of the current guess
+     * @param extrapolationType number of last values to use for extrapolation of the current guess (the maximum number of solutions in the window for \c ProjectionExtrapolation)
      * @param multiplyWeights if true the rhs shall be multiplied by the weights before cg is applied
      * @param nrmb_correction the absolute error \c C in units of \c eps in conjugate gradient
      */
@@ -559,8 +1243,8 @@ struct Invert
      * @brief Solve linear problem
      *
      * Solves the Equation \f[ \hat O \phi = W\rho \f] using a preconditioned
-     * conjugate gradient method. The initial guess comes from an extrapolation
-     * of the last solutions
+     * conjugate gradient method. The initial guess comes from the \c Predictor
+     * (an extrapolation or projection of the last solutions).
      * @copydoc hide_symmetric_op
      * @param op selfmade symmetric Matrix operator class
      * @param phi solution (write only)
@@ -580,8 +1264,8 @@ struct Invert
      * @brief Solve linear problem
      *
      * Solves the Equation \f[ \hat O \phi = W\rho \f] using a preconditioned
-     * conjugate gradient method. The initial guess comes from an extrapolation
-     * of the last solutions.
+     * conjugate gradient method. The initial guess comes from the \c Predictor
+     * (an extrapolation or projection of the last solutions).
      * @copydoc hide_matrix
      * @tparam ContainerTypes must be usable with \c ContainerType in \ref dispatch
      * @tparam SquareNorm A type for which the blas2::dot( const Matrix&, const Vector&) function is callable. This can e.g. be one of the container types.
@@ -606,18 +1290,20 @@ struct Invert
         Timer t;
         t.tic();
 #endif //DG_BENCHMARK
-        m_ex.extrapolate( phi);
-
         unsigned number;
         if( multiplyWeights_ )
         {
             dg::blas2::symv( weights, rho, m_rhs);
+            detail::predict( m_ex, m_rhs, phi);
             number = cg( op, phi, m_rhs, p, inv_weights, eps_, nrmb_correction_);
+            detail::predictor_update( m_ex, phi, m_rhs);
         }
         else
+        {
+            detail::predict( m_ex, rho, phi);
             number = cg( op, phi, rho, p, inv_weights, eps_, nrmb_correction_);
-
-        m_ex.update(phi);
+            detail::predictor_update( m_ex, phi, rho);
+        }
 #ifdef DG_BENCHMARK
         t.toc();
 #ifdef MPI_VERSION
@@ -635,8 +1321,8 @@ struct Invert
 
   private:
     value_type eps_, nrmb_correction_;
-    dg::CG< ContainerType > cg;
-    Extrapolation<ContainerType> m_ex;
+    Solver cg;
+    Predictor m_ex;
     ContainerType m_rhs;
     bool multiplyWeights_;
 };
@@ -66,6 +66,35 @@ int main( int argc, char* argv[])
     if(rank==0)std::cout << "L2 Norm of Residuum is        " << res.d<<"\t"<<res.i << std::endl;
     //Fehler der Integration des Sinus ist vernachlässigbar (vgl. evaluation_t)
 
+    dg::blas1::copy( 0., x);
+    dg::PipelinedCG< dg::MDVec > pipe( x, n*n*Nx*Ny);
+    number = pipe( A, x, b, v2d, v2d, eps);
+    if( rank == 0)
+    {
+        std::cout << "# of pipelined pcg itersations   "<<number<<std::endl;
+        std::cout << "... for a precision of "<< eps<<std::endl;
+    }
+    dg::blas1::axpby( 1., x,-1., solution, error);
+    res.d = sqrt(dg::blas2::dot(w2d , error));
+    if(rank==0)std::cout << "L2 Norm of Error is           " << res.d<<"\t"<<res.i << std::endl;
+
+    std::vector<dg::MDVec> xs( 2, x), bs( 2, b);
+    dg::blas1::copy( 0., xs);
+    dg::blas1::scal( bs[1], 2.);
+    dg::MultiCG< dg::MDVec > mcg( x, n*n*Nx*Ny);
+    number = mcg( A, xs, bs, v2d, v2d, eps);
+    if( rank == 0)
+    {
+        std::cout << "# of multi pcg itersations   "<<number<<std::endl;
+        std::cout << "... for a precision of "<< eps<<std::endl;
+    }
+    for( unsigned j=0; j<2; j++)
+    {
+        dg::blas1::axpby( 1., xs[j],-(j+1.), solution, error);
+        res.d = sqrt(dg::blas2::dot(w2d , error));
+        if(rank==0)std::cout << "L2 Norm of Error "<<j<<" is         " << res.d<<"\t"<<res.i << std::endl;
+    }
+
     MPI_Finalize();
     return 0;
 }
@@ -69,6 +69,25 @@ void solve( std::string solver, Matrix& A, Container& x, const Container& b, con
         unsigned num_iter = bicg.solve( A, x, b, A.precond(), A.inv_weights(), 1e-6);
         std::cout << "After "<<num_iter<<" BICGSTABl iterations we have:\n";
     }
+    if( "pipelined cg" == solver)
+    {
+        std::cout <<" PIPELINED PCG SOLVER:\n";
+        dg::PipelinedCG<Container> pipe( x, n*n*Nx*Ny);
+        unsigned num_iter = pipe( A, x, b, A.precond(), A.inv_weights(), 1e-6);
+        std::cout << "After "<<num_iter<<" pipelined PCG iterations we have:\n";
+    }
+    if( "chebyshev solver" == solver)
+    {
+        std::cout <<" CHEBYSHEV SOLVER WITH LANCZOS BOUNDS:\n";
+        dg::ChebyshevSolver<Container> cheby( x, n*n*Nx*Ny);
+        //the first solve is a CG solve that estimates the spectral bounds
+        unsigned num_cg = cheby( A, x, b, A.precond(), A.inv_weights(), 1e-6);
+        dg::blas1::copy( 0., x);
+        unsigned num_iter = cheby( A, x, b, A.precond(), A.inv_weights(), 1e-6, 1, 10);
+        std::cout << "Bounds "<<cheby.get_bounds()[0]<<" "<<cheby.get_bounds()[1]
+                  <<" from "<<num_cg<<" PCG iterations\n";
+        std::cout << "After "<<num_iter<<" Chebyshev iterations we have:\n";
+    }
     if( "lgmres" == solver)
     {
         std::cout <<" LGMRES SOLVER:\n";
@@ -137,7 +156,7 @@ int main()
     std::cout << "L2 Norm of Residuum is        " << res.d<<"\t"<<res.i << std::endl<<std::endl;
     //Fehler der Integration des Sinus ist vernachlässigbar (vgl. evaluation_t)
 
-    std::vector<std::string> solvers{ "eve cg", "eve pcg", "cheby", "P cheby", "bicgstabl", "lgmres"};
+    std::vector<std::string> solvers{ "eve cg", "eve pcg", "cheby", "P cheby", "bicgstabl", "pipelined cg", "chebyshev solver", "lgmres"};
     for(auto solver : solvers)
     {
         dg::blas1::copy( 0., x);
@@ -158,6 +177,47 @@ int main()
         res.d = sqrt(dg::blas2::dot( w2d, resi));
         std::cout << "L2 Norm of Residuum is        " << res.d<<"\n\n";
     }
+    std::cout <<" MULTI PCG SOLVER:\n";
+    {
+        //solve for b and 2b in lockstep
+        dg::MultiCG<dg::HVec> mcg( copyable_vector, max_iter);
+        std::vector<dg::HVec> xs( 2, dg::evaluate( initial, grid)), bs( 2, b);
+        dg::blas1::scal( bs[1], 2.);
+        num_iter = mcg( A, xs, bs, v2d, v2d, eps);
+        std::cout << "Number of multi pcg iterations "<< num_iter<<std::endl;
+        for( unsigned j=0; j<2; j++)
+        {
+            dg::blas1::axpby( j+1., solution, -1., xs[j], error);
+            res.d = sqrt(dg::blas2::dot(w2d , error));
+            std::cout << "L2 Norm of Error "<<j<<" is         " << res.d<<"\n";
+        }
+        std::cout << "\n";
+    }
+    std::cout <<" PROJECTION EXTRAPOLATION:\n";
+    {
+        //right hand sides in the span of two functions
+        dg::Invert<dg::HVec, dg::CG<dg::HVec>, dg::ProjectionExtrapolation<dg::HVec>>
+            invert( copyable_vector, max_iter, eps, 4);
+        dg::Invert<dg::HVec> invert_ex( copyable_vector, max_iter, eps, 2);
+        const dg::HVec b0 = dg::evaluate( laplace_fct, grid);
+        const dg::HVec b1 = dg::evaluate( [](double x, double y){
+            return 5.*cos(2.*x)*sin(y);}, grid);
+        dg::HVec bk( b0), y( x);
+        for( unsigned k=0; k<4; k++)
+        {
+            dg::blas1::axpby( cos(0.5*k), b0, sin(0.5*k), b1, bk);
+            unsigned number = invert( A, x, bk);
+            unsigned number_ex = invert_ex( A, y, bk);
+            std::cout << "Number of iterations "<<k<<" projection "<<number
+                      <<" extrapolation "<<number_ex<<"\n";
+        }
+        //solution of last rhs is cos(1.5) sin(x)sin(y) + sin(1.5) cos(2x) sin(y)
+        const dg::HVec sol1 = dg::evaluate( [](double x, double y){
+            return cos(1.5)*sin(x)*sin(y) + sin(1.5)*cos(2.*x)*sin(y);}, grid);
+        dg::blas1::axpby( 1., sol1, -1., x, error);
+        res.d = sqrt(dg::blas2::dot(w2d , error)/dg::blas2::dot( w2d, sol1));
+        std::cout << "Relative L2 Norm of Error is  " << res.d<<"\n\n";
+    }
     // Test Extrapolation object
     double value;
     dg::Extrapolation<double> extra(3,-1);
@@ -5,6 +5,7 @@
 #include <thrust/device_vector.h>
 
 #include "cg.h"
+#include "plane_cg.h"
 #include "elliptic.h"
 
 const unsigned n = 3; //global relative error in L2 norm is O(h^P)
@@ -23,6 +24,10 @@ double initial( double x, double y) {return sin(0);}
 double fct(double x, double y, double z){ return sin(y)*sin(x);}
 double laplace_fct( double x, double y, double z) { return 2*sin(y)*sin(x);}
 double initial( double x, double y, double z) {return sin(0);}
+//a different wave number in each plane
+double kz( double z) { return 1.+floor( z/lz*Nz);}
+double fct_plane(double x, double y, double z){ return sin(kz(z)*y)*sin(kz(z)*x);}
+double laplace_fct_plane( double x, double y, double z) { return 2*kz(z)*kz(z)*fct_plane(x,y,z);}
 
 int main()
 {
@@ -58,5 +63,39 @@ int main()
     std::cout << "L2 Norm2 of Residuum is        " << normres3 <<"\n";
     std::cout << "L2 Norm of relative error is   " <<sqrt( eps3/norm3)<<std::endl;
 
+    std::cout << "TEST PLANE CG\n";
+    dg::Elliptic3d<dg::CartesianGrid3d, dg::HMatrix, dg::HVec> A3d( g3d,
+        dg::not_normed, dg::centered);
+    A3d.set_compute_in_2d( true);
+    b3 = dg::evaluate ( laplace_fct_plane, g3d);
+    const dg::HVec solution_plane = dg::evaluate ( fct_plane, g3d);
+    dg::blas2::symv( w3d, b3, b3);
+    x3 = dg::evaluate( initial, g3d);
+    std::cout << "Number of pcg iterations       "<< pcg3( A3d, x3, b3, v3d, eps_)<<std::endl;
+    dg::HVec x_plane = dg::evaluate( initial, g3d);
+    dg::PlaneCG<dg::HVec> plane_cg( g3d, x_plane, g3d.size());
+    std::cout << "Number of plane cg iterations  "<< plane_cg( A3d, x_plane, b3, v3d, eps_)<<std::endl;
+    std::vector<dg::View<dg::HVec>> x3_planes = dg::split( x3, g3d),
+        x_planes = dg::split( x_plane, g3d);
+    std::vector<dg::View<const dg::HVec>> sol_planes = dg::split( solution_plane, g3d);
+    dg::Grid2d g2d( 0, lx, 0, ly, n, Nx, Ny);
+    const dg::HVec w2d = dg::create::weights( g2d);
+    dg::HVec error2d = dg::evaluate( dg::zero, g2d);
+    for( unsigned k=0; k<Nz; k++)
+    {
+        double norm = dg::blas2::dot( w2d, sol_planes[k]);
+        dg::blas1::axpby( 1., x3_planes[k], -1., sol_planes[k], error2d);
+        double err_cg = sqrt( dg::blas2::dot( w2d, error2d)/norm);
+        dg::blas1::axpby( 1., x_planes[k], -1., sol_planes[k], error2d);
+        double err_plane = sqrt( dg::blas2::dot( w2d, error2d)/norm);
+        std::cout << "Plane "<<k<<" relative error CG "<<err_cg<<" PlaneCG "<<err_plane<<"\n";
+    }
+    std::cout << "PlaneCG with compute_in_2d(false) is CG\n";
+    x_plane = dg::evaluate( initial, g3d);
+    plane_cg.set_compute_in_2d( false);
+    std::cout << "Number of plane cg iterations  "<< plane_cg( A3d, x_plane, b3, v3d, eps_)<<std::endl;
+    dg::blas1::axpby( 1., x_plane, -1., x3);
+    std::cout << "Difference to CG is            "<<sqrt( dg::blas2::dot( w3d, x3))<<" (0)\n";
+
     return 0;
 }
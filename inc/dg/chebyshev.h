@@ -2,6 +2,8 @@
 #define _DG_CHEB_
 
 #include <cmath>
+#include <array>
+#include <vector>
 
 #include "blas.h"
 
@@ -200,6 +202,278 @@ class ChebyshevIteration
     ContainerType m_ax, m_z, m_xm1;
 };
 
+///@cond
+namespace detail{
+//Extreme Eigenvalues of the symmetric tridiagonal matrix with diagonal a
+//and off-diagonal c (c.size() == a.size()-1) by Sturm bisection
+template<class value_type>
+std::array<value_type,2> tridiagonal_extreme_eigenvalues(
+    const std::vector<value_type>& a, const std::vector<value_type>& c)
+{
+    unsigned m = a.size();
+    value_type lo = a[0], hi = a[0];
+    for( unsigned j=0; j<m; j++)
+    {
+        value_type r = (j>0 ? fabs(c[j-1]) : 0) + (j+1<m ? fabs(c[j]) : 0);
+        lo = std::min( lo, a[j]-r), hi = std::max( hi, a[j]+r);
+    }
+    //number of Eigenvalues smaller than x
+    auto count = [&]( value_type x){
+        unsigned num = 0;
+        value_type d = 1;
+        for( unsigned j=0; j<m; j++)
+        {
+            d = a[j] - x - (j>0 ? c[j-1]*c[j-1]/d : 0);
+            if( d == 0) d = 1e-300;
+            if( d < 0) num++;
+        }
+        return num;
+    };
+    std::array<value_type,2> ev;
+    for( unsigned which=0; which<2; which++)
+    {
+        value_type left = lo, right = hi;
+        for( unsigned i=0; i<100 && right-left > 1e-12*fabs(hi); i++)
+        {
+            value_type mid = (left+right)/2.;
+            //smallest: count(mid) >= 1, largest: count(mid) >= m
+            if( count( mid) >= (which == 0 ? 1 : m))
+                right = mid;
+            else
+                left = mid;
+        }
+        ev[which] = which == 0 ? left : right;
+    }
+    return ev;
+}
+}//namespace detail
+///@endcond
+
+/**
+* @brief Chebyshev iteration with cached spectral bounds to solve
+* \f[ M^{-1}Ax=M^{-1}b\f]
+*
+* @ingroup invert
+*
+* A solver that avoids almost all global reductions in repeated solves with
+* the same (or a slowly changing) operator. The first call is a
+* preconditioned conjugate gradient solve that also records its Lanczos
+* coefficients, from which the smallest and largest Eigenvalue of
+* \f$ M^{-1}A\f$ are computed. The following calls use Chebyshev iteration
+* (see \c dg::ChebyshevIteration) on these bounds, which needs no scalar
+* products. Only the residual norm is computed, every \c s iterations (the \c
+* test_frequency parameter). If the Chebyshev iteration diverges (the bounds
+* are no longer valid) or does not converge within the maximum number of
+* iterations, the solution is discarded and a conjugate gradient solve from
+* the original initial guess is used as a fallback, which also refreshes the bounds.
+*
+* The interface is that of \c dg::CG, so the class can be used as the \c Solver
+* of \c dg::MultigridCG2d.
+* @note Chebyshev iteration needs considerably more matrix-vector
+* multiplications than CG to reach the same accuracy (about three times as many
+* on the stages of a typical multigrid solve of the Elliptic operator). It only pays off
+* if the global reductions dominate the cost of a stage, i.e. for small grids
+* distributed on many processes. Use \c dg::CG otherwise.
+* @attention beware the sign: a negative definite matrix does @b not work
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class ChebyshevSolver
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    ChebyshevSolver(){}
+    ///@copydoc construct()
+    ChebyshevSolver( const ContainerType& copyable, unsigned max_iterations){
+        construct( copyable, max_iterations);
+    }
+    ///@brief Set the maximum number of iterations (for the Chebyshev iteration and the CG fallback each)
+    ///@param new_max New maximum number
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@brief Get the current maximum number of iterations
+    ///@return the current maximum
+    unsigned get_max() const {return m_max_iter;}
+    ///@brief Return an object of same size as the object used for construction
+    ///@return A copyable object; what it contains is undefined, its size is important
+    const ContainerType& copyable()const{ return m_r;}
+    /**
+     * @brief Allocate memory
+     *
+     * @param copyable A ContainerType must be copy-constructible from this
+     * @param max_iterations Maximum number of iterations to be used (for the Chebyshev iteration and the CG fallback each)
+     */
+    void construct( const ContainerType& copyable, unsigned max_iterations) {
+        m_x0 = m_xm1 = m_z = m_r = m_p = m_ap = copyable;
+        m_max_iter = max_iterations;
+        m_calls = 0;
+    }
+    /**
+     * @brief Set after how many calls the spectral bounds are refreshed
+     *
+     * @param refresh A conjugate gradient solve is done at least every \c refresh calls (1 means CG only)
+     * @note The default is 0, which means that the bounds are only refreshed
+     * when the Chebyshev iteration fails
+     */
+    void set_refresh( unsigned refresh){ m_refresh = refresh;}
+    ///@brief Discard the current spectral bounds (e.g. after the operator changed drastically)
+    void reset_bounds() { m_calls = 0;}
+    ///@brief The current estimate of the smallest and largest Eigenvalue of \f$ M^{-1}A\f$ (undefined before the first call)
+    std::array<value_type,2> get_bounds() const { return m_ev;}
+    /**
+     * @brief Number of Chebyshev iterations in the last call
+     *
+     * @return 0 if the last call was a CG solve, else the Chebyshev
+     * iterations, including those of a failed attempt that were discarded in favour of the CG fallback
+     */
+    unsigned get_chebyshev_iterations() const { return m_cheby_iter;}
+
+    /**
+     * @brief Solve \f$ Ax = b\f$ using Chebyshev iteration or CG
+     *
+     * The iteration stops if \f$ ||b - Ax||_S < \epsilon( ||b||_S + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$ and \f$ S \f$ defines a square norm
+     * @param A A symmetric positive definit matrix
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @param test_frequency the residual norm is computed every \c test_frequency iterations
+     * (this is the only global reduction in the Chebyshev phase)
+     *
+     * @return Number of iterations used to achieve desired precision, i.e. the Chebyshev
+     * iterations or, if the CG fallback was used, the CG iterations (see \c get_chebyshev_iterations()).
+     * As in \c dg::CG, \c get_max() indicates failure
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned operator()( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1, int test_frequency = 1);
+  private:
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    bool chebyshev( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type tol, unsigned s, unsigned& number);
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned cg( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type tol, unsigned s);
+    ContainerType m_r, m_z, m_x0, m_xm1, m_p, m_ap;
+    unsigned m_max_iter, m_calls = 0, m_refresh = 0, m_cheby_iter = 0;
+    std::array<value_type,2> m_ev;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+unsigned ChebyshevSolver< ContainerType>::operator()( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction, int test_frequency)
+{
+    m_cheby_iter = 0;
+    value_type nrmb = sqrt( blas2::dot( S, b));
+    if( nrmb == 0)
+    {
+        blas1::copy( b, x);
+        return 0;
+    }
+    const value_type tol = eps*(nrmb + nrmb_correction);
+    const unsigned s = test_frequency < 1 ? 1 : test_frequency;
+    if( m_calls > 0 && ( m_refresh == 0 || m_calls < m_refresh))
+    {
+        m_calls++;
+        blas1::copy( x, m_x0);
+        if( chebyshev( A, x, b, P, S, tol, s, m_cheby_iter))
+            return m_cheby_iter;
+        //restart from the initial guess, a diverged iterate is no use to CG
+        blas1::copy( m_x0, x);
+    }
+    return cg( A, x, b, P, S, tol, s);
+}
+
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+bool ChebyshevSolver< ContainerType>::chebyshev( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type tol, unsigned s, unsigned& number)
+{
+    //safety margins around the Lanczos estimates
+    const value_type min_ev = 0.9*m_ev[0], max_ev = 1.1*m_ev[1];
+    const value_type theta = (min_ev+max_ev)/2., delta = (max_ev-min_ev)/2.;
+    value_type rhokm1 = delta/theta, rhok = 0, res_start = 0;
+    blas1::copy( x, m_xm1);
+    blas2::symv( A, x, m_r);
+    blas1::axpby( 1., b, -1., m_r);
+    for( number=0; number<m_max_iter; number++)
+    {
+        if( number%s == 0)
+        {
+            value_type res = sqrt( blas2::dot( S, m_r));
+            if( res < tol)
+                return true;
+            //the residual need not decrease monotonically but it must not grow
+            if( number == 0)
+                res_start = res;
+            else if( res > 2.*res_start) //the bounds are wrong
+                return false;
+        }
+        blas2::symv( P, m_r, m_z);
+        if( number == 0)
+            blas1::axpby( 1./theta, m_z, 1., x); //x_1
+        else
+        {
+            rhok = 1./(2.*theta/delta - rhokm1);
+            blas1::axpbypgz( 1.+rhok*rhokm1, x, 2.*rhok/delta, m_z,
+                -rhok*rhokm1, m_xm1);
+            using std::swap;
+            swap( x, m_xm1);
+            rhokm1 = rhok;
+        }
+        blas2::symv( A, x, m_r);
+        blas1::axpby( 1., b, -1., m_r);
+    }
+    return false;
+}
+
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+unsigned ChebyshevSolver< ContainerType>::cg( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type tol, unsigned s)
+{
+    //PCG that records the Lanczos tridiagonal matrix
+    std::vector<value_type> diag, offdiag;
+    value_type alpha_old = 0, beta_old = 0;
+    auto finish = [&]( unsigned number){
+        if( diag.size() >= 2)
+        {
+            m_ev = detail::tridiagonal_extreme_eigenvalues( diag, offdiag);
+            m_calls = 1;
+        }
+        return number;
+    };
+    blas2::symv( A, x, m_r);
+    blas1::axpby( 1., b, -1., m_r);
+    if( sqrt( blas2::dot( S, m_r)) < tol)
+        return 0;
+    blas2::symv( P, m_r, m_p);
+    value_type nrmzr_old = blas1::dot( m_p, m_r);
+    for( unsigned i=1; i<m_max_iter; i++)
+    {
+        blas2::symv( A, m_p, m_ap);
+        value_type alpha = nrmzr_old/blas1::dot( m_p, m_ap);
+        blas1::axpby( alpha, m_p, 1., x);
+        blas1::axpby( -alpha, m_ap, 1., m_r);
+        diag.push_back( 1./alpha + (i > 1 ? beta_old/alpha_old : 0));
+        if( i > 1)
+            offdiag.push_back( sqrt( beta_old)/alpha_old);
+        if( 0 == i%s && sqrt( blas2::dot( S, m_r)) < tol)
+            return finish( i);
+        blas2::symv( P, m_r, m_ap);
+        value_type nrmzr_new = blas1::dot( m_ap, m_r);
+        beta_old = nrmzr_new/nrmzr_old, alpha_old = alpha;
+        blas1::axpby( 1., m_ap, beta_old, m_p);
+        nrmzr_old = nrmzr_new;
+    }
+    return finish( m_max_iter);
+}
+///@endcond
+
  /** @class hide_polynomial
  *
  * @note This class can be used as a Preconditioner in the CG algorithm. The CG
@@ -3,6 +3,7 @@
 #include "blas.h"
 #include "enums.h"
 #include "backend/memory.h"
+#include "backend/elliptic_kernels.h"
 #include "topology/evaluation.h"
 #include "topology/derivatives.h"
 #ifdef MPI_VERSION
@@ -23,6 +24,121 @@ namespace dg
 // projection tensors as Chi) geometry_elliptic_b, geometry_elliptic_mpib,
 // and geometryX_elliptic_b and geometryX_refined_elliptic_b
 
+///@cond
+namespace detail
+{
+//The fused elliptic kernel works on host and omp ell matrices
+template<class Matrix>
+struct IsFusableEll : std::false_type{};
+template<class T>
+struct IsFusableEll<EllSparseBlockMat<T>> : std::true_type{};
+#if THRUST_DEVICE_SYSTEM!=THRUST_DEVICE_SYSTEM_CUDA
+template<class T>
+struct IsFusableEll<EllSparseBlockMatDevice<T>> : std::true_type{};
+#endif //THRUST_DEVICE_SYSTEM
+
+template<class Matrix>
+EllKernelView<get_value_type<Matrix>> ell_kernel_view( const Matrix& m)
+{
+    return { thrust::raw_pointer_cast( m.data.data()),
+        thrust::raw_pointer_cast( m.cols_idx.data()),
+        thrust::raw_pointer_cast( m.data_idx.data()),
+        m.num_rows, m.num_cols, m.blocks_per_line, m.n, m.left_size,
+        m.right_size, m.right_range[0], m.right_range[1]};
+}
+
+template<class value_type, class Matrix, class Container, class ContainerType0, class ContainerType1>
+bool fused_elliptic2d( value_type alpha, const Matrix& rx, const Matrix& ry,
+    const Matrix& lx, const Matrix& ly, const Matrix& jx, const Matrix& jy,
+    value_type jfactor, bool chi_weight_jump, const Container& sigma,
+    const SparseTensor<Container>& chi, const Container& w, bool divide,
+    const ContainerType0& x, value_type beta, ContainerType1& y,
+    EllEllipticWorkspace<value_type>& ws, std::false_type)
+{
+    return false;
+}
+template<class value_type, class Matrix, class Container, class ContainerType0, class ContainerType1>
+bool fused_elliptic2d( value_type alpha, const Matrix& rx, const Matrix& ry,
+    const Matrix& lx, const Matrix& ly, const Matrix& jx, const Matrix& jy,
+    value_type jfactor, bool chi_weight_jump, const Container& sigma,
+    const SparseTensor<Container>& chi, const Container& w, bool divide,
+    const ContainerType0& x, value_type beta, ContainerType1& y,
+    EllEllipticWorkspace<value_type>& ws, std::true_type)
+{
+    auto vrx = ell_kernel_view( rx), vry = ell_kernel_view( ry),
+         vlx = ell_kernel_view( lx), vly = ell_kernel_view( ly),
+         vjx = ell_kernel_view( jx), vjy = ell_kernel_view( jy);
+    const value_type* x_ptr = thrust::raw_pointer_cast( x.data());
+    value_type* y_ptr = thrust::raw_pointer_cast( y.data());
+    //the kernel writes y while it still reads x
+    if( !ell_elliptic2d_layout( vrx, vry, vlx, vly, vjx, vjy, x.size()) ||
+        y.size() != x.size() || x_ptr == y_ptr)
+        return false;
+    //for n > 4 the unfused version is faster
+    if( vrx.n > 4)
+        return false;
+    auto ptr = []( const Container& v){ return thrust::raw_pointer_cast( v.data());};
+    auto apply = [&](){
+        ell_elliptic2d( get_execution_policy<ContainerType0>(), alpha,
+            vrx, vry, vlx, vly, vjx, vjy, jfactor,
+            chi_weight_jump, ptr(sigma), ptr(chi.value(0,0)),
+            ptr(chi.value(0,1)), ptr(chi.value(1,0)), ptr(chi.value(1,1)),
+            ptr(w), divide, x_ptr, beta, y_ptr, ws);
+    };
+    //the workspace is allocated once and then reused in every call
+    auto prepare = [&]( unsigned num_threads){
+        if( ws.stencils.empty())
+            for( auto m : {vrx, vlx, vjx})
+                ws.stencils.emplace_back( m);
+        if( ws.scratch.size() < num_threads)
+            ws.scratch.resize( num_threads);
+    };
+#ifdef _OPENMP
+    if( std::is_same<get_execution_policy<ContainerType0>, OmpTag>::value)
+    {
+        if( !omp_in_parallel())
+        {
+            prepare( omp_get_max_threads());
+            #pragma omp parallel
+            apply();
+            return true;
+        }
+        //all threads of the enclosing parallel region call this function
+        #pragma omp single
+        prepare( omp_get_num_threads());
+        apply();
+        return true;
+    }
+#endif //_OPENMP
+    prepare( 1);
+    apply();
+    return true;
+}
+
+//Apply the elliptic operator without temporaries if the matrices allow it
+//returns false if the unfused version must be used instead
+template<class value_type, class Matrix, class Container, class ContainerType0, class ContainerType1>
+bool fused_elliptic2d( value_type alpha, const Matrix& rx, const Matrix& ry,
+    const Matrix& lx, const Matrix& ly, const Matrix& jx, const Matrix& jy,
+    value_type jfactor, bool chi_weight_jump, const Container& sigma,
+    const SparseTensor<Container>& chi, const Container& w, bool divide,
+    const ContainerType0& x, value_type beta, ContainerType1& y,
+    EllEllipticWorkspace<value_type>& ws)
+{
+    using fusable = std::integral_constant<bool, IsFusableEll<Matrix>::value
+        && std::is_base_of<SharedVectorTag, get_tensor_category<Container>>::value
+        && std::is_base_of<SharedVectorTag, get_tensor_category<ContainerType0>>::value
+        && std::is_base_of<SharedVectorTag, get_tensor_category<ContainerType1>>::value
+        && !std::is_same<get_execution_policy<ContainerType0>, CudaTag>::value
+        && std::is_same<get_execution_policy<ContainerType0>, get_execution_policy<ContainerType1>>::value
+        && std::is_same<get_value_type<ContainerType0>, value_type>::value
+        && std::is_same<get_value_type<ContainerType1>, value_type>::value>;
+    return fused_elliptic2d( alpha, rx, ry, lx, ly, jx, jy, jfactor,
+        chi_weight_jump, sigma, chi, w, divide, x, beta, y, ws, fusable());
+}
+}//namespace detail
+///@endcond
+
 /**
  * @brief A 2d negative elliptic differential operator \f$ -\nabla \cdot ( \mathbf{\chi}\cdot \nabla ) \f$
  *
@@ -64,6 +180,10 @@ namespace dg
  * @note the jump term \f$ \alpha J\f$  adds artificial numerical diffusion as discussed above
  * @note Since the pattern arises quite often (because of the ExB velocity \f$ u_E^2\f$ in the ion gyro-centre potential)
  * this class also can compute the variation integrand \f$ \lambda^2\nabla \phi\cdot \chi\cdot\nabla\phi\f$
+ * @note On the host (serial and OpenMP) the \c symv member applies gradient,
+ * tensor, divergence and jump terms in a single fused pass over the vector
+ * without intermediate temporaries. Distributed and CUDA matrices use the
+ * composition of \c blas2::symv calls.
  * @attention Pay attention to the negative sign which is necessary to make the matrix @b positive @b definite
  */
 template <class Geometry, class Matrix, class Container>
@@ -271,6 +391,12 @@ class Elliptic
     template<class ContainerType0, class ContainerType1>
     void symv( value_type alpha, const ContainerType0& x, value_type beta, ContainerType1& y)
     {
+        //on the host gradient, tensor, divergence and jumps are fused
+        if( detail::fused_elliptic2d( alpha, m_rightx, m_righty, m_leftx,
+            m_lefty, m_jumpX, m_jumpY, m_jfactor, m_chi_weight_jump, m_sigma,
+            m_chi, m_no == normed ? m_vol : m_weights_wo_vol, m_no == normed,
+            x, beta, y, m_fused))
+            return;
         //compute gradient
         dg::blas2::gemv( m_rightx, x, m_tempx); //R_x*f
         dg::blas2::gemv( m_righty, x, m_tempy); //R_y*f
@@ -363,6 +489,7 @@ class Elliptic
     Container m_sigma, m_vol;
     value_type m_jfactor;
     bool m_chi_weight_jump;
+    EllEllipticWorkspace<value_type> m_fused;
 };
 
 ///@copydoc Elliptic
@@ -548,6 +675,13 @@ class Elliptic3d
     template<class ContainerType0, class ContainerType1>
     void symv( value_type alpha, const ContainerType0& x, value_type beta, ContainerType1& y)
     {
+        //on the host gradient, tensor, divergence and jumps are fused
+        if( !m_multiplyZ && detail::fused_elliptic2d( alpha, m_rightx,
+            m_righty, m_leftx, m_lefty, m_jumpX, m_jumpY, m_jfactor,
+            m_chi_weight_jump, m_sigma, m_chi,
+            m_no == normed ? m_vol : m_weights_wo_vol, m_no == normed, x,
+            beta, y, m_fused))
+            return;
         //compute gradient
         dg::blas2::gemv( m_rightx, x, m_tempx); //R_x*f
         dg::blas2::gemv( m_righty, x, m_tempy); //R_y*f
@@ -627,6 +761,7 @@ class Elliptic3d
     value_type m_jfactor;
     bool m_multiplyZ = true;
     bool m_chi_weight_jump;
+    EllEllipticWorkspace<value_type> m_fused;
 };
 ///@cond
 template< class G, class M, class V>
@@ -74,6 +74,13 @@ int main(int argc, char* argv[] )
 
     dg::MultigridCG2d<dg::aRealMPIGeometry2d<value_type>, Matrix, Vector > multigrid( grid, stages, 0);
 
+    for(unsigned u=0; u<stages; u++)
+    {
+        int dims[2], periods[2], coords[2];
+        MPI_Cart_get( multigrid.grid(u).communicator(), 2, dims, periods, coords);
+        if(rank==0)std::cout << "Stage "<<u<<" local grid "<<multigrid.grid(u).local().Nx()
+            <<" x "<<multigrid.grid(u).local().Ny()<<" on "<<dims[0]<<" x "<<dims[1]<<" processes\n";
+    }
     std::vector<Vector> chi_ = multigrid.project( chi);
     std::vector<dg::Elliptic<dg::aRealMPIGeometry2d<value_type>, Matrix, Vector> > multi_pol( stages);
 
@@ -0,0 +1,177 @@
+#include <iostream>
+#include <iomanip>
+
+#include "elliptic.h"
+#include "backend/typedefs.h"
+
+//Compare the fused symv of Elliptic and Elliptic3d on the host to the
+//composition of blas2::symv calls
+
+//hides the sparse block format from the Elliptic classes so that they
+//cannot fuse
+template<class Matrix>
+struct Unfused
+{
+    Unfused(){}
+    explicit Unfused( const dg::EllSparseBlockMat<double>& m){
+        dg::blas2::transfer( m, m_m);
+    }
+    template<class ContainerType0, class ContainerType1>
+    void symv( const ContainerType0& x, ContainerType1& y) const{
+        dg::blas2::symv( m_m, x, y);
+    }
+    template<class ContainerType0, class ContainerType1>
+    void symv( double alpha, const ContainerType0& x, double beta, ContainerType1& y) const{
+        dg::blas2::symv( alpha, m_m, x, beta, y);
+    }
+    private:
+    Matrix m_m;
+};
+namespace dg{
+template<class Matrix>
+struct TensorTraits<Unfused<Matrix>>
+{
+    using value_type = double;
+    using tensor_category = SelfMadeMatrixTag;
+};
+}
+
+double x2d( double x, double y) {return sin(x)*sin(y)*exp(0.1*x*y);}
+double x3d( double x, double y, double z) {return x2d(x,y)*cos(z) + sin(x+y-z);}
+double sigma2d( double x, double y) {return 1. + 0.5*sin(x)*cos(y);}
+double sigma3d( double x, double y, double z) {return sigma2d( x, y) + 0.1*cos(z);}
+double txx( double x, double y) {return 2. + cos( x);}
+double tyy( double x, double y) {return 2. + sin( y);}
+double txy( double x, double y) {return 0.5*sin(x+y);}
+double txx( double x, double y, double z) {return txx( x, y);}
+double tyy( double x, double y, double z) {return tyy( x, y);}
+double txy( double x, double y, double z) {return txy( x, y) + 0.1*cos(z);}
+
+//a tensor with off-diagonal elements
+template<class Container, class Geometry>
+dg::SparseTensor<Container> tensor( const Geometry& g, std::vector<Container> values)
+{
+    dg::SparseTensor<Container> tau( g);
+    for( auto& v : values)
+        tau.values().push_back( v);
+    tau.idx(0,0) = 2, tau.idx(1,1) = 3, tau.idx(0,1) = tau.idx(1,0) = 4;
+    return tau;
+}
+
+//relative difference between a and b
+template<class Container>
+double difference( const Container& a, const Container& b)
+{
+    Container diff( a);
+    dg::blas1::axpby( 1., b, -1., diff);
+    return sqrt( dg::blas1::dot( diff, diff)/ dg::blas1::dot( b, b));
+}
+
+bool passed = true;
+void report( std::string name, double diff)
+{
+    std::cout << std::setw(40)<<std::left<<name<<" "<<diff;
+    if( diff < 1e-14)
+        std::cout << " PASSED\n";
+    else
+    {
+        std::cout << " FAILED\n";
+        passed = false;
+    }
+}
+
+template<class Elliptic, class UnfusedElliptic, class Container>
+void compare( std::string name, Elliptic& fused, UnfusedElliptic& unfused,
+    const Container& x, const Container& sigma, const dg::SparseTensor<Container>& tau)
+{
+    fused.set_chi( sigma), unfused.set_chi( sigma);
+    fused.set_chi( tau), unfused.set_chi( tau);
+    Container y( x), y_ref( x);
+    //beta = 0
+    dg::blas2::symv( fused, x, y);
+    dg::blas2::symv( unfused, x, y_ref);
+    report( name, difference( y, y_ref));
+    //beta != 0
+    dg::blas1::copy( x, y), dg::blas1::copy( x, y_ref);
+    dg::blas2::symv( 0.5, fused, x, -2., y);
+    dg::blas2::symv( 0.5, unfused, x, -2., y_ref);
+    report( name+" (beta != 0)", difference( y, y_ref));
+#ifdef _OPENMP
+    //serial vectors must not share the work inside a parallel region
+    if( std::is_same<dg::get_execution_policy<Container>, dg::SerialTag>::value)
+    {
+        int size = omp_get_max_threads();
+        std::vector<Container> ys( size, x);
+        #pragma omp parallel
+        {
+            Elliptic local( fused); //each thread has its own temporaries
+            dg::blas2::symv( local, x, ys[omp_get_thread_num()]);
+        }
+        dg::blas2::symv( unfused, x, y_ref);
+        double diff = 0;
+        for( auto& yy : ys)
+            diff = std::max( diff, difference( yy, y_ref));
+        report( name+" (in parallel region)", diff);
+    }
+#endif //_OPENMP
+}
+
+template<class Matrix, class Container>
+void test2d( std::string vec)
+{
+    dg::CartesianGrid2d g2d( 0.1, 2.*M_PI+0.1, 0.2, 2.*M_PI+0.2, 3, 20, 24, dg::DIR, dg::PER);
+    const Container x = dg::construct<Container>( dg::evaluate( x2d, g2d));
+    const Container sigma = dg::construct<Container>( dg::evaluate( sigma2d, g2d));
+    const dg::SparseTensor<Container> tau = tensor<Container>( g2d, {
+        dg::construct<Container>( dg::evaluate( txx, g2d)),
+        dg::construct<Container>( dg::evaluate( tyy, g2d)),
+        dg::construct<Container>( dg::evaluate( txy, g2d))});
+    for( auto no : {dg::normed, dg::not_normed})
+    for( auto jfactor : {0., 1.})
+    for( auto chi_weight_jump : {false, true})
+    {
+        if( jfactor == 0 && chi_weight_jump) continue;
+        dg::Elliptic<dg::CartesianGrid2d, Matrix, Container> fused( g2d, no,
+            dg::centered, jfactor, chi_weight_jump);
+        dg::Elliptic<dg::CartesianGrid2d, Unfused<Matrix>, Container> unfused(
+            g2d, no, dg::centered, jfactor, chi_weight_jump);
+        std::string name = vec+" 2d "+(no == dg::normed ? "normed" : "not_normed")
+            + " jump "+std::to_string((int)jfactor)+(chi_weight_jump ? " chi" : "");
+        compare( name, fused, unfused, x, sigma, tau);
+    }
+}
+
+template<class Matrix, class Container>
+void test3d( std::string vec)
+{
+    dg::CylindricalGrid3d g3d( 1., 2.*M_PI+1, 0.2, 2.*M_PI+0.2, 0., 2.*M_PI, 2, 12, 16, 5, dg::DIR, dg::NEU, dg::PER);
+    const Container x = dg::construct<Container>( dg::evaluate( x3d, g3d));
+    const Container sigma = dg::construct<Container>( dg::evaluate( sigma3d, g3d));
+    const dg::SparseTensor<Container> tau = tensor<Container>( g3d, {
+        dg::construct<Container>( dg::evaluate( txx, g3d)),
+        dg::construct<Container>( dg::evaluate( tyy, g3d)),
+        dg::construct<Container>( dg::evaluate( txy, g3d))});
+    for( auto no : {dg::normed, dg::not_normed})
+    for( auto chi_weight_jump : {false, true})
+    {
+        dg::Elliptic3d<dg::CylindricalGrid3d, Matrix, Container> fused( g3d, no,
+            dg::forward, 1., chi_weight_jump);
+        dg::Elliptic3d<dg::CylindricalGrid3d, Unfused<Matrix>, Container>
+            unfused( g3d, no, dg::forward, 1., chi_weight_jump);
+        fused.set_compute_in_2d( true), unfused.set_compute_in_2d( true);
+        std::string name = vec+" 3d "+(no == dg::normed ? "normed" : "not_normed")
+            + (chi_weight_jump ? " jump chi" : " jump");
+        compare( name, fused, unfused, x, sigma, tau);
+    }
+}
+
+int main()
+{
+    std::cout << "Test the fused elliptic operators against the unfused ones\n";
+    std::cout << std::scientific;
+    test2d<dg::HMatrix, dg::HVec>( "HVec");
+    test2d<dg::DMatrix, dg::DVec>( "DVec");
+    test3d<dg::HMatrix, dg::HVec>( "HVec");
+    test3d<dg::DMatrix, dg::DVec>( "DVec");
+    return passed ? 0 : 1;
+}
@@ -6,18 +6,238 @@
 #include "topology/interpolation.h"
 #include "blas.h"
 #include "cg.h"
+#include "plane_cg.h"
 #include "chebyshev.h"
 #include "eve.h"
 #ifdef DG_BENCHMARK
 #include "backend/timer.h"
 #endif //DG_BENCHMARK
 #ifdef MPI_VERSION
+#include <array>
+#include <map>
+#include "backend/mpi_collective.h"
 #include "topology/mpi_projection.h"
 #endif
 
 namespace dg
 {
 
+///@cond
+namespace detail
+{
+//Redistribute a vector between two process grids of the same global grid
+//(only MPI vectors can be redistributed)
+template<class Container>
+struct MultigridRedistribution
+{
+    void apply( const Container& x, Container& y) const{ }
+};
+#ifdef MPI_VERSION
+//we keep track of communicators that were created in the past
+//(they are freed in MPI_Finalize)
+inline std::map<std::pair<MPI_Comm, std::array<int,2>>, MPI_Comm>& agglomerated_comms()
+{
+    static std::map<std::pair<MPI_Comm, std::array<int,2>>, MPI_Comm> comms;
+    return comms;
+}
+
+//Split a Cartesian communicator into groups of processes that each hold
+//the whole domain on a new_dims[0] x new_dims[1] (x Nz) process grid;
+//the processes of a group are strided through the old process grid such that
+//the local domain of a process is contained in the new local domain
+inline MPI_Comm agglomerated_comm( MPI_Comm comm, std::array<int,2> new_dims)
+{
+    auto key = std::make_pair( comm, new_dims);
+    auto& comms = agglomerated_comms();
+    if( comms.count( key) == 1)
+        return comms[key];
+    int ndims;
+    MPI_Cartdim_get( comm, &ndims);
+    std::vector<int> dims(ndims), periods(ndims), coords(ndims);
+    MPI_Cart_get( comm, ndims, dims.data(), periods.data(), coords.data());
+    int fx = dims[0]/new_dims[0], fy = dims[1]/new_dims[1];
+    int color = coords[0]%fx + fx*(coords[1]%fy);
+    coords[0] /= fx, coords[1] /= fy;
+    dims[0] = new_dims[0], dims[1] = new_dims[1];
+    int rank = 0; //row-major order like MPI_Cart_rank
+    for( int i=0; i<ndims; i++)
+        rank = rank*dims[i] + coords[i];
+    MPI_Comm split, cart;
+    MPI_Comm_split( comm, color, rank, &split); //collective call
+    MPI_Cart_create( split, ndims, dims.data(), periods.data(), false, &cart);
+    MPI_Comm_free( &split);
+    free_at_finalize( cart);
+    comms[key] = cart;
+    return cart;
+}
+//largest divisor of np that evenly divides N and leaves at least 4 cells per process
+inline int agglomerated_dim( int np, unsigned N)
+{
+    for( int d=np; d>1; d--)
+        if( np%d == 0 && N%d == 0 && N/d >= 4)
+            return d;
+    return 1;
+}
+
+template<class LocalContainer>
+struct MultigridRedistribution<MPI_Vector<LocalContainer>>
+{
+    using index_type = std::conditional_t< std::is_same<
+        get_execution_policy<LocalContainer>, CudaTag>::value, iDVec, iHVec>;
+    MultigridRedistribution(){}
+    //from and to are the same global grid on different process grids
+    //comm must contain all processes of both
+    template<class MPITopology>
+    MultigridRedistribution( const MPITopology& from, const MPITopology& to, MPI_Comm comm)
+    {
+        int rank_to;
+        MPI_Comm_rank( to.communicator(), &rank_to);
+        unsigned size = to.local_size();
+        thrust::host_vector<int> localGatherMap( size), pidGatherMap( size);
+        for( unsigned i=0; i<size; i++)
+        {
+            int gIdx = 0;
+            to.local2globalIdx( i, rank_to, gIdx);
+            from.global2localIdx( gIdx, localGatherMap[i], pidGatherMap[i]);
+        }
+        //translate ranks of from.communicator() to comm
+        MPI_Group group_from, group;
+        MPI_Comm_group( from.communicator(), &group_from);
+        MPI_Comm_group( comm, &group);
+        thrust::host_vector<int> pids( pidGatherMap);
+        MPI_Group_translate_ranks( group_from, size, pids.data(), group, pidGatherMap.data());
+        MPI_Group_free( &group_from);
+        MPI_Group_free( &group);
+        m_comm = GeneralComm<iHVec, thrust::host_vector<get_value_type<LocalContainer>>>(
+            from.local_size(), localGatherMap, pidGatherMap, comm);
+    }
+    void apply( const MPI_Vector<LocalContainer>& x, MPI_Vector<LocalContainer>& y) const
+    {
+        m_comm.global_gather( thrust::raw_pointer_cast( x.data().data()), y.data());
+    }
+    private:
+    GeneralComm<index_type, LocalContainer> m_comm;
+};
+
+//distribute the grid onto fewer processes if the next coarser grid leaves
+//too few cells per process; returns true if the communicator was changed
+template<class MPITopology>
+bool agglomerate( MPITopology& g, MPIVectorTag)
+{
+    int ndims;
+    MPI_Cartdim_get( g.communicator(), &ndims);
+    std::vector<int> dims(ndims), periods(ndims), coords(ndims);
+    MPI_Cart_get( g.communicator(), ndims, dims.data(), periods.data(), coords.data());
+    std::array<int,2> new_dims = {
+        agglomerated_dim( dims[0], g.global().Nx()/2),
+        agglomerated_dim( dims[1], g.global().Ny()/2)};
+    if( new_dims[0] == dims[0] && new_dims[1] == dims[1])
+        return false;
+    g.set_communicator( agglomerated_comm( g.communicator(), new_dims));
+    return true;
+}
+#endif //MPI_VERSION
+template<class Topology>
+bool agglomerate( Topology& g, AnyVectorTag){ return false;}
+
+//A MultiMatrix between two multigrid stages that redistributes the fine
+//grid vector if the two stages live on different process grids
+template<class Matrix, class Container>
+struct MultigridTransfer
+{
+    using value_type = get_value_type<Container>;
+    MultigridTransfer(){}
+    template<class OtherMatrix, class OtherContainer, class ... Params>
+    MultigridTransfer( const MultiMatrix<OtherMatrix, OtherContainer>& src, Params&& ... ps):
+        m_matrix( src, std::forward<Params>(ps)...){}
+    template<class ...Params>
+    void construct( Params&& ...ps){
+        *this = MultigridTransfer( std::forward<Params>(ps)...);
+    }
+    //if before: redistribute x before applying the matrix, else redistribute the result
+    void set_redistribution( const MultigridRedistribution<Container>& redist, bool before, const Container& fine_old, const Container& fine_new)
+    {
+        m_redistribute = true;
+        m_before = before;
+        m_redist = redist;
+        m_temp = fine_new;
+        m_temp_old = fine_old;
+    }
+    void symv( const Container& x, Container& y) const{ symv( 1., x, 0., y);}
+    void symv( value_type alpha, const Container& x, value_type beta, Container& y) const
+    {
+        if( !m_redistribute)
+            dg::blas2::symv( alpha, m_matrix, x, beta, y);
+        else if( m_before)
+        {
+            m_redist.apply( x, m_temp);
+            dg::blas2::symv( alpha, m_matrix, m_temp, beta, y);
+        }
+        else
+        {
+            dg::blas2::symv( m_matrix, x, m_temp);
+            m_redist.apply( m_temp, m_temp_old);
+            dg::blas1::axpby( alpha, m_temp_old, beta, y);
+        }
+    }
+    private:
+    MultiMatrix<Matrix, Container> m_matrix;
+    bool m_redistribute = false, m_before = false;
+    MultigridRedistribution<Container> m_redist;
+    mutable Container m_temp, m_temp_old;
+};
+
+#ifdef MPI_VERSION
+//fine_old is the fine grid, fine_new the fine grid distributed like the coarse grid
+template<class Matrix, class Container, class MPITopology, class ...Params>
+void redistribute_transfers( MultigridTransfer<Matrix, Container>& project,
+    MultigridTransfer<Matrix, Container>& interT,
+    MultigridTransfer<Matrix, Container>& inter,
+    const MPITopology& fine_old, const MPITopology& fine_new, MPIVectorTag, Params&& ... ps)
+{
+    MultigridRedistribution<Container> to_new( fine_old, fine_new,
+        fine_old.communicator());
+    MultigridRedistribution<Container> to_old( fine_new, fine_old,
+        fine_old.communicator());
+    Container old = dg::construct<Container>( dg::evaluate( dg::zero,
+        fine_old), std::forward<Params>(ps)...);
+    Container new_ = dg::construct<Container>( dg::evaluate( dg::zero,
+        fine_new), std::forward<Params>(ps)...);
+    project.set_redistribution( to_new, true, old, new_);
+    interT.set_redistribution( to_new, true, old, new_);
+    inter.set_redistribution( to_old, false, old, new_);
+}
+#endif //MPI_VERSION
+template<class Matrix, class Container, class Topology, class ...Params>
+void redistribute_transfers( MultigridTransfer<Matrix, Container>& project,
+    MultigridTransfer<Matrix, Container>& interT,
+    MultigridTransfer<Matrix, Container>& inter,
+    const Topology& fine_old, const Topology& fine_new, AnyVectorTag, Params&& ... ps)
+{
+}
+
+//the solvers at each stage are constructed from the grid of that stage
+template<class Solver, class Geometry, class Container>
+void construct_solver( Solver& solver, const Geometry& g, const Container& copyable)
+{
+    solver.construct( copyable, 1);
+    solver.set_max( g.size());
+}
+template<class Geometry, class Container>
+void construct_solver( PlaneCG<Container>& solver, const Geometry& g, const Container& copyable)
+{
+    solver.construct( g, copyable, g.size());
+}
+}//namespace detail
+
+template <class M, class V>
+struct TensorTraits<detail::MultigridTransfer<M, V> >
+{
+    using value_type  = get_value_type<V>;
+    using tensor_category = SelfMadeMatrixTag;
+};
+///@endcond
+
 /**
 * @brief Solves the Equation \f[ \frac{1}{W} \hat O \phi = \rho \f]
 *
@@ -35,17 +255,32 @@ namespace dg
  * Independent from this, a preconditioner should be used to solve the
  * symmetric matrix equation.
 * @note The preconditioner for the CG solver is taken from the \c precond() method in the \c SymmetricOp class
+* @note In MPI a coarse grid that would leave fewer than 4 cells per process
+* in x or y is agglomerated: the processes are split into groups that each
+* hold the whole coarse grid on a smaller process grid (down to a single
+* process) and solve the coarse problem redundantly. This keeps the coarse
+* solves free of latency (and of global communication if a group consists of
+* one process) and allows many more stages. The \c grid(stage) function
+* returns the agglomerated grids, which must be used to construct the
+* operators; vectors on the finest grid are distributed as usual.
 * @copydoc hide_geometry_matrix_container
+* @tparam Solver The iterative solver used at each stage, either \c dg::CG,
+* \c dg::PipelinedCG (the latter saves global reductions when many MPI processes are involved)
+* or, for 3d operators that do not couple the planes, \c dg::PlaneCG (each plane converges independently)
+* or \c dg::ChebyshevSolver (repeated solves need a global reduction only every
+* \c test_frequency iterations, but about three times as many matrix-vector
+* multiplications as \c dg::CG; only worth trying if the stages are dominated by reduction latency)
 * @ingroup multigrid
 * @sa \c Extrapolation  to generate an initial guess
 *
 */
-template< class Geometry, class Matrix, class Container>
+template< class Geometry, class Matrix, class Container, class Solver = dg::CG<Container>>
 struct MultigridCG2d
 {
     using geometry_type = Geometry;
     using matrix_type = Matrix;
     using container_type = Container;
+    using solver_type = Solver;
     using value_type = get_value_type<Container>;
     ///@brief Allocate nothing, Call \c construct method before usage
     MultigridCG2d(){}
@@ -66,7 +301,12 @@ struct MultigridCG2d
         m_project(  stages-1),
         m_cg(    stages),
         m_cheby( stages),
-        m_x( stages)
+        m_x( stages),
+        m_ev( stages, 0.),
+        m_ev_rq( stages, 0.),
+        m_ev_calls( stages, 0),
+        m_ev_probe( stages),
+        m_ev_ap( stages)
     {
         if(stages < 2 )
             throw Error( Message(_ping_)<<" There must be minimum 2 stages in a multigrid solver! You gave " << stages);
@@ -74,20 +314,26 @@ struct MultigridCG2d
         m_grids[0].reset( grid);
         //m_grids[0].get().display();
 
-		for(unsigned u=1; u<stages; u++)
-        {
-            m_grids[u] = m_grids[u-1]; // deep copy
-            m_grids[u]->multiplyCellNumbers(0.5, 0.5);
-            //m_grids[u]->display();
-        }
-
 		for(unsigned u=0; u<stages-1; u++)
         {
+            // In MPI the coarse grid may be agglomerated onto fewer processes;
+            // fine is then grid u distributed like grid u+1
+            dg::ClonePtr<Geometry> fine = m_grids[u]; // deep copy
+            bool redistribute = detail::agglomerate( *fine,
+                get_tensor_category<Container>());
+            m_grids[u+1] = fine;
+            m_grids[u+1]->multiplyCellNumbers(0.5, 0.5);
+            //m_grids[u+1]->display();
+
             // Projecting from one grid to the next is the same as
             // projecting from the original grid to the coarse grids
-            m_project[u].construct( dg::create::fast_projection(*m_grids[u], 1, 2, 2, dg::normed), std::forward<Params>(ps)...);
+            m_project[u].construct( dg::create::fast_projection(*fine, 1, 2, 2, dg::normed), std::forward<Params>(ps)...);
             m_inter[u].construct( dg::create::fast_interpolation(*m_grids[u+1], 1, 2, 2), std::forward<Params>(ps)...);
-            m_interT[u].construct( dg::create::fast_projection(*m_grids[u], 1, 2, 2, dg::not_normed), std::forward<Params>(ps)...);
+            m_interT[u].construct( dg::create::fast_projection(*fine, 1, 2, 2, dg::not_normed), std::forward<Params>(ps)...);
+            if( redistribute)
+                detail::redistribute_transfers( m_project[u], m_interT[u],
+                    m_inter[u], *m_grids[u], *fine,
+                    get_tensor_category<Container>(), std::forward<Params>(ps)...);
         }
 
         for( unsigned u=0; u<m_stages; u++)
@@ -96,8 +342,7 @@ struct MultigridCG2d
         m_p = m_cgr = m_r[0];
         for (unsigned u = 0; u < m_stages; u++)
         {
-            m_cg[u].construct(m_x[u], 1);
-            m_cg[u].set_max(m_grids[u]->size());
+            detail::construct_solver( m_cg[u], *m_grids[u], m_x[u]);
             m_cheby[u].construct(m_x[u]);
         }
     }
@@ -158,10 +403,46 @@ struct MultigridCG2d
     ///After a call to a solution method returns the maximum number of iterations allowed at stage  0
     ///(if the solution method returns this number, failure is indicated)
     unsigned max_iter() const{return m_cg[0].get_max();}
+    ///@brief Access the solver at given stage (e.g. to change its parameters)
+    ///@param stage must fulfill \c 0 <= stage < stages()
+    Solver& solver( unsigned stage) {return m_cg[stage];}
 
     ///@brief Return an object of same size as the object used for construction on the finest grid
     ///@return A copyable object; what it contains is undefined, its size is important
     const Container& copyable() const {return m_x[0];}
+
+    /**
+     * @brief Control the reuse of largest Eigenvalue estimates
+     *
+     * The Chebyshev based methods need an estimate of the largest Eigenvalue
+     * of the operator at each stage, which is computed with \c dg::EVE. Since
+     * the operator typically changes only slightly between calls (e.g. the
+     * polarisation equation in a time dependent problem) the estimates are
+     * cached and recomputed only every \c every calls or when the operator
+     * has drifted: at each call the Rayleigh quotient of a fixed probe
+     * vector (a few power iterations of the residual at the time of the
+     * estimate) is compared to its value at the time of the estimate.
+     * The check costs one matrix-vector product and one scalar product per
+     * stage.
+     * @param every an estimate is used for at most this many calls (1 means
+     * recompute on every call as without caching; 0 is treated as 1)
+     * @param drift recompute if the Rayleigh quotient changed by more than
+     * this relative amount
+     * @note The defaults are <tt>every = 10, drift = 0.05</tt>
+     */
+    void set_eigenvalue_refresh( unsigned every, value_type drift = 0.05)
+    {
+        m_ev_every = every == 0 ? 1 : every;
+        m_ev_drift = drift;
+    }
+    ///@brief Discard all cached Eigenvalue estimates (e.g. after the operator changed drastically)
+    void reset_eigenvalues()
+    {
+        for( unsigned u=0; u<m_stages; u++)
+            m_ev_calls[u] = 0;
+    }
+    ///@brief The currently cached largest Eigenvalue estimate at each stage (0 if none was made yet)
+    const std::vector<value_type>& eigenvalues() const{ return m_ev;}
     /**
      * @brief USE THIS ONE Nested iterations
      *
@@ -196,27 +477,125 @@ struct MultigridCG2d
     std::vector<unsigned> direct_solve( std::vector<SymmetricOp>& op, ContainerType0&  x, const ContainerType1& b, std::vector<value_type> eps)
     {
         dg::blas2::symv(op[0].weights(), b, m_b[0]);
-        // compute residual r = Wb - A x
-        dg::blas2::symv(op[0], x, m_r[0]);
-        dg::blas1::axpby(-1.0, m_r[0], 1.0, m_b[0], m_r[0]);
-        // project residual down to coarse grid
-        for( unsigned u=0; u<m_stages-1; u++)
-            dg::blas2::gemv( m_interT[u], m_r[u], m_r[u+1]);
+        return nested_iterations( op, x, eps);
+    }
+
+    /**
+     * @brief Nested iterations with an initial guess from previous solutions
+     *
+     * Does the same as \c direct_solve but overwrites \c x with the
+     * initial guess <tt>pred.extrapolate( W b, x)</tt> and inserts the
+     * solution into \c pred afterwards
+     * @copydoc hide_symmetric_op
+     * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
+     * @param op Index 0 is the \c SymmetricOp on the original grid, 1 on the half grid, 2 on the quarter grid, ...
+     * @param x (write only) contains the solution on output
+     * @param b The right hand side (will be multiplied by \c weights)
+     * @param eps the accuracy (see \c direct_solve)
+     * @param pred the predictor of the initial guess (previous solutions must
+     *  have been computed with the same \c op[0] or one that changes slowly)
+     * @return the number of iterations in each of the stages beginning with the finest grid
+     * @sa ProjectionExtrapolation
+    */
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> direct_solve( std::vector<SymmetricOp>& op, ContainerType0&  x, const ContainerType1& b, value_type eps, ProjectionExtrapolation<Container>& pred)
+    {
+        std::vector<value_type> v_eps( m_stages, eps);
+		for( unsigned u=m_stages-1; u>0; u--)
+            v_eps[u] = 1.5*eps;
+        return direct_solve( op, x, b, v_eps, pred);
+    }
+    ///@copydoc direct_solve(std::vector<SymmetricOp>&,ContainerType0&,const ContainerType1&,value_type,ProjectionExtrapolation<Container>&)
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> direct_solve( std::vector<SymmetricOp>& op, ContainerType0&  x, const ContainerType1& b, std::vector<value_type> eps, ProjectionExtrapolation<Container>& pred)
+    {
+        dg::blas2::symv(op[0].weights(), b, m_b[0]);
+        pred.extrapolate( m_b[0], x);
+        std::vector<unsigned> number = nested_iterations( op, x, eps);
+        pred.update( x, m_b[0]);
+        return number;
+    }
+
+    /**
+     * @brief Nested iterations for several right hand sides at once
+     *
+     * Solves \f$ \hat O x_i = W b_i\f$ for all \c i with the same operator.
+     * Does the same as \c direct_solve for each right hand side, but the
+     * systems on each stage are solved together with \c dg::MultiCG.
+     * The scalar products of all systems are reduced together, such that
+     * k right hand sides cost as many global reductions as a single one.
+     * On the other hand all systems iterate until the slowest one converges,
+     * which costs more arithmetic than solving them one after the other.
+     * Use it only if the global reductions dominate, i.e. in MPI with small
+     * local grids on many nodes (see multigrid_b.cu for a comparison).
+     * @note The preconditioner for the CG solver is taken from the \c precond() method in the \c SymmetricOp class
+     * @copydoc hide_symmetric_op
+     * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
+     * @param op Index 0 is the \c SymmetricOp on the original grid, 1 on the half grid, 2 on the quarter grid, ...
+     * @param x (read/write) contains initial guesses on input and the solutions on output (same size as \c b)
+     * @param b The right hand sides (will be multiplied by \c weights)
+     * @param eps the accuracy: iteration stops if \f$ ||b_i - Ax_i|| < \epsilon(
+     * ||b_i|| + 1) \f$ for all \c i.
+     * @return the number of iterations in each of the stages beginning with
+     * the finest grid (the maximum over all right hand sides)
+     * @note Constructs the solvers and allocates workspace for the right
+     * hand sides on all stages in the first call (and whenever their number
+     * changes), such that \c direct_solve alone does not pay for it
+    */
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> direct_solve_multi( std::vector<SymmetricOp>& op, std::vector<ContainerType0>&  x, const std::vector<ContainerType1>& b, value_type eps)
+    {
+        std::vector<value_type> v_eps( m_stages, eps);
+		for( unsigned u=m_stages-1; u>0; u--)
+            v_eps[u] = 1.5*eps;
+        return direct_solve_multi( op, x, b, v_eps);
+    }
+    ///@copydoc direct_solve_multi()
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> direct_solve_multi( std::vector<SymmetricOp>& op, std::vector<ContainerType0>&  x, const std::vector<ContainerType1>& b, std::vector<value_type> eps)
+    {
+        unsigned k = b.size();
+        if( m_multi_cg.empty())
+        {
+            m_multi_cg.resize( m_stages);
+            for( unsigned u=0; u<m_stages; u++)
+                m_multi_cg[u].construct( m_x[u], m_cg[u].get_max());
+        }
+        if( m_multi_b.empty() || m_multi_b[0].size() != k)
+        {
+            m_multi_x.resize( m_stages);
+            for( unsigned u=0; u<m_stages; u++)
+                m_multi_x[u].assign( k, m_x[u]);
+            m_multi_r = m_multi_b = m_multi_x;
+        }
+        for( unsigned j=0; j<k; j++)
+        {
+            dg::blas2::symv(op[0].weights(), b[j], m_multi_b[0][j]);
+            // compute residual r = Wb - A x
+            dg::blas2::symv(op[0], x[j], m_multi_r[0][j]);
+            dg::blas1::axpby(-1.0, m_multi_r[0][j], 1.0, m_multi_b[0][j],
+                m_multi_r[0][j]);
+            // project residual down to coarse grid
+            for( unsigned u=0; u<m_stages-1; u++)
+                dg::blas2::gemv( m_interT[u], m_multi_r[u][j],
+                    m_multi_r[u+1][j]);
+            dg::blas1::scal( m_multi_x[m_stages-1][j], 0.0);
+        }
         std::vector<unsigned> number(m_stages);
 #ifdef DG_BENCHMARK
         Timer t;
 #endif //DG_BENCHMARK
-
-        dg::blas1::scal( m_x[m_stages-1], 0.0);
         //now solve residual equations
 		for( unsigned u=m_stages-1; u>0; u--)
         {
 #ifdef DG_BENCHMARK
             t.tic();
 #endif //DG_BENCHMARK
-            number[u] = m_cg[u]( op[u], m_x[u], m_r[u], op[u].precond(),
-                op[u].inv_weights(), eps[u], 1., 10);
-            dg::blas2::symv( m_inter[u-1], m_x[u], m_x[u-1]);
+            number[u] = m_multi_cg[u]( op[u], m_multi_x[u], m_multi_r[u],
+                op[u].precond(), op[u].inv_weights(), eps[u], 1, 10);
+            for( unsigned j=0; j<k; j++)
+                dg::blas2::symv( m_inter[u-1], m_multi_x[u][j],
+                    m_multi_x[u-1][j]);
 #ifdef DG_BENCHMARK
             t.toc();
 #ifdef MPI_VERSION
@@ -226,16 +605,15 @@ struct MultigridCG2d
 #endif //MPI
             std::cout << "# Nested iterations stage: " << u << ", iter: " << number[u] << ", took "<<t.diff()<<"s\n";
 #endif //DG_BENCHMARK
-
         }
 #ifdef DG_BENCHMARK
         t.tic();
 #endif //DG_BENCHMARK
-
         //update initial guess
-        dg::blas1::axpby( 1., m_x[0], 1., x);
-        number[0] = m_cg[0]( op[0], x, m_b[0], op[0].precond(),
-            op[0].inv_weights(), eps[0]);
+        for( unsigned j=0; j<k; j++)
+            dg::blas1::axpby( 1., m_multi_x[0][j], 1., x[j]);
+        number[0] = m_multi_cg[0]( op[0], x, m_multi_b[0], op[0].precond(),
+            op[0].inv_weights(), eps[0], 1);
 #ifdef DG_BENCHMARK
         t.toc();
 #ifdef MPI_VERSION
@@ -245,16 +623,83 @@ struct MultigridCG2d
 #endif //MPI
         std::cout << "# Nested iterations stage: " << 0 << ", iter: " << number[0] << ", took "<<t.diff()<<"s\n";
 #endif //DG_BENCHMARK
-
         return number;
     }
 
+    /**
+     * @brief Mixed precision nested iterations with iterative refinement
+     *
+     * This object and the operators \c op_low are constructed in a low
+     * precision (e.g. \c float with \c dg::fDVec and \c dg::fDMatrix) while
+     * \c op, \c x and \c b have a higher precision (e.g. \c double).
+     * All multigrid stages run in the low precision, which halves the
+     * memory traffic. An outer defect correction loop in the high precision
+     * restores the full accuracy:
+     * -# Compute the residual \f$ r = W b - A x\f$ with \c op.
+     * -# Solve \f$ A e = r\f$ with \c direct_solve in low precision to relative accuracy \c eps_low.
+     * -# Update \f$ x \leftarrow x + e\f$ and repeat until \f$ ||r|| < \epsilon( ||Wb|| + 1)\f$.
+     *
+     * @note The preconditioner for the CG solver is taken from the \c precond() method in the \c SymmetricOp class
+     * @copydoc hide_symmetric_op
+     * @tparam SymmetricOpLow The low precision equivalent of \c SymmetricOp
+     * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
+     * (the value types may differ)
+     * @param op The operator on the original grid in high precision
+     * @param op_low Index 0 is the operator on the original grid in low precision, 1 on the half grid, 2 on the quarter grid, ...
+     * @param x (read/write) contains initial guess on input and the solution on output
+     * @param b The right hand side (will be multiplied by \c weights)
+     * @param eps the accuracy: iteration stops if \f$ ||Wb - Ax|| < \epsilon(
+     * ||Wb|| + 1) \f$ (the norm is computed with \c op.inv_weights()); can be
+     * smaller than the precision of \c value_type
+     * @param eps_low the relative accuracy of each low precision solve; must be
+     * larger than the precision of \c value_type (\c 1e-3 is a good choice for \c float)
+     * @param max_refine maximum number of refinement steps
+     * @return the accumulated number of iterations in each of the stages
+     * beginning with the finest grid; if the accuracy is not reached after \c
+     * max_refine steps the first element is \c max_iter() (to indicate failure)
+     * @note Allocates two vectors of type \c ContainerType0 for the high precision residual
+    */
+	template<class SymmetricOp, class SymmetricOpLow, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> direct_solve_with_refinement( SymmetricOp& op,
+        std::vector<SymmetricOpLow>& op_low, ContainerType0&  x, const ContainerType1& b,
+        get_value_type<ContainerType0> eps, value_type eps_low, unsigned max_refine = 10)
+    {
+        ContainerType0 wb(x), r(x);
+        dg::blas2::symv( op.weights(), b, wb);
+        const get_value_type<ContainerType0> nrmb = sqrt( dg::blas2::dot(
+            op.inv_weights(), wb));
+        std::vector<value_type> v_eps( m_stages, eps_low);
+        std::vector<unsigned> number( m_stages, 0);
+        for( unsigned k=0; ; k++)
+        {
+            // compute residual r = Wb - A x in high precision
+            dg::blas2::symv( op, x, r);
+            dg::blas1::axpby( 1., wb, -1., r);
+            if( sqrt( dg::blas2::dot( op.inv_weights(), r)) < eps*(nrmb+1))
+                return number;
+            if( k == max_refine)
+            {
+                number[0] = max_iter();
+                return number;
+            }
+            // solve for the correction in low precision (r already contains
+            // the weights); the accuracy must be relative since r becomes small
+            dg::blas1::copy( r, m_b[0]);
+            dg::blas1::scal( m_p, 0.);
+            std::vector<unsigned> inner = nested_iterations( op_low, m_p, v_eps, 0.);
+            for( unsigned u=0; u<m_stages; u++)
+                number[u] += inner[u];
+            dg::blas1::axpby( 1., m_p, 1., x);
+        }
+    }
+
     /**
      * @brief EXPERIMENTAL Nested iterations with Chebyshev as preconditioner for CG
      *
      * @note This function does the same as direct_solve but uses a
      * ChebyshevPreconditioner (with EVE to estimate the largest EV) at the coarse
      * grid levels (but not the fine level).
+     * The Eigenvalue estimates are reused across calls (see \c set_eigenvalue_refresh)
      * @copydetails direct_solve()
      * @param num_cheby Number of chebyshev iterations. If needed can be set
      * for each stage separately. Per default it is the same for all stages.
@@ -295,18 +740,7 @@ struct MultigridCG2d
 #ifdef DG_BENCHMARK
             t.tic();
 #endif //DG_BENCHMARK
-        unsigned lowest = u;
-        dg::EVE<Container> eve( m_x[lowest]);
-        double evu_max;
-        Container tmp = m_x[lowest];
-        dg::blas1::scal( tmp, 0.);
-        //unsigned counter = eve( op[lowest], tmp, m_r[lowest], op[u].precond(), evu_max, 1e-10);
-        unsigned counter = eve( op[lowest], tmp, m_r[lowest], evu_max, 1e-10);
-        counter++;
-        //std::cout << "# MAX EV is "<<evu_max<<" in "<<counter<<" iterations\t";
-        //    t.toc();
-        //    std::cout << " took "<<t.diff()<<"s\n";
-        //    t.tic();
+            value_type evu_max = max_eigenvalue( op[u], u, m_r[u]);
 
             //double evu_min;
             //dg::detail::WrapperSpectralShift<SymmetricOp, Container> shift(
@@ -373,12 +807,13 @@ struct MultigridCG2d
      * - If error larger than tolerance, do a full multigrid cycle with Chebeyshev iterations as smoother
      * - repeat
      * @note The preconditioner for the CG solver is taken from the \c precond() method in the \c SymmetricOp class
+     * @note The largest Eigenvalue at each stage is estimated with \c dg::EVE
+     * and reused across calls (see \c set_eigenvalue_refresh)
      * @copydoc hide_symmetric_op
      * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
      * @param op Index 0 is the \c SymmetricOp on the original grid, 1 on the half grid, 2 on the quarter grid, ...
      * @param x (read/write) contains initial guess on input and the solution on output
      * @param b The right hand side (will be multiplied by \c weights)
-     * @param ev The estimate of the largest Eivenvalue for each stage
      * @param nu_pre number of pre-smoothing steps (make it >10)
      * @param nu_post number of post-smoothing steps (make it >10)
      * @param gamma The shape of the multigrid ( 1 is usually ok)
@@ -390,6 +825,18 @@ struct MultigridCG2d
     */
 	template<class SymmetricOp, class ContainerType0, class ContainerType1>
     void fmg_solve( std::vector<SymmetricOp>& op,
+    ContainerType0& x, const ContainerType1& b, unsigned nu_pre, unsigned
+    nu_post, unsigned gamma, value_type eps)
+    {
+        fmg_solve( op, x, b, max_eigenvalues( op, b), nu_pre, nu_post, gamma, eps);
+    }
+    /**
+     * @brief EXPERIMENTAL Full multigrid cycles with given Eigenvalue estimates
+     * @copydetails fmg_solve(std::vector<SymmetricOp>&,ContainerType0&,const ContainerType1&,unsigned,unsigned,unsigned,value_type)
+     * @param ev The estimate of the largest Eivenvalue for each stage
+     */
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    void fmg_solve( std::vector<SymmetricOp>& op,
     ContainerType0& x, const ContainerType1& b, std::vector<value_type> ev, unsigned nu_pre, unsigned
     nu_post, unsigned gamma, value_type eps)
     {
@@ -433,12 +880,13 @@ struct MultigridCG2d
     /**
      * @brief EXPERIMENTAL A conjugate gradient with a full multigrid cycle as preconditioner (use at own risk)
      *
+     * @note The largest Eigenvalue at each stage is estimated with \c dg::EVE
+     * and reused across calls (see \c set_eigenvalue_refresh)
      * @copydoc hide_symmetric_op
      * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
      * @param op Index 0 is the \c SymmetricOp on the original grid, 1 on the half grid, 2 on the quarter grid, ...
      * @param x (read/write) contains initial guess on input and the solution on output
      * @param b The right hand side (will be multiplied by \c weights)
-     * @param ev The estimate of the largest Eivenvalue for each stage
      * @param nu_pre number of pre-smoothing steps (make it >10)
      * @param nu_post number of post-smoothing steps (make it >10)
      * @param gamma The shape of the multigrid ( 1 is usually ok)
@@ -450,6 +898,18 @@ struct MultigridCG2d
     */
 	template<class SymmetricOp, class ContainerType0, class ContainerType1>
     void pcg_solve( std::vector<SymmetricOp>& op,
+    ContainerType0& x, const ContainerType1& b, unsigned nu_pre, unsigned
+    nu_post, unsigned gamma, value_type eps)
+    {
+        pcg_solve( op, x, b, max_eigenvalues( op, b), nu_pre, nu_post, gamma, eps);
+    }
+    /**
+     * @brief EXPERIMENTAL A conjugate gradient with a full multigrid cycle as preconditioner with given Eigenvalue estimates
+     * @copydetails pcg_solve(std::vector<SymmetricOp>&,ContainerType0&,const ContainerType1&,unsigned,unsigned,unsigned,value_type)
+     * @param ev The estimate of the largest Eivenvalue for each stage
+     */
+	template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    void pcg_solve( std::vector<SymmetricOp>& op,
     ContainerType0& x, const ContainerType1& b, std::vector<value_type> ev, unsigned nu_pre, unsigned
     nu_post, unsigned gamma, value_type eps)
     {
@@ -499,6 +959,107 @@ struct MultigridCG2d
 
     }
   private:
+    // largest Eigenvalue at stage u, reuses the cached estimate if the
+    // Rayleigh quotient of the probe vector did not drift
+    template<class SymmetricOp>
+    value_type max_eigenvalue( SymmetricOp& op, unsigned u, const Container& rhs)
+    {
+        if( m_ev_calls[u] > 0 && m_ev_calls[u] < m_ev_every)
+        {
+            m_ev_calls[u]++;
+            dg::blas2::symv( op, m_ev_probe[u], m_ev_ap[u]);
+            value_type rq = dg::blas1::dot( m_ev_probe[u], m_ev_ap[u]);
+            if( fabs( rq - m_ev_rq[u]) <= m_ev_drift*fabs( m_ev_rq[u]))
+                return m_ev[u];
+        }
+        if( m_ev_calls[u] == 0) //allocate only if needed
+            m_ev_probe[u] = m_ev_ap[u] = m_x[u];
+        dg::EVE<Container> eve( m_x[u]);
+        dg::blas1::copy( 0., m_ev_ap[u]);
+        eve( op, m_ev_ap[u], rhs, m_ev[u], 1e-10);
+        // a few power iterations make the probe sensitive to the upper spectrum
+        dg::blas1::copy( rhs, m_ev_probe[u]);
+        for( unsigned k=0; k<4; k++)
+        {
+            dg::blas2::symv( op, m_ev_probe[u], m_ev_ap[u]);
+            value_type nrm = sqrt( dg::blas1::dot( m_ev_ap[u], m_ev_ap[u]));
+            if( nrm == 0)
+                break;
+            dg::blas1::axpby( 1./nrm, m_ev_ap[u], 0., m_ev_probe[u]);
+        }
+        dg::blas2::symv( op, m_ev_probe[u], m_ev_ap[u]);
+        m_ev_rq[u] = dg::blas1::dot( m_ev_probe[u], m_ev_ap[u]);
+        m_ev_calls[u] = 1;
+        return m_ev[u];
+    }
+    // largest Eigenvalues at all stages with the (weighted) projected rhs
+    template<class SymmetricOp, class ContainerType1>
+    std::vector<value_type> max_eigenvalues( std::vector<SymmetricOp>& op, const ContainerType1& b)
+    {
+        dg::blas2::symv( op[0].weights(), b, m_r[0]);
+        for( unsigned u=0; u<m_stages-1; u++)
+            dg::blas2::gemv( m_interT[u], m_r[u], m_r[u+1]);
+        std::vector<value_type> ev( m_stages);
+        for( unsigned u=0; u<m_stages; u++)
+            ev[u] = max_eigenvalue( op[u], u, m_r[u]);
+        return ev;
+    }
+    // nested iterations for op[0] x = m_b[0] (m_b[0] is already multiplied by the weights)
+	template<class SymmetricOp, class ContainerType0>
+    std::vector<unsigned> nested_iterations( std::vector<SymmetricOp>& op, ContainerType0&  x, const std::vector<value_type>& eps, value_type nrmb_correction = 1.)
+    {
+        // compute residual r = Wb - A x
+        dg::blas2::symv(op[0], x, m_r[0]);
+        dg::blas1::axpby(-1.0, m_r[0], 1.0, m_b[0], m_r[0]);
+        // project residual down to coarse grid
+        for( unsigned u=0; u<m_stages-1; u++)
+            dg::blas2::gemv( m_interT[u], m_r[u], m_r[u+1]);
+        std::vector<unsigned> number(m_stages);
+#ifdef DG_BENCHMARK
+        Timer t;
+#endif //DG_BENCHMARK
+
+        dg::blas1::scal( m_x[m_stages-1], 0.0);
+        //now solve residual equations
+		for( unsigned u=m_stages-1; u>0; u--)
+        {
+#ifdef DG_BENCHMARK
+            t.tic();
+#endif //DG_BENCHMARK
+            number[u] = m_cg[u]( op[u], m_x[u], m_r[u], op[u].precond(),
+                op[u].inv_weights(), eps[u], nrmb_correction, 10);
+            dg::blas2::symv( m_inter[u-1], m_x[u], m_x[u-1]);
+#ifdef DG_BENCHMARK
+            t.toc();
+#ifdef MPI_VERSION
+            int rank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            if(rank==0)
+#endif //MPI
+            std::cout << "# Nested iterations stage: " << u << ", iter: " << number[u] << ", took "<<t.diff()<<"s\n";
+#endif //DG_BENCHMARK
+
+        }
+#ifdef DG_BENCHMARK
+        t.tic();
+#endif //DG_BENCHMARK
+
+        //update initial guess
+        dg::blas1::axpby( 1., m_x[0], 1., x);
+        number[0] = m_cg[0]( op[0], x, m_b[0], op[0].precond(),
+            op[0].inv_weights(), eps[0], nrmb_correction);
+#ifdef DG_BENCHMARK
+        t.toc();
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if(rank==0)
+#endif //MPI
+        std::cout << "# Nested iterations stage: " << 0 << ", iter: " << number[0] << ", took "<<t.diff()<<"s\n";
+#endif //DG_BENCHMARK
+
+        return number;
+    }
     template<class SymmetricOp>
     void multigrid_cycle( std::vector<SymmetricOp>& op,
     std::vector<Container>& x, std::vector<Container>& b,
@@ -623,12 +1184,19 @@ struct MultigridCG2d
     }
     unsigned m_stages;
     std::vector< dg::ClonePtr< Geometry> > m_grids;
-    std::vector< MultiMatrix<Matrix, Container> >  m_inter;
-    std::vector< MultiMatrix<Matrix, Container> >  m_interT;
-    std::vector< MultiMatrix<Matrix, Container> >  m_project;
-    std::vector< CG<Container> > m_cg;
+    std::vector< detail::MultigridTransfer<Matrix, Container> >  m_inter;
+    std::vector< detail::MultigridTransfer<Matrix, Container> >  m_interT;
+    std::vector< detail::MultigridTransfer<Matrix, Container> >  m_project;
+    std::vector< Solver > m_cg;
+    std::vector< MultiCG<Container> > m_multi_cg;
     std::vector< ChebyshevIteration<Container>> m_cheby;
     std::vector< Container> m_x, m_r, m_b;
+    std::vector< value_type> m_ev, m_ev_rq;
+    std::vector< unsigned> m_ev_calls;
+    std::vector< Container> m_ev_probe, m_ev_ap;
+    unsigned m_ev_every = 10;
+    value_type m_ev_drift = 0.05;
+    std::vector< std::vector<Container>> m_multi_x, m_multi_r, m_multi_b;
     Container  m_p, m_cgr;
 
 };
@@ -110,7 +110,74 @@ int main()
     std::cout << " Error of nested iterations "<<err<<"\n";
     std::cout << "Took "<<t.diff()<<"s\n\n";
     ////////////////////////////////////////////////////
+    {
+    std::cout << "MIXED PRECISION NESTED ITERATIONS SOLVE:\n";
+    dg::RealCartesianGrid2d<float> gridf( 0, lx, 0, ly, n, Nx, Ny, bcx, bcy);
+    dg::MultigridCG2d<dg::aRealGeometry2d<float>, dg::fDMatrix, dg::fDVec >
+        multigridf( gridf, stages);
+    dg::fDVec chif;
+    dg::assign( chi, chif);
+    const std::vector<dg::fDVec> multi_chif = multigridf.project( chif);
+    std::vector<dg::Elliptic<dg::aRealGeometry2d<float>, dg::fDMatrix, dg::fDVec> > multi_polf( stages);
+    for(unsigned u=0; u<stages; u++)
+    {
+        multi_polf[u].construct( multigridf.grid(u), dg::not_normed,
+            dg::centered, jfactor);
+        multi_polf[u].set_chi( multi_chif[u]);
+    }
+    x = dg::evaluate( initial, grid);
+    t.tic();
+    std::vector<unsigned> number = multigridf.direct_solve_with_refinement(
+        multi_pol[0], multi_polf, x, b, eps, 1e-3);
+    t.toc();
+    std::cout << " Accumulated iterations on the finest grid "<<number[0]<<"\n";
+    double norm = dg::blas2::dot( w2d, solution);
+    dg::DVec error( solution);
+    dg::blas1::axpby( 1.,x,-1., solution, error);
+    double err = dg::blas2::dot( w2d, error);
+    err = sqrt( err/norm);
+    std::cout << " Error of mixed precision iterations "<<err<<"\n";
+    std::cout << "Took "<<t.diff()<<"s\n\n";
+    }
+    ////////////////////////////////////////////////////
+    {
+    std::cout << "MULTIGRID NESTED ITERATIONS SOLVE FOR FOUR RIGHT HAND SIDES:\n";
+    //the first round allocates the workspace of direct_solve_multi
+    const unsigned k = 4;
+    std::vector<dg::DVec> xs( k), bs( k, b);
+    for( unsigned j=0; j<k; j++)
+        dg::blas1::scal( bs[j], j+1.);
+    for( unsigned i=0; i<2; i++)
+    {
+        for( unsigned j=0; j<k; j++)
+            xs[j] = dg::evaluate( initial, grid);
+        t.tic();
+        for( unsigned j=0; j<k; j++)
+            multigrid.direct_solve(multi_pol, xs[j], bs[j], eps);
+        t.toc();
+        std::cout << " One after the other took "<<t.diff()<<"s\n";
+        for( unsigned j=0; j<k; j++)
+            xs[j] = dg::evaluate( initial, grid);
+        t.tic();
+        std::vector<unsigned> number = multigrid.direct_solve_multi(multi_pol, xs, bs, eps);
+        t.toc();
+        std::cout << " Together took "<<t.diff()<<"s with "<<number[0]<<" iterations on the finest grid\n";
+    }
+    for( unsigned j=0; j<k; j++)
+    {
+        dg::DVec error( solution);
+        dg::blas1::axpby( 1.,xs[j],-(j+1.), solution, error);
+        double err = dg::blas2::dot( w2d, error);
+        err = sqrt( err/norm)/(j+1.);
+        std::cout << " Error of nested iterations "<<err<<"\n";
+    }
+    std::cout << "\n";
+    }
+    ////////////////////////////////////////////////////
     std::cout << "MULTIGRID NESTED ITERATIONS WITH CHEBYSHEV SOLVE:\n";
+    //the second and third solve reuse the Eigenvalue estimates
+    for( unsigned i=0; i<3; i++)
+    {
     x = dg::evaluate( initial, grid);
     t.tic();
     multigrid.direct_solve_with_chebyshev(multi_pol, x, b, eps, nu1);
@@ -121,7 +188,12 @@ int main()
     err = dg::blas2::dot( w2d, error);
     err = sqrt( err/norm);
     std::cout << " Error of nested iterations "<<err<<"\n";
-    std::cout << "Took "<<t.diff()<<"s\n\n";
+    std::cout << "Took "<<t.diff()<<"s\n";
+    }
+    std::cout << " Cached Eigenvalue estimates";
+    for( unsigned u=1; u<stages; u++)
+        std::cout << " "<<multigrid.eigenvalues()[u];
+    std::cout << "\n\n";
     {
         std::cout << "MULTIGRID PCG SOLVE:\n";
         x = dg::evaluate( initial, grid);
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <iomanip>
+#include <mpi.h>
+
+#include "elliptic.h"
+#include "multigrid.h"
+
+#include "backend/mpi_init.h"
+
+const double lx = M_PI;
+const double ly = 2.*M_PI;
+dg::bc bcx = dg::DIR;
+dg::bc bcy = dg::PER;
+
+double amp = 0.9;
+double pol( double x, double y) {return 1. + amp*sin(x)*sin(y); }
+double rhs( double x, double y) { return 2.*sin(x)*sin(y)*(amp*sin(x)*sin(y)+1)-amp*sin(x)*sin(x)*cos(y)*cos(y)-amp*cos(x)*cos(x)*sin(y)*sin(y);}
+double sol(double x, double y)  { return sin( x)*sin(y);}
+
+int main(int argc, char* argv[] )
+{
+    MPI_Init( &argc, &argv);
+    MPI_Comm comm;
+    dg::mpi_init2d( bcx, bcy, comm);
+    int rank, dims[2], periods[2], coords[2];
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    MPI_Cart_get( comm, 2, dims, periods, coords);
+    //the coarsest stage has 2 cells per process and must be agglomerated
+    const unsigned n = 3, Nx = 16*dims[0], Ny = 16*dims[1], stages = 4;
+    if(rank==0)std::cout << "Test multigrid with agglomerated coarse stages\n";
+    if(rank==0)std::cout << "Computing on "<<n<<" x "<<Nx<<" x "<<Ny<<" with "<<stages<<" stages\n";
+    dg::CartesianMPIGrid2d grid( 0., lx, 0, ly, n, Nx, Ny, bcx, bcy, comm);
+    const dg::MDVec w2d = dg::create::weights( grid);
+    dg::MDVec x = dg::evaluate( dg::zero, grid);
+    dg::MDVec b = dg::evaluate( rhs, grid);
+    dg::MDVec chi = dg::evaluate( pol, grid);
+
+    dg::MultigridCG2d<dg::aMPIGeometry2d, dg::MDMatrix, dg::MDVec > multigrid( grid, stages);
+    bool agglomerated = false;
+    for(unsigned u=0; u<stages; u++)
+    {
+        int d[2], p[2], c[2];
+        MPI_Cart_get( multigrid.grid(u).communicator(), 2, d, p, c);
+        if( d[0] != dims[0] || d[1] != dims[1])
+            agglomerated = true;
+        if(rank==0)std::cout << "Stage "<<u<<" local grid "<<multigrid.grid(u).local().Nx()
+            <<" x "<<multigrid.grid(u).local().Ny()<<" on "<<d[0]<<" x "<<d[1]<<" processes\n";
+    }
+    if(rank==0 && !agglomerated)
+        std::cout << "No stage is agglomerated! (Use more than one process in x or y)\n";
+    std::vector<dg::MDVec> chi_ = multigrid.project( chi);
+    std::vector<dg::Elliptic<dg::aMPIGeometry2d, dg::MDMatrix, dg::MDVec> > multi_pol( stages);
+    for(unsigned u=0; u<stages; u++)
+    {
+        multi_pol[u].construct( multigrid.grid(u), dg::not_normed, dg::centered);
+        multi_pol[u].set_chi( chi_[u]);
+    }
+    const double eps = 1e-8;
+    std::vector<unsigned> number = multigrid.direct_solve( multi_pol, x, b, eps);
+    for( unsigned u=0; u<number.size(); u++)
+        if(rank==0)std::cout << " # iterations stage "<< number.size()-1-u << " " << number[number.size()-1-u] << " \n";
+
+    //the projection onto an agglomerated stage must be the same on every process group
+    const dg::MDVec w2d_coarse = dg::create::weights( multigrid.grid(stages-1));
+    double integral = dg::blas1::dot( chi_[stages-1], w2d_coarse);
+    double integral_fine = dg::blas1::dot( chi, w2d);
+    double min_integral, max_integral;
+    MPI_Allreduce( &integral, &min_integral, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce( &integral, &max_integral, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    if(rank==0)std::cout << "Integral of chi on coarsest stage "<<integral
+        <<" (fine "<<integral_fine<<")\n";
+
+    const dg::MDVec solution = dg::evaluate( sol, grid);
+    dg::MDVec error( solution);
+    dg::blas1::axpby( 1.,x,-1., error);
+    double err = dg::blas2::dot( w2d, error);
+    double norm = dg::blas2::dot( w2d, solution);
+    if(rank==0)std::cout << "L2 Norm of relative error is "<<sqrt( err/norm)<<std::endl;
+    bool passed = sqrt( err/norm) < 1e-4 && min_integral == max_integral
+        && fabs( integral - integral_fine) < 1e-10*fabs( integral_fine);
+
+    if(rank==0)std::cout << "Test multigrid with the Chebyshev solver at each stage\n";
+    dg::MultigridCG2d<dg::aMPIGeometry2d, dg::MDMatrix, dg::MDVec,
+        dg::ChebyshevSolver<dg::MDVec>> multicheby( grid, stages);
+    //the first solve is CG and estimates the bounds, the second uses Chebyshev
+    for( unsigned k=0; k<2; k++)
+    {
+        dg::blas1::copy( 0., x);
+        number = multicheby.direct_solve( multi_pol, x, b, eps);
+        for( unsigned u=0; u<number.size(); u++)
+        {
+            unsigned v = number.size()-1-u;
+            unsigned num_cheby = multicheby.solver(v).get_chebyshev_iterations();
+            if(rank==0)std::cout << " # iterations stage "<< v << " " << number[v]
+                << " (Chebyshev "<<num_cheby<<")\n";
+            if( number[v] >= multicheby.solver(v).get_max())
+                passed = false;
+            if( k == 1 && v > 0 && num_cheby == 0)
+                passed = false;
+        }
+        dg::blas1::axpby( 1.,x,-1., solution, error);
+        err = dg::blas2::dot( w2d, error);
+        if(rank==0)std::cout << "L2 Norm of relative error is "<<sqrt( err/norm)<<std::endl;
+        passed = passed && sqrt( err/norm) < 1e-4;
+    }
+    if(rank==0)std::cout << (passed ? "PASSED\n" : "FAILED\n");
+
+    MPI_Finalize();
+    return passed ? 0 : 1;
+}
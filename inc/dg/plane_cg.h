@@ -0,0 +1,305 @@
+#pragma once
+
+#include <vector>
+
+#include "blas.h"
+#include "cg.h"
+#include "topology/split_and_join.h"
+
+/*!@file
+ * Conjugate gradient for independent planes of a 3d vector
+ */
+
+namespace dg{
+
+///@cond
+namespace detail{
+//The type of a view on a plane of a 3d vector
+template<class ContainerType, class Category = get_tensor_category<ContainerType>>
+struct PlaneView
+{
+    using type = View<ContainerType>;
+};
+#ifdef MPI_VERSION
+template<class ContainerType>
+struct PlaneView<ContainerType, MPIVectorTag>
+{
+    using type = get_mpi_view_type<ContainerType>;
+};
+#endif //MPI_VERSION
+
+//Point existing views (of equal size) to consecutive chunks of in
+//(keeps the communicators of MPI views)
+template<class ContainerType, class ViewType>
+void point_planes( ContainerType& in, std::vector<ViewType>& out, SharedVectorTag)
+{
+    unsigned size2d = out[0].size();
+    for( unsigned i=0; i<out.size(); i++)
+        out[i].construct( thrust::raw_pointer_cast( in.data()) + i*size2d, size2d);
+}
+//A single view of the whole vector
+template<class ContainerType>
+View<ContainerType> whole_view( ContainerType& in, SharedVectorTag)
+{
+    return View<ContainerType>( thrust::raw_pointer_cast( in.data()), in.size());
+}
+#ifdef MPI_VERSION
+template<class ContainerType, class ViewType>
+void point_planes( ContainerType& in, std::vector<ViewType>& out, MPIVectorTag)
+{
+    unsigned size2d = out[0].data().size();
+    for( unsigned i=0; i<out.size(); i++)
+        out[i].data().construct( thrust::raw_pointer_cast( in.data().data())
+            + i*size2d, size2d);
+}
+template<class ContainerType>
+get_mpi_view_type<ContainerType> whole_view( ContainerType& in, MPIVectorTag)
+{
+    get_mpi_view_type<ContainerType> out;
+    out.data().construct( thrust::raw_pointer_cast( in.data().data()),
+        in.data().size());
+    out.set_communicator( in.communicator(), in.communicator_mod(),
+        in.communicator_mod_reduce());
+    return out;
+}
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
+/**
+* @brief Preconditioned conjugate gradient method to solve
+* \f[ M^{-1}Ax=M^{-1}b\f] for a matrix that does not couple the planes of a 3d vector
+*
+* @ingroup invert
+*
+* If the matrix \f$ A\f$ is block diagonal in the third dimension, as e.g.
+* \c dg::Elliptic3d or \c dg::Helmholtz3d with \c set_compute_in_2d(true),
+* then each plane of the 3d vector is an independent 2d system. \c dg::CG
+* treats them as one system with a single global residual, such that all
+* planes iterate until the slowest plane has converged. This class runs one
+* CG iteration for each plane in lockstep instead: every plane has its own
+* \f$ \alpha\f$, \f$ \beta\f$ and residual, the scalar products of all planes
+* are computed with a single reduction per iteration and a plane that has
+* converged drops out of the vector updates and is no longer changed.
+* The stopping criterion is the one of \c dg::CG applied to each plane.
+* Compared to \c dg::CG on the whole vector with the same \c eps and \c
+* nrmb_correction the criterion is thus looser: the absolute part \f$ \epsilon C\f$
+* holds for each of the \f$ N_z\f$ planes, so that the residual of the whole vector can grow by about \f$ \sqrt{N_z}\f$.
+* @note The matrix and the preconditioner are still applied to the whole
+* vector in each iteration
+* @note With \c set_compute_in_2d(false) the whole vector is treated as a
+* single system and the iterates are the same as the ones of \c dg::CG.
+* Use this if the matrix couples the planes
+* @note With MPI the scalar products are reduced within the process planes
+* only. Processes with different z coordinates therefore iterate
+* independently and the returned number of iterations refers to the local
+* planes. The matrix may thus only communicate within planes (which is the case for \c set_compute_in_2d(true)).
+* @note Use it as a drop-in replacement for \c dg::CG in \c dg::MultigridCG2d
+* @attention beware the sign: a negative definite matrix does @b not work in Conjugate gradient
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class PlaneCG
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    PlaneCG(){}
+    ///@copydoc construct()
+    template<class Topology3d>
+    PlaneCG( const Topology3d& g, const ContainerType& copyable, unsigned max_iterations){
+        construct( g, copyable, max_iterations);
+    }
+    ///@copydoc CG::set_max()
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@copydoc CG::get_max()
+    unsigned get_max() const {return m_max_iter;}
+    ///@copydoc CG::copyable()
+    const ContainerType& copyable()const{ return m_r;}
+
+    /**
+     * @brief Allocate memory for the pcg method
+     *
+     * @param g the 3d grid that determines the planes (in MPI the plane communicators are taken from here)
+     * @param copyable A ContainerType must be copy-constructible from this (must have size \c g.size())
+     * @param max_iterations Maximum number of iterations to be used
+     * @tparam Topology3d a 3d topology that can be used in \c dg::split
+     */
+    template<class Topology3d>
+    void construct( const Topology3d& g, const ContainerType& copyable, unsigned max_iterations) {
+        m_ap = m_p = m_r = copyable;
+        m_planes = dg::split( m_r, g);
+        m_whole.assign( 1, detail::whole_view( m_r, get_tensor_category<ContainerType>()));
+        m_max_iter = max_iterations;
+    }
+    /**
+     * @brief Solve the planes independently (the default)
+     *
+     * @param compute_in_2d if true, each plane is an independent system, false
+     * treats the whole vector as one system (like \c dg::CG)
+     */
+    void set_compute_in_2d( bool compute_in_2d) {
+        m_compute_in_2d = compute_in_2d;
+    }
+
+    /**
+     * @brief Solve the system A*x = b using a preconditioned conjugate gradient method
+     *
+     * The iteration stops in each plane if \f$ ||b - Ax||_P < \epsilon( ||b||_P + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$
+     * @param A A symmetric, positive definit matrix that does not couple the planes
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used (must be a \c ContainerType)
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @return Maximum number of iterations over all planes
+     * @copydoc hide_matrix
+     */
+    template< class MatrixType>
+    unsigned operator()( MatrixType& A, ContainerType& x, const ContainerType& b, const ContainerType& P , value_type eps = 1e-12, value_type nrmb_correction = 1){
+        return this->operator()( A, x, b, P, P, eps, nrmb_correction, 1);
+    }
+    /**
+     * @brief Solve \f$ Ax = b\f$ using a preconditioned conjugate gradient method
+     *
+     * The iteration stops in each plane if \f$ ||Ax||_S < \epsilon( ||b||_S + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$ and \f$ S \f$ defines a square norm
+     * @param A A symmetric positive definit matrix that does not couple the planes
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @param test_frequency if set to 1 then the norm of the error is computed in every iteration to test if the loop can be terminated. The norm is part of the single reduction per iteration, so a value larger than 1 only saves the local computation.
+     *
+     * @return Maximum number of iterations over all planes
+     * @note Required memops per iteration and plane are the same as for \c dg::CG
+     * @copydoc hide_matrix
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     */
+    template< class MatrixType, class Preconditioner >
+    unsigned operator()( MatrixType& A, ContainerType& x, const ContainerType& b, Preconditioner& P, const ContainerType& S, value_type eps = 1e-12, value_type nrmb_correction = 1, int test_frequency = 1);
+  private:
+    using view_type = typename detail::PlaneView<ContainerType>::type;
+    using const_view_type = typename detail::PlaneView<const ContainerType>::type;
+    ContainerType m_r, m_p, m_ap;
+    std::vector<view_type> m_planes, m_whole;
+    std::vector<view_type> m_rv, m_pv, m_apv, m_xv;
+    std::vector<const_view_type> m_bv, m_sv;
+    detail::MultiDots<view_type> m_dots;
+    unsigned m_max_iter;
+    bool m_compute_in_2d = true;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class Preconditioner>
+unsigned PlaneCG< ContainerType>::operator()( Matrix& A, ContainerType& x, const ContainerType& b, Preconditioner& P, const ContainerType& S, value_type eps, value_type nrmb_correction, int test_frequency )
+{
+    // (re-)point the views, they carry the plane communicators in MPI
+    const std::vector<view_type>& planes = m_compute_in_2d ? m_planes : m_whole;
+    m_rv = m_pv = m_apv = m_xv = planes;
+    m_bv = m_sv = std::vector<const_view_type>( planes.begin(), planes.end());
+    get_tensor_category<ContainerType> tag;
+    detail::point_planes( m_r, m_rv, tag);
+    detail::point_planes( m_p, m_pv, tag);
+    detail::point_planes( m_ap, m_apv, tag);
+    detail::point_planes( x, m_xv, tag);
+    detail::point_planes( b, m_bv, tag);
+    detail::point_planes( S, m_sv, tag);
+    unsigned k = planes.size();
+
+    m_dots.clear();
+    for( unsigned j=0; j<k; j++)
+        m_dots.add( m_bv[j], m_sv[j], m_bv[j]);
+    std::vector<value_type> nrmb = m_dots.reduce();
+    // the planes that still iterate
+    std::vector<unsigned> active;
+    for( unsigned j=0; j<k; j++)
+    {
+        nrmb[j] = sqrt( nrmb[j]);
+        if( nrmb[j] == 0)
+            blas1::copy( m_bv[j], m_xv[j]);
+        else
+            active.push_back(j);
+    }
+    if( active.empty())
+        return 0;
+    blas2::symv( A, x, m_r);
+    blas1::axpby( 1., b, -1., m_r);
+    m_dots.clear();
+    for( auto j : active)
+        m_dots.add( m_rv[j], m_sv[j], m_rv[j]);
+    std::vector<value_type> dots = m_dots.reduce();
+    std::vector<unsigned> next;
+    for( unsigned l=0; l<active.size(); l++)
+        //if x happens to be the solution
+        if( !(sqrt( dots[l]) < eps*(nrmb[active[l]] + nrmb_correction)))
+            next.push_back( active[l]);
+    active.swap( next);
+    if( active.empty())
+        return 0;
+    blas2::symv( P, m_r, m_p);//<-- compute p_0
+    m_dots.clear();
+    for( auto j : active)
+        m_dots.add( m_pv[j], m_rv[j]);
+    std::vector<value_type> nrmzr_old( k);
+    dots = m_dots.reduce();
+    for( unsigned l=0; l<active.size(); l++)
+        nrmzr_old[active[l]] = dots[l];
+    for( unsigned i=1; i<m_max_iter; i++)
+    {
+        blas2::symv( A, m_p, m_ap);
+        m_dots.clear();
+        for( auto j : active)
+            m_dots.add( m_pv[j], m_apv[j]);
+        dots = m_dots.reduce();
+        for( unsigned l=0; l<active.size(); l++)
+        {
+            unsigned j = active[l];
+            value_type alpha = nrmzr_old[j]/dots[l];
+            blas1::axpby( alpha, m_pv[j], 1., m_xv[j]);
+            blas1::axpby( -alpha, m_apv[j], 1., m_rv[j]);
+        }
+        blas2::symv( P, m_r, m_ap);
+        bool test = ( 0 == i%test_frequency);
+        m_dots.clear();
+        for( auto j : active)
+        {
+            m_dots.add( m_apv[j], m_rv[j]);
+            if( test)
+                m_dots.add( m_rv[j], m_sv[j], m_rv[j]);
+        }
+        dots = m_dots.reduce();
+        unsigned stride = test ? 2 : 1;
+        next.clear();
+        for( unsigned l=0; l<active.size(); l++)
+        {
+            unsigned j = active[l];
+            if( test && sqrt( dots[stride*l+1]) < eps*(nrmb[j] + nrmb_correction))
+                continue;
+            value_type nrmzr_new = dots[stride*l];
+            blas1::axpby(1., m_apv[j], nrmzr_new/nrmzr_old[j], m_pv[j] );
+            nrmzr_old[j] = nrmzr_new;
+            next.push_back( j);
+        }
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if(rank==0)
+#endif //MPI
+        std::cout << "# Iteration "<<i<<": "<<next.size()<<" of "<<k<<" planes not yet converged\n";
+#endif //DG_DEBUG
+        active.swap( next);
+        if( active.empty())
+            return i;
+    }
+    return m_max_iter;
+}
+///@endcond
+
+}//namespace dg
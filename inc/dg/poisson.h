@@ -120,9 +120,27 @@ struct Poisson
     }
 
   private:
+    //if lhs and rhs share boundary conditions apply each derivative in a single sweep
+    template<class ContainerType0>
+    void derivatives( const ContainerType0& lhs, const ContainerType0& rhs)
+    {
+        if( !m_same_bc)
+            return derivatives<ContainerType0,ContainerType0>( lhs, rhs);
+        blas2::symv( m_dxlhs, {&lhs, &rhs}, {&m_dxlhslhs, &m_dxrhsrhs});
+        blas2::symv( m_dylhs, {&lhs, &rhs}, {&m_dylhslhs, &m_dyrhsrhs});
+    }
+    template<class ContainerType0, class ContainerType1>
+    void derivatives( const ContainerType0& lhs, const ContainerType1& rhs)
+    {
+        blas2::symv(  m_dxlhs, lhs,  m_dxlhslhs); //dx_lhs lhs
+        blas2::symv(  m_dylhs, lhs,  m_dylhslhs); //dy_lhs lhs
+        blas2::symv(  m_dxrhs, rhs,  m_dxrhsrhs); //dx_rhs rhs
+        blas2::symv(  m_dyrhs, rhs,  m_dyrhsrhs); //dy_rhs rhs
+    }
     Container m_dxlhslhs, m_dxrhsrhs, m_dylhslhs, m_dyrhsrhs, m_helper;
     Matrix m_dxlhs, m_dylhs, m_dxrhs, m_dyrhs;
     Container m_chi, m_perp_vol;
+    bool m_same_bc;
 };
 
 ///@cond
@@ -142,7 +160,8 @@ Poisson<Geometry, Matrix, Container>::Poisson(  const Geometry& g, bc bcxlhs, bc
     m_dxlhs(dg::create::dx( g, bcxlhs, dg::centered)),
     m_dylhs(dg::create::dy( g, bcylhs, dg::centered)),
     m_dxrhs(dg::create::dx( g, bcxrhs, dg::centered)),
-    m_dyrhs(dg::create::dy( g, bcyrhs, dg::centered))
+    m_dyrhs(dg::create::dy( g, bcyrhs, dg::centered)),
+    m_same_bc( bcxlhs == bcxrhs && bcylhs == bcyrhs)
 {
     m_chi = m_perp_vol = dg::tensor::volume2d(g.metric());
     dg::blas1::pointwiseDivide( 1., m_perp_vol, m_chi);
@@ -152,10 +171,7 @@ template< class Geometry, class Matrix, class Container>
 template<class ContainerType0, class ContainerType1, class ContainerType2>
 void Poisson< Geometry, Matrix, Container>::operator()( const ContainerType0& lhs, const ContainerType1& rhs, ContainerType2& result)
 {
-    blas2::symv(  m_dxlhs, lhs,  m_dxlhslhs); //dx_lhs lhs
-    blas2::symv(  m_dylhs, lhs,  m_dylhslhs); //dy_lhs lhs
-    blas2::symv(  m_dxrhs, rhs,  m_dxrhsrhs); //dx_rhs rhs
-    blas2::symv(  m_dyrhs, rhs,  m_dyrhsrhs); //dy_rhs rhs
+    derivatives( lhs, rhs);
 
     blas1::pointwiseDot( 1., m_dxlhslhs, m_dyrhsrhs, -1., m_dylhslhs, m_dxrhsrhs, 0., result);
     blas1::pointwiseDot( m_chi, result, result);
@@ -3,6 +3,9 @@
 
 #include <cassert>
 #include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include "backend/exceptions.h"
 #include "tableau.h"
@@ -32,6 +35,171 @@ namespace dg{
         The two ContainerType arguments never alias each other in calls to the functor.
   */
 
+///@cond
+namespace detail{
+// Stage combinations of arbitrary length are split into blocks of at most
+// rk_max_fused vectors; each block is a single fused blas1 kernel
+constexpr unsigned rk_max_fused = 8;
+
+// prepend the M coefficient-vector pairs (a_0, k_0, ..., a_{M-1}, k_{M-1})
+// to args and call f with the result
+template<unsigned M>
+struct RKPairs
+{
+    template<class Functor, class value_type, class ContainerType, class ...Args>
+    static void call( Functor f, const value_type* a, const ContainerType* k,
+        Args&&... args)
+    {
+        RKPairs<M-1>::call( f, a, k, a[M-1], k[M-1],
+            std::forward<Args>(args)...);
+    }
+};
+template<>
+struct RKPairs<0>
+{
+    template<class Functor, class value_type, class ContainerType, class ...Args>
+    static void call( Functor f, const value_type*, const ContainerType*,
+        Args&&... args)
+    {
+        f( std::forward<Args>(args)...);
+    }
+};
+// same for the triplets (b_0, bt_0, k_0, ..., b_{M-1}, bt_{M-1}, k_{M-1})
+template<unsigned M>
+struct RKTriplets
+{
+    template<class Functor, class value_type, class ContainerType, class ...Args>
+    static void call( Functor f, const value_type* b, const value_type* bt,
+        const ContainerType* k, Args&&... args)
+    {
+        RKTriplets<M-1>::call( f, b, bt, k, b[M-1], bt[M-1], k[M-1],
+            std::forward<Args>(args)...);
+    }
+};
+template<>
+struct RKTriplets<0>
+{
+    template<class Functor, class value_type, class ContainerType, class ...Args>
+    static void call( Functor f, const value_type*, const value_type*,
+        const ContainerType*, Args&&... args)
+    {
+        f( std::forward<Args>(args)...);
+    }
+};
+
+// map the runtime block size 0 < m <= N to a compile time block size
+template<unsigned N>
+struct RKBlockDispatch
+{
+    template<class ContainerType, class value_type>
+    static void pair_sum( unsigned m, ContainerType& y, value_type alpha,
+        const ContainerType& x, const value_type* a, const ContainerType* k)
+    {
+        if( m == N)
+            RKPairs<N>::call( [&]( const auto& ... pairs){
+                blas1::evaluate( y, dg::equals(), PairSum(), alpha, x,
+                    pairs...);
+            }, a, k);
+        else
+            RKBlockDispatch<N-1>::pair_sum( m, y, alpha, x, a, k);
+    }
+    template<class ContainerType, class value_type>
+    static void embedded_pair_sum( unsigned m, ContainerType& y,
+        ContainerType& yt, value_type alpha, value_type alphat,
+        const ContainerType& x, const value_type* b, const value_type* bt,
+        const ContainerType* k)
+    {
+        if( m == N)
+            RKTriplets<N>::call( [&]( const auto& ... triplets){
+                blas1::subroutine( dg::EmbeddedPairSum(), y, yt, alpha,
+                    alphat, x, triplets...);
+            }, b, bt, k);
+        else
+            RKBlockDispatch<N-1>::embedded_pair_sum( m, y, yt, alpha,
+                alphat, x, b, bt, k);
+    }
+    template<class ContainerType, class value_type>
+    static void embedded_pair_sum_add( unsigned m, ContainerType& y,
+        ContainerType& yt, const value_type* b, const value_type* bt,
+        const ContainerType* k)
+    {
+        if( m == N)
+            RKTriplets<N>::call( [&]( const auto& ... triplets){
+                blas1::subroutine( dg::EmbeddedPairSumAdd(), y, yt,
+                    triplets...);
+            }, b, bt, k);
+        else
+            RKBlockDispatch<N-1>::embedded_pair_sum_add( m, y, yt, b, bt, k);
+    }
+};
+template<>
+struct RKBlockDispatch<0>
+{
+    template<class ContainerType, class value_type>
+    static void pair_sum( unsigned m, ContainerType& y, value_type alpha,
+        const ContainerType& x, const value_type* a, const ContainerType* k)
+    {
+        blas1::axpby( alpha, x, 0., y);
+    }
+    template<class ContainerType, class value_type>
+    static void embedded_pair_sum( unsigned m, ContainerType& y,
+        ContainerType& yt, value_type alpha, value_type alphat,
+        const ContainerType& x, const value_type* b, const value_type* bt,
+        const ContainerType* k)
+    {
+        blas1::axpby( alphat, x, 0., yt);
+        blas1::axpby( alpha, x, 0., y);
+    }
+    template<class ContainerType, class value_type>
+    static void embedded_pair_sum_add( unsigned m, ContainerType& y,
+        ContainerType& yt, const value_type* b, const value_type* bt,
+        const ContainerType* k) { }
+};
+
+// y = alpha x + sum_{j<s} a_j k_j in ceil(s/rk_max_fused) fused kernels
+// (y may alias x)
+template<class ContainerType, class value_type>
+void stage_sum( ContainerType& y, value_type alpha, const ContainerType& x,
+    const std::vector<value_type>& a, const std::vector<ContainerType>& k,
+    unsigned s)
+{
+    unsigned m = std::min( s, rk_max_fused);
+    RKBlockDispatch<rk_max_fused>::pair_sum( m, y, alpha, x, a.data(), k.data());
+    for( unsigned j=m; j<s; j+=rk_max_fused)
+    {
+        m = std::min( s-j, rk_max_fused);
+        RKBlockDispatch<rk_max_fused>::pair_sum( m, y, value_type(1), y,
+            a.data()+j, k.data()+j);
+    }
+}
+// y += sum_{first<=j<s} b_j k_j and yt += sum_{first<=j<s} bt_j k_j
+template<class ContainerType, class value_type>
+void embedded_stage_sum_add( ContainerType& y, ContainerType& yt,
+    const std::vector<value_type>& b, const std::vector<value_type>& bt,
+    const std::vector<ContainerType>& k, unsigned first, unsigned s)
+{
+    for( unsigned j=first; j<s; j+=rk_max_fused)
+    {
+        unsigned m = std::min( s-j, rk_max_fused);
+        RKBlockDispatch<rk_max_fused>::embedded_pair_sum_add( m, y, yt,
+            b.data()+j, bt.data()+j, k.data()+j);
+    }
+}
+// y = alpha x + sum_{j<s} b_j k_j and yt = alphat x + sum_{j<s} bt_j k_j
+// in ceil(s/rk_max_fused) fused kernels (y may alias x)
+template<class ContainerType, class value_type>
+void embedded_stage_sum( ContainerType& y, ContainerType& yt,
+    value_type alpha, value_type alphat, const ContainerType& x,
+    const std::vector<value_type>& b, const std::vector<value_type>& bt,
+    const std::vector<ContainerType>& k, unsigned s)
+{
+    unsigned m = std::min( s, rk_max_fused);
+    RKBlockDispatch<rk_max_fused>::embedded_pair_sum( m, y, yt, alpha, alphat,
+        x, b.data(), bt.data(), k.data());
+    embedded_stage_sum_add( y, yt, b, bt, k, m, s);
+}
+}//namespace detail
+///@endcond
 
 /**
 * @brief Embedded Runge Kutta explicit time-step with error estimate
@@ -64,12 +232,15 @@ struct ERKStep
     ERKStep(){
     }
     ///@copydoc RungeKutta::construct()
-    ERKStep( ConvertsToButcherTableau<value_type> tableau, const ContainerType& copyable): m_rk(tableau), m_k(m_rk.num_stages(), copyable)
+    ERKStep( ConvertsToButcherTableau<value_type> tableau, const ContainerType& copyable): m_rk(tableau), m_k(m_rk.num_stages(), copyable),
+        m_a(m_rk.num_stages()), m_d(m_rk.num_stages())
         { }
     ///@copydoc RungeKutta::construct()
     void construct( ConvertsToButcherTableau<value_type> tableau, const ContainerType& copyable ){
         m_rk = tableau;
         m_k.assign(m_rk.num_stages(), copyable);
+        m_a.assign(m_rk.num_stages(), 0);
+        m_d.assign(m_rk.num_stages(), 0);
     }
     ///@copydoc RungeKutta::copyable()
     const ContainerType& copyable()const{ return m_k[0];}
@@ -98,6 +269,7 @@ struct ERKStep
   private:
     ButcherTableau<value_type> m_rk;
     std::vector<ContainerType> m_k;
+    std::vector<value_type> m_a, m_d; //stage coefficients
     value_type m_t1 = 1e300;//remember the last timestep at which ERK is called
     bool m_ignore_fsal = false;
 };
@@ -113,125 +285,24 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
     if( t0 != m_t1 || m_ignore_fsal)
         f(t0, u0, m_k[0]); //freshly compute k_0
     //else take from last call
-    //1 stage
-    if( s>1) {
-        tu = DG_FMA( m_rk.c(1),dt, t0);
-        blas1::axpby( 1., u0, dt*m_rk.a(1,0), m_k[0], delta);
-        f( tu, delta, m_k[1]);
-    }
-    //2 stage
-    if( s>2) {
-        tu = DG_FMA( m_rk.c(2),dt, t0);
-        blas1::evaluate( delta, dg::equals(), PairSum(), 1., u0,
-                            dt*m_rk.a(2,0),m_k[0],
-                            dt*m_rk.a(2,1),m_k[1]);
-        f( tu, delta, m_k[2]);
-    }
-    //3 stage
-    if( s> 3){
-        tu = DG_FMA( m_rk.c(3),dt, t0);
-        blas1::evaluate( delta, dg::equals(), PairSum(), 1., u0,
-                             dt*m_rk.a(3,0),m_k[0],
-                             dt*m_rk.a(3,1),m_k[1],
-                             dt*m_rk.a(3,2),m_k[2]);
-        f( tu, delta, m_k[3]);
-    }
-    //4 stage
-    if( s>4){
-        tu = DG_FMA( m_rk.c(4),dt, t0);
-        blas1::evaluate( delta, dg::equals(), PairSum(), 1.        , u0,
-                             dt*m_rk.a(4,0),m_k[0],  dt*m_rk.a(4,1),m_k[1],
-                             dt*m_rk.a(4,2),m_k[2],  dt*m_rk.a(4,3),m_k[3]);
-        f( tu, delta, m_k[4]);
-    }
-    //5 stage
-    if( s>5) {
-        tu = DG_FMA( m_rk.c(5),dt, t0);
-        blas1::evaluate( delta, dg::equals(), PairSum(), 1., u0,
-                 dt*m_rk.a(5,0),m_k[0], dt*m_rk.a(5,1),m_k[1],
-                 dt*m_rk.a(5,2),m_k[2], dt*m_rk.a(5,3),m_k[3],
-                 dt*m_rk.a(5,4),m_k[4]);
-        f( tu, delta, m_k[5]);
-    }
-    //6 stage
-    if( s>6)
+    //stages 1 to s-1: every stage combination is fused into
+    //ceil(i/rk_max_fused) kernels regardless of the number of stages
+    for( unsigned i=1; i<s; i++)
     {
-        tu = DG_FMA( m_rk.c(6),dt, t0);
-        blas1::evaluate( delta, dg::equals(), PairSum(), 1., u0,
-                           dt*m_rk.a(6,0),m_k[0], dt*m_rk.a(6,1),m_k[1],
-                           dt*m_rk.a(6,2),m_k[2], dt*m_rk.a(6,3),m_k[3],
-                           dt*m_rk.a(6,4),m_k[4], dt*m_rk.a(6,5),m_k[5]);
-        f( tu, delta, m_k[6]);
-        for ( unsigned i=7; i<s; i++)
-        {
-            blas1::axpby( 1.,u0, dt*m_rk.a(i,0),m_k[0], delta); //l=0
-            tu = DG_FMA( dt,m_rk.c(i),t0); //l=0
-            for( unsigned l=1; l<i; l++)
-                blas1::axpby( dt*m_rk.a(i,l), m_k[l],1., delta);
-            f( tu, delta, m_k[i]);
-        }
+        tu = DG_FMA( m_rk.c(i),dt, t0);
+        for( unsigned j=0; j<i; j++)
+            m_a[j] = dt*m_rk.a(i,j);
+        detail::stage_sum( delta, value_type(1), u0, m_a, m_k, i);
+        f( tu, delta, m_k[i]);
     }
     //Now add everything up to get solution and error estimate
-    switch( s)
+    for( unsigned j=0; j<s; j++)
     {
-        //the first is for Euler
-        case 1:
-                blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0]); break;
-        case 2: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1]); break;
-        case 3: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1],
-                            dt*m_rk.b(2), dt*m_rk.d(2), m_k[2]); break;
-        case 4: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1],
-                            dt*m_rk.b(2), dt*m_rk.d(2), m_k[2],
-                            dt*m_rk.b(3), dt*m_rk.d(3), m_k[3]); break;
-        case 5: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1],
-                            dt*m_rk.b(2), dt*m_rk.d(2), m_k[2],
-                            dt*m_rk.b(3), dt*m_rk.d(3), m_k[3],
-                            dt*m_rk.b(4), dt*m_rk.d(4), m_k[4]); break;
-        case 6: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1],
-                            dt*m_rk.b(2), dt*m_rk.d(2), m_k[2],
-                            dt*m_rk.b(3), dt*m_rk.d(3), m_k[3],
-                            dt*m_rk.b(4), dt*m_rk.d(4), m_k[4],
-                            dt*m_rk.b(5), dt*m_rk.d(5), m_k[5]); break;
-        default: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rk.b(0), dt*m_rk.d(0), m_k[0],
-                            dt*m_rk.b(1), dt*m_rk.d(1), m_k[1],
-                            dt*m_rk.b(2), dt*m_rk.d(2), m_k[2],
-                            dt*m_rk.b(3), dt*m_rk.d(3), m_k[3],
-                            dt*m_rk.b(4), dt*m_rk.d(4), m_k[4],
-                            dt*m_rk.b(5), dt*m_rk.d(5), m_k[5],
-                            dt*m_rk.b(6), dt*m_rk.d(6), m_k[6]);
-            //sum the rest
-            for( unsigned i=7; i<s; i++)
-            {
-                dg::blas1::axpby( dt*m_rk.b(i), m_k[i], 1., u1);
-                dg::blas1::axpby( dt*m_rk.d(i), m_k[i], 1., delta);
-            }
+        m_a[j] = dt*m_rk.b(j);
+        m_d[j] = dt*m_rk.d(j);
     }
+    detail::embedded_stage_sum( u1, delta, value_type(1), value_type(0), u0,
+        m_a, m_d, m_k, s);
     //make sure (t1,u1) is the last call to f
     m_t1 = t1 = t0 + dt;
     if(!m_rk.isFsal() )
@@ -304,6 +375,8 @@ struct ARKStep
         assert( m_rkE.num_stages() == m_rkI.num_stages());
         m_kE.assign(m_rkE.num_stages(), m_rhs);
         m_kI.assign(m_rkI.num_stages(), m_rhs);
+        m_aE.assign(m_rkE.num_stages(), 0);
+        m_aI = m_dE = m_dI = m_aE;
     }
     ///@copydoc construct()
     template<class ...SolverParams>
@@ -316,7 +389,8 @@ struct ARKStep
          m_rkE(ex_tableau),
          m_rkI(im_tableau),
          m_kE(m_rkE.num_stages(), m_rhs),
-         m_kI(m_rkI.num_stages(), m_rhs)
+         m_kI(m_rkI.num_stages(), m_rhs),
+         m_aE(m_rkE.num_stages()), m_aI(m_aE), m_dE(m_aE), m_dI(m_aE)
     {
         assert( m_rkE.num_stages() == m_rkI.num_stages());
     }
@@ -383,6 +457,7 @@ struct ARKStep
     ContainerType m_rhs;
     ButcherTableau<value_type> m_rkE, m_rkI;
     std::vector<ContainerType> m_kE, m_kI;
+    std::vector<value_type> m_aE, m_aI, m_dE, m_dI; //stage coefficients
     value_type m_t1 = 1e300;
 };
 
@@ -439,10 +514,13 @@ void ARKStep<ContainerType, SolverType>::step( Explicit& ex, Implicit& im, value
     //higher stages
     for( unsigned i=4; i<s; i++)
     {
-        dg::blas1::copy( u0, m_rhs);
-        for( unsigned j=0; j<s; j++)
-            dg::blas1::axpbypgz( dt*m_rkE.a(i,j), m_kE[j],
-                                 dt*m_rkI.a(i,j), m_kI[j], 1., m_rhs);
+        for( unsigned j=0; j<i; j++)
+        {
+            m_aE[j] = dt*m_rkE.a(i,j);
+            m_aI[j] = dt*m_rkI.a(i,j);
+        }
+        detail::stage_sum( m_rhs, value_type(1), u0, m_aE, m_kE, i);
+        detail::stage_sum( m_rhs, value_type(1), m_rhs, m_aI, m_kI, i);
         tu = DG_FMA( m_rkI.c(i),dt, t0);
         blas1::copy( m_rhs, delta); //better init with rhs
         m_solver.solve( -dt*m_rkI.a(i,i), im, tu, delta, m_rhs);
@@ -464,12 +542,17 @@ void ARKStep<ContainerType, SolverType>::step( Explicit& ex, Implicit& im, value
             dt*m_rkI.b(2), dt*m_rkI.d(2),m_kI[2],
             dt*m_rkI.b(3), dt*m_rkI.d(3),m_kI[3]);
     //sum the rest
-    for( unsigned i=4; i<s; i++)
+    if( s > 4)
     {
-        dg::blas1::axpbypgz( dt*m_rkE.b(i), m_kE[i],
-                             dt*m_rkI.b(i), m_kI[i], 1., u1);
-        dg::blas1::axpbypgz( dt*m_rkE.d(i), m_kE[i],
-                             dt*m_rkI.d(i), m_kI[i], 1., delta);
+        for( unsigned i=4; i<s; i++)
+        {
+            m_aE[i] = dt*m_rkE.b(i);
+            m_dE[i] = dt*m_rkE.d(i);
+            m_aI[i] = dt*m_rkI.b(i);
+            m_dI[i] = dt*m_rkI.d(i);
+        }
+        detail::embedded_stage_sum_add( u1, delta, m_aE, m_dE, m_kE, 4, s);
+        detail::embedded_stage_sum_add( u1, delta, m_aI, m_dI, m_kI, 4, s);
     }
     //make sure (t1,u1) is the last call to ex
     ex(t1,u1,m_kE[0]);
@@ -739,7 +822,8 @@ struct DIRKStep
          m_solver( std::forward<SolverParams>(ps)...),
          m_rhs( m_solver.copyable()),
          m_rkI(im_tableau),
-         m_kI(m_rkI.num_stages(), m_rhs)
+         m_kI(m_rkI.num_stages(), m_rhs),
+         m_a(m_rkI.num_stages()), m_d(m_rkI.num_stages())
     {
     }
 
@@ -763,6 +847,8 @@ struct DIRKStep
         m_solver = SolverType( std::forward<SolverParams>(ps)...);
         m_rhs = m_solver.copyable();
         m_kI.assign(m_rkI.num_stages(), m_rhs);
+        m_a.assign(m_rkI.num_stages(), 0);
+        m_d.assign(m_rkI.num_stages(), 0);
     }
     ///@brief Return an object of same size as the object used for construction
     ///@return A copyable object; what it contains is undefined, its size is important
@@ -806,6 +892,7 @@ struct DIRKStep
     ContainerType m_rhs;
     ButcherTableau<value_type> m_rkI;
     std::vector<ContainerType> m_kI;
+    std::vector<value_type> m_a, m_d; //stage coefficients
 };
 
 ///@cond
@@ -856,9 +943,9 @@ void DIRKStep<ContainerType, SolverType>::step( RHS& rhs, value_type t0, const C
         rhs(tu, delta, m_kI[3]);
         for( unsigned i=4; i<s; i++)
         {
-            dg::blas1::copy( u0, m_rhs);
             for( unsigned j=0; j<i; j++)
-                dg::blas1::axpby( dt*m_rkI.a(i,j), m_kI[j], 1., m_rhs);
+                m_a[j] = dt*m_rkI.a(i,j);
+            detail::stage_sum( m_rhs, value_type(1), u0, m_a, m_kI, i);
             tu = DG_FMA( m_rkI.c(i),dt, t0);
             blas1::copy( m_rhs, delta); //better init with rhs
             m_solver.solve( -dt*m_rkI.a(i,i), rhs, tu, delta, m_rhs);
@@ -867,37 +954,13 @@ void DIRKStep<ContainerType, SolverType>::step( RHS& rhs, value_type t0, const C
     }
     t1 = t0 + dt;
     //Now compute result and error estimate
-    switch( s)
+    for( unsigned j=0; j<s; j++)
     {
-        case 1: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rkI.b(0), dt*m_rkI.d(0), m_kI[0]); break;
-        case 2: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rkI.b(0), dt*m_rkI.d(0), m_kI[0],
-                            dt*m_rkI.b(1), dt*m_rkI.d(1), m_kI[1]); break;
-        case 3: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rkI.b(0), dt*m_rkI.d(0), m_kI[0],
-                            dt*m_rkI.b(1), dt*m_rkI.d(1), m_kI[1],
-                            dt*m_rkI.b(2), dt*m_rkI.d(2), m_kI[2]); break;
-        default: blas1::subroutine( dg::EmbeddedPairSum(),
-                            u1, delta,
-                            1., 0., u0,
-                            dt*m_rkI.b(0), dt*m_rkI.d(0), m_kI[0],
-                            dt*m_rkI.b(1), dt*m_rkI.d(1), m_kI[1],
-                            dt*m_rkI.b(2), dt*m_rkI.d(2), m_kI[2],
-                            dt*m_rkI.b(3), dt*m_rkI.d(3), m_kI[3]);
-            //sum the rest
-            for( unsigned i=4; i<s; i++)
-            {
-                dg::blas1::axpby( dt*m_rkI.b(i), m_kI[i], 1., u1);
-                dg::blas1::axpby( dt*m_rkI.d(i), m_kI[i], 1., delta);
-            }
+        m_a[j] = dt*m_rkI.b(j);
+        m_d[j] = dt*m_rkI.d(j);
     }
+    detail::embedded_stage_sum( u1, delta, value_type(1), value_type(0), u0,
+        m_a, m_d, m_kI, s);
 }
 ///@endcond
 /**
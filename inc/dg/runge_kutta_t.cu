@@ -147,5 +147,65 @@ int main()
         dg::blas1::axpby( 1., sol , -1., u1);
         std::cout << "Norm of error in "<<std::setw(24) <<name<<"\t"<<sqrt(dg::blas1::dot( u1, u1))<<"\n";
     }
-    return 0;
+    ///-------------------------------Semi-implicit Methods-----------------//
+    std::cout << "Semi-implicit ARK Methods with "<<N<<" steps:\n";
+    //the damping is treated implicitly, everything else explicitly
+    auto ex = [&]( double t, const std::array<double,2>& y, std::array<double,2>& yp){
+        yp[0] = y[1];
+        yp[1] = - omega_0*omega_0*y[0] + sin(omega_drive*t);
+    };
+    auto im = [&]( double t, const std::array<double,2>& y, std::array<double,2>& yp){
+        yp[0] = 0.;
+        yp[1] = -2.*damping*omega_0*y[1];
+    };
+    bool passed = true;
+    for( auto name : std::vector<std::string>{"ARK-4-2-3", "ARK-6-3-4", "ARK-8-4-5"})
+    {
+        using Solver = dg::FixedPointSolver<std::array<double,2>>;
+        u = solution(t_start, damping, omega_0, omega_drive);
+        std::array<double, 2> u1(u), delta(u), sol = solution(t_end, damping, omega_0, omega_drive);
+        dg::ARKStep<std::array<double,2>, Solver> ark( name, u, 100, 1e-15);
+        double t=t_start;
+        for( unsigned i=0; i<N; i++)
+            ark.step( ex, im, t, u1, t, u1, dt, delta);
+        dg::blas1::axpby( 1., sol, -1., u1);
+        std::cout << "Norm of error in "<<std::setw(24) <<name<<"\t"<<sqrt(dg::blas1::dot( u1, u1))<<"\n";
+        //compare one step to a step computed directly from the tableaus
+        //(regression test: stage i must only use the stages j<i)
+        dg::ButcherTableau<double> rkE = dg::create::tableau<double>( name+" (explicit)");
+        dg::ButcherTableau<double> rkI = dg::create::tableau<double>( name+" (implicit)");
+        unsigned s = rkE.num_stages();
+        std::vector<std::array<double,2>> kE(s), kI(s);
+        std::array<double,2> rhs, ref(u);
+        Solver solver( u, 100, 1e-15);
+        ex( t_start, u, kE[0]);
+        im( t_start, u, kI[0]);
+        for( unsigned i=1; i<s; i++)
+        {
+            rhs = u;
+            for( unsigned j=0; j<i; j++)
+                dg::blas1::axpbypgz( dt*rkE.a(i,j), kE[j], dt*rkI.a(i,j), kI[j],
+                        1., rhs);
+            double tu = t_start + rkI.c(i)*dt;
+            delta = rhs;
+            solver.solve( -dt*rkI.a(i,i), im, tu, delta, rhs);
+            ex( tu, delta, kE[i]);
+            im( tu, delta, kI[i]);
+        }
+        for( unsigned j=0; j<s; j++)
+            dg::blas1::axpbypgz( dt*rkE.b(j), kE[j], dt*rkI.b(j), kI[j], 1., ref);
+        dg::ARKStep<std::array<double,2>, Solver> ark1( name, u, 100, 1e-15);
+        ark1.step( ex, im, t_start, u, t, u1, dt, delta);
+        dg::blas1::axpby( 1., ref, -1., u1);
+        double diff = sqrt(dg::blas1::dot( u1, u1));
+        std::cout << "    Difference to reference step\t"<<diff;
+        if( diff > 1e-14)
+        {
+            std::cout << " FAILED\n";
+            passed = false;
+        }
+        else
+            std::cout << " PASSED\n";
+    }
+    return passed ? 0 : 1;
 }
@@ -176,6 +176,30 @@ DG_DEVICE void sum( T1& y_1, T1& yt_1, T1 b, T1 bt, T1 k) const
     }
 };
 
+///@brief \f$ y \leftarrow y + \sum_i a_i x_i,\quad \tilde y \leftarrow \tilde y + \sum_i \tilde a_i x_i \f$
+struct EmbeddedPairSumAdd
+{
+    ///@brief \f[ y + \sum_i \alpha_i x_i \f]
+    template< class T1, class ...Ts>
+DG_DEVICE void operator()( T1& y, T1& yt, T1 a, T1 at, T1 x, Ts... rest) const
+    {
+        y = DG_FMA( a, x, y);
+        yt = DG_FMA( at, x, yt);
+        sum( y, yt, rest...);
+    }
+    private:
+    template< class T1,  class ...Ts>
+DG_DEVICE void sum( T1& y_1, T1& yt_1, T1 b, T1 bt, T1 k, Ts... rest) const
+    {
+        y_1 = DG_FMA( b, k, y_1);
+        yt_1 = DG_FMA( bt, k, yt_1);
+        sum( y_1, yt_1, rest...);
+    }
+
+    template< class T1>
+DG_DEVICE void sum( T1& y_1, T1& yt_1) const { }
+};
+
 /// \f$ f( y, g(x_0, ..., x_s)) \f$
 template<class BinarySub, class Functor>
 struct Evaluate
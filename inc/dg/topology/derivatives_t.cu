@@ -75,6 +75,20 @@ int main()
         value_t norm = sqrt(dg::blas2::dot( error, w3d, error)); res.d = norm;
         std::cout << "Distance to true solution: "<<norm<<"\t"<<res.i-binary3[i]<<"\n";
     }
+    std::cout << "TEST 3D batched symv: DX, DY, DZ, JX, JY, JZ\n";
+    const Vector g3 = dg::evaluate( cosx, g3d);
+    for( unsigned i=0; i<6; i++)
+    {
+        Vector single0 = sol3[i], single1 = sol3[i];
+        dg::blas2::symv( -1., m3[i], f3d, 1., single0);
+        dg::blas2::symv( -1., m3[i], g3, 1., single1);
+        Vector batch0 = sol3[i], batch1 = sol3[i];
+        dg::blas2::symv( -1., m3[i], {&f3d, &g3}, 1., {&batch0, &batch1});
+        dg::blas1::axpby( 1., single0, -1., batch0);
+        dg::blas1::axpby( 1., single1, -1., batch1);
+        value_t norm = dg::blas1::dot( batch0, batch0) + dg::blas1::dot( batch1, batch1);
+        std::cout << "Difference to single symv:  "<<norm<<"\t"<<(int64_t)norm<<"\n";
+    }
     std::cout << "\nFINISHED! Continue with arakawa_t.cu !\n\n";
 
     return 0;
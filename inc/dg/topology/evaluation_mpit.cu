@@ -70,6 +70,14 @@ int main(int argc, char** argv)
     if(rank==0)std::cout << "Correct integral is       "<<std::setw(6)<<sol3d<<std::endl;
     if(rank==0)std::cout << "Relative 3d error is      "<<(integral3d-sol3d)/sol3d<<"\n\n";
 
+    std::vector<double> integrals3d = dg::blas1::dots( {{&w3d, &func3d}, {&func3d, &w3d}});
+    for( unsigned k=0; k<2; k++)
+    {
+        res.d = integrals3d[k];
+        if(rank==0)std::cout << "3D integral (dots)        "<<std::setw(6)<<integrals3d[k] <<"\t" << res.i - 4675882723962622631<< "\n";
+    }
+    if(rank==0)std::cout << "\n";
+
     double norm2d = dg::blas2::dot( w2d, func2d); res.d = norm2d;
     if(rank==0)std::cout << "Square normalized 2D norm "<<std::setw(6)<<norm2d<<"\t" << res.i - 4635333359953759707<<"\n";
     double solution2d = 80.0489;
@@ -87,6 +87,14 @@ int main()
     std::cout << "Correct integral is       "<<std::setw(6)<<sol3d<<std::endl;
     std::cout << "Relative 3d error is      "<<(integral3d-sol3d)/sol3d<<"\n\n";
 
+    std::vector<double> integrals3d = dg::blas1::dots( {{&w3d, &func3d}, {&func3d, &w3d}});
+    for( unsigned k=0; k<2; k++)
+    {
+        res.d = integrals3d[k];
+        std::cout << "3D integral (dots)        "<<std::setw(6)<<integrals3d[k] <<"\t" << res.i - 4675882723962622631<< "\n";
+    }
+    std::cout << "\n";
+
     double norm = dg::blas2::dot( func1d, w1d, func1d); res.d = norm;
     std::cout << "Square normalized 1D norm "<<std::setw(6)<<norm<<"\t" << res.i - 4627337306989890294 <<"\n";
     double solution = (exp(4.) -exp(2))/2.;
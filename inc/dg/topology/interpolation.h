@@ -1,6 +1,7 @@
 #pragma once
 //#include <iomanip>
 
+#include <array>
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include "grid.h"
@@ -48,10 +49,9 @@ namespace detail{
  * @return array of coefficients beginning with p_0(x_n) until p_{n-1}(x_n)
  */
 template<class real_type>
-std::vector<real_type> coefficients( real_type xn, unsigned n)
+void coefficients( real_type xn, unsigned n, real_type* px)
 {
     assert( xn <= 1. && xn >= -1.);
-    std::vector<real_type> px(n);
     if( xn == -1)
     {
         for( unsigned u=0; u<n; u++)
@@ -72,9 +72,170 @@ std::vector<real_type> coefficients( real_type xn, unsigned n)
                 px[i+1] = ((real_type)(2*i+1)*xn*px[i]-(real_type)i*px[i-1])/(real_type)(i+1);
         }
     }
+}
+///@copydoc coefficients(real_type,unsigned,real_type*)
+template<class real_type>
+std::vector<real_type> coefficients( real_type xn, unsigned n)
+{
+    std::vector<real_type> px(n);
+    coefficients( xn, n, px.data());
     return px;
 }
 
+//pxF_l = sum_k p_k(xn) forward(k,l) (the interpolation weights of the n nodes in a cell)
+//px and pxF must have size n
+template<class real_type>
+void forward_coefficients( real_type xn, const dg::Operator<real_type>& forward, real_type* px, real_type* pxF)
+{
+    const unsigned n = forward.size();
+    coefficients( xn, n, px);
+    for( unsigned l=0; l<n; l++)
+    {
+        pxF[l] = 0;
+        for( unsigned k=0; k<n; k++)
+            pxF[l]+= px[k]*forward(k,l);
+    }
+}
+
+//An interpolation point located in a (2d slice of a) grid
+template<class real_type>
+struct InterpolationPoint
+{
+    bool negative; //point was mirrored at a DIR boundary
+    unsigned nn, mm, ll; //cell indices in x, y, and z
+    real_type xn, yn; //normalized coordinates in the cell
+    int idxX, idxY; //node index if the point coincides with a Gauss node in x (y), else -1
+    unsigned size( unsigned n) const
+    {
+        return (idxX < 0 ? n : 1)*(idxY < 0 ? n : 1);
+    }
+};
+
+//locate an already shifted point (X,Y) in a 2d or 3d topology
+template<class real_type, class Topology>
+InterpolationPoint<real_type> locate_point( real_type X, real_type Y, bool negative,
+    const Topology& g, const std::vector<real_type>& gauss_nodes)
+{
+    InterpolationPoint<real_type> p;
+    p.negative = negative;
+    p.ll = 0;
+    //determine which cell (x,y) lies in
+    real_type xnn = (X-g.x0())/g.hx();
+    real_type ynn = (Y-g.y0())/g.hy();
+    p.nn = (unsigned)floor(xnn);
+    p.mm = (unsigned)floor(ynn);
+    //determine normalized coordinates
+    p.xn =  2.*xnn - (real_type)(2*p.nn+1);
+    p.yn =  2.*ynn - (real_type)(2*p.mm+1);
+    //interval correction
+    if (p.nn==g.Nx()) {
+        p.nn-=1;
+        p.xn = 1.;
+    }
+    if (p.mm==g.Ny()) {
+        p.mm-=1;
+        p.yn =1.;
+    }
+    //Test if the point is a Gauss point since then no interpolation is needed
+    p.idxX =-1, p.idxY = -1;
+    for( unsigned k=0; k<g.n(); k++)
+    {
+        if( fabs( p.xn - gauss_nodes[k]) < 1e-14)
+            p.idxX = p.nn*g.n() + k; //determine which grid column it is
+        if( fabs( p.yn - gauss_nodes[k]) < 1e-14)
+            p.idxY = p.mm*g.n() + k;  //determine grid line
+    }
+    return p;
+}
+
+/* Assemble the interpolation matrix of located points in two passes:
+ * count the non-zeros of each row, prefix sum to get the row offsets, then
+ * fill all rows in parallel. The entries are ordered by row (as in a CSR
+ * matrix) and identical to a serial assembly.
+ */
+template<class real_type>
+cusp::coo_matrix<int, real_type, cusp::host_memory> interpolation_matrix(
+    const std::vector<InterpolationPoint<real_type>>& points,
+    unsigned n, unsigned Nx, unsigned Ny, unsigned num_cols,
+    const dg::Operator<real_type>& forward)
+{
+    const int num_rows = points.size();
+    std::vector<int> row_offsets( num_rows+1, 0);
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif //_OPENMP
+    for( int i=0; i<num_rows; i++)
+        row_offsets[i+1] = points[i].size( n);
+    for( int i=0; i<num_rows; i++)
+        row_offsets[i+1] += row_offsets[i];
+    cusp::coo_matrix<int, real_type, cusp::host_memory> A( num_rows, num_cols, row_offsets[num_rows]);
+    int* rows = thrust::raw_pointer_cast( A.row_indices.data());
+    int* cols = thrust::raw_pointer_cast( A.column_indices.data());
+    real_type* vals = thrust::raw_pointer_cast( A.values.data());
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif //_OPENMP
+    {
+    //one set of buffers per thread
+    std::vector<real_type> px(n), py(n), pxF(n), pyF(n);
+#ifdef _OPENMP
+    #pragma omp for
+#endif //_OPENMP
+    for( int i=0; i<num_rows; i++)
+    {
+        const InterpolationPoint<real_type>& p = points[i];
+        int number = row_offsets[i];
+        const unsigned nn = p.nn, mm = p.mm, ll = p.ll;
+        const int idxX = p.idxX, idxY = p.idxY;
+        if( idxX < 0 && idxY < 0 ) //there is no corresponding point
+        {
+            //evaluate 2d Legendre polynomials at (xn, yn)...
+            forward_coefficients( p.xn, forward, px.data(), pxF.data());
+            forward_coefficients( p.yn, forward, py.data(), pyF.data());
+            //...these are the matrix coefficients with which to multiply
+            for( unsigned k=0; k<n; k++)
+                for( unsigned l=0; l<n; l++)
+                {
+                    real_type pxy = pyF[k]*pxF[l];
+                    rows[number] = i;
+                    cols[number] = ((ll*Ny+mm)*n+k)*n*Nx+nn*n + l;
+                    vals[number] = p.negative ? -pxy : pxy;
+                    number++;
+                }
+        }
+        else if ( idxX < 0 && idxY >=0) //there is a corresponding line
+        {
+            forward_coefficients( p.xn, forward, px.data(), pxF.data());
+            for( unsigned l=0; l<n; l++)
+            {
+                rows[number] = i;
+                cols[number] = (ll*Ny*n + idxY)*Nx*n + nn*n + l;
+                vals[number] = p.negative ? -pxF[l] : pxF[l];
+                number++;
+            }
+        }
+        else if ( idxX >= 0 && idxY < 0) //there is a corresponding column
+        {
+            forward_coefficients( p.yn, forward, py.data(), pyF.data());
+            for( unsigned k=0; k<n; k++)
+            {
+                rows[number] = i;
+                cols[number] = ((ll*Ny+mm)*n+k)*Nx*n + idxX;
+                vals[number] = p.negative ? -pyF[k] : pyF[k];
+                number++;
+            }
+        }
+        else //the point already exists
+        {
+            rows[number] = i;
+            cols[number] = (ll*Ny*n+idxY)*Nx*n + idxX;
+            vals[number] = p.negative ? -1. : 1.;
+        }
+    }
+    }
+    return A;
+}
+
 }//namespace detail
 ///@endcond
 ///@addtogroup interpolation
@@ -106,9 +267,16 @@ cusp::coo_matrix<int, real_type, cusp::host_memory> interpolation( const thrust:
 {
     cusp::coo_matrix<int, real_type, cusp::host_memory> A( x.size(), g.size(), x.size()*g.n());
 
-    int number = 0;
     dg::Operator<real_type> forward( g.dlt().forward());
-    for( unsigned i=0; i<x.size(); i++)
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif //_OPENMP
+    {
+    std::vector<real_type> px(g.n()), pxF(g.n());
+#ifdef _OPENMP
+    #pragma omp for
+#endif //_OPENMP
+    for( int i=0; i<(int)x.size(); i++)
     {
         real_type X = x[i];
         bool negative = false;
@@ -124,19 +292,17 @@ cusp::coo_matrix<int, real_type, cusp::host_memory> interpolation( const thrust:
             n-=1;
             xn = 1.;
         }
-        //evaluate 2d Legendre polynomials at (xn, yn)...
-        std::vector<real_type> px = detail::coefficients( xn, g.n());
+        //evaluate 1d Legendre polynomials at xn...
         //...these are the matrix coefficients with which to multiply
-        std::vector<real_type> pxF(px.size(),0);
-        for( unsigned l=0; l<g.n(); l++)
-            for( unsigned k=0; k<g.n(); k++)
-                pxF[l]+= px[k]*forward(k,l);
+        detail::forward_coefficients( xn, forward, px.data(), pxF.data());
         unsigned col_begin = n*g.n();
         if( negative)
             for( unsigned l=0; l<g.n(); l++)
                 pxF[l]*=-1.;
+        int number = i*g.n();
         detail::add_line( A, number, i,  col_begin, pxF);
     }
+    }
     return A;
 }
 
@@ -163,121 +329,20 @@ cusp::coo_matrix<int, real_type, cusp::host_memory> interpolation( const thrust:
     assert( x.size() == y.size());
     std::vector<real_type> gauss_nodes = g.dlt().abscissas();
     dg::Operator<real_type> forward( g.dlt().forward());
-    cusp::array1d<real_type, cusp::host_memory> values;
-    cusp::array1d<int, cusp::host_memory> row_indices;
-    cusp::array1d<int, cusp::host_memory> column_indices;
+    std::vector<detail::InterpolationPoint<real_type>> points( x.size());
 
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif //_OPENMP
     for( int i=0; i<(int)x.size(); i++)
     {
         real_type X = x[i], Y = y[i];
         bool negative=false;
         g.shift( negative,X,Y, bcx, bcy);
-
-        //determine which cell (x,y) lies in
-        real_type xnn = (X-g.x0())/g.hx();
-        real_type ynn = (Y-g.y0())/g.hy();
-        unsigned nn = (unsigned)floor(xnn);
-        unsigned mm = (unsigned)floor(ynn);
-        //determine normalized coordinates
-        real_type xn =  2.*xnn - (real_type)(2*nn+1);
-        real_type yn =  2.*ynn - (real_type)(2*mm+1);
-        //interval correction
-        if (nn==g.Nx()) {
-            nn-=1;
-            xn = 1.;
-        }
-        if (mm==g.Ny()) {
-            mm-=1;
-            yn =1.;
-        }
-        //Test if the point is a Gauss point since then no interpolation is needed
-        int idxX =-1, idxY = -1;
-        for( unsigned k=0; k<g.n(); k++)
-        {
-            if( fabs( xn - gauss_nodes[k]) < 1e-14)
-                idxX = nn*g.n() + k; //determine which grid column it is
-            if( fabs( yn - gauss_nodes[k]) < 1e-14)
-                idxY = mm*g.n() + k;  //determine grid line
-        }
-        if( idxX < 0 && idxY < 0 ) //there is no corresponding point
-        {
-            //evaluate 2d Legendre polynomials at (xn, yn)...
-            std::vector<real_type> px = detail::coefficients( xn, g.n()),
-                                   py = detail::coefficients( yn, g.n());
-            std::vector<real_type> pxF(g.n(),0), pyF(g.n(), 0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                {
-                    pxF[l]+= px[k]*forward(k,l);
-                    pyF[l]+= py[k]*forward(k,l);
-                }
-            std::vector<real_type> pxy( g.n()*g.n());
-            //these are the matrix coefficients with which to multiply
-            for(unsigned k=0; k<pyF.size(); k++)
-                for( unsigned l=0; l<pxF.size(); l++)
-                    pxy[k*px.size()+l]= pyF[k]*pxF[l];
-            for( unsigned k=0; k<g.n(); k++)
-                for( unsigned l=0; l<g.n(); l++)
-                {
-                    row_indices.push_back( i);
-                    column_indices.push_back( (mm*g.n()+k)*g.n()*g.Nx()+nn*g.n() + l);
-                    if( !negative)
-                        values.push_back(  pxy[k*g.n()+l]);
-                    else
-                        values.push_back( -pxy[k*g.n()+l]);
-                }
-        }
-        else if ( idxX < 0 && idxY >=0) //there is a corresponding line
-        {
-            std::vector<real_type> px = detail::coefficients( xn, g.n());
-            std::vector<real_type> pxF(g.n(),0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                    pxF[l]+= px[k]*forward(k,l);
-            for( unsigned l=0; l<g.n(); l++)
-            {
-                row_indices.push_back( i);
-                column_indices.push_back( (idxY)*g.Nx()*g.n() + nn*g.n() + l);
-                if( !negative)
-                    values.push_back( pxF[l]);
-                else
-                    values.push_back(-pxF[l]);
-
-            }
-        }
-        else if ( idxX >= 0 && idxY < 0) //there is a corresponding column
-        {
-            std::vector<real_type> py = detail::coefficients( yn, g.n());
-            std::vector<real_type> pyF(g.n(),0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                    pyF[l]+= py[k]*forward(k,l);
-            for( unsigned k=0; k<g.n(); k++)
-            {
-                row_indices.push_back(i);
-                column_indices.push_back((mm*g.n()+k)*g.Nx()*g.n() + idxX);
-                if( !negative)
-                    values.push_back( pyF[k]);
-                else
-                    values.push_back(-pyF[k]);
-
-            }
-        }
-        else //the point already exists
-        {
-            row_indices.push_back(i);
-            column_indices.push_back(idxY*g.Nx()*g.n() + idxX);
-            if( !negative)
-                values.push_back( 1.);
-            else
-                values.push_back(-1.);
-        }
-
+        points[i] = detail::locate_point( X, Y, negative, g, gauss_nodes);
     }
-    cusp::coo_matrix<int, real_type, cusp::host_memory> A( x.size(), g.size(), values.size());
-    A.row_indices = row_indices; A.column_indices = column_indices; A.values = values;
-
-    return A;
+    return detail::interpolation_matrix( points, g.n(), g.Nx(), g.Ny(),
+            g.size(), forward);
 }
 
 
@@ -308,124 +373,26 @@ cusp::coo_matrix<int, real_type, cusp::host_memory> interpolation( const thrust:
     assert( y.size() == z.size());
     std::vector<real_type> gauss_nodes = g.dlt().abscissas();
     dg::Operator<real_type> forward( g.dlt().forward());
-    cusp::array1d<real_type, cusp::host_memory> values;
-    cusp::array1d<int, cusp::host_memory> row_indices;
-    cusp::array1d<int, cusp::host_memory> column_indices;
+    std::vector<detail::InterpolationPoint<real_type>> points( x.size());
 
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif //_OPENMP
     for( int i=0; i<(int)x.size(); i++)
     {
         real_type X = x[i], Y = y[i], Z = z[i];
         bool negative = false;
         g.shift( negative,X,Y,Z, bcx, bcy, bcz);
-
-        //determine which cell (x,y) lies in
-        real_type xnn = (X-g.x0())/g.hx();
-        real_type ynn = (Y-g.y0())/g.hy();
-        real_type znn = (Z-g.z0())/g.hz();
-        unsigned nn = (unsigned)floor(xnn);
-        unsigned mm = (unsigned)floor(ynn);
-        unsigned ll = (unsigned)floor(znn);
-        //determine normalized coordinates
-        real_type xn = 2.*xnn - (real_type)(2*nn+1);
-        real_type yn = 2.*ynn - (real_type)(2*mm+1);
-        //interval correction
-        if (nn==g.Nx()) {
-            nn-=1;
-            xn = 1.;
-        }
-        if (mm==g.Ny()) {
-            mm-=1;
-            yn =1.;
-        }
+        points[i] = detail::locate_point( X, Y, negative, g, gauss_nodes);
+        //in z-direction we don't interpolate
+        unsigned ll = (unsigned)floor((Z-g.z0())/g.hz());
         if (ll==g.Nz()) {
             ll-=1;
         }
-        //Test if the point is a Gauss point since then no interpolation is needed
-        int idxX =-1, idxY = -1;
-        for( unsigned k=0; k<g.n(); k++)
-        {
-            if( fabs( xn - gauss_nodes[k]) < 1e-14)
-                idxX = nn*g.n() + k; //determine which grid column it is
-            if( fabs( yn - gauss_nodes[k]) < 1e-14)
-                idxY = mm*g.n() + k;  //determine grid line
-        } //in z-direction we don't interpolate
-        if( idxX < 0 && idxY < 0 ) //there is no corresponding point
-        {
-            //evaluate 2d Legendre polynomials at (xn, yn)...
-            std::vector<real_type> px = detail::coefficients( xn, g.n()),
-                                py = detail::coefficients( yn, g.n());
-            std::vector<real_type> pxF(g.n(),0), pyF(g.n(), 0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                {
-                    pxF[l]+= px[k]*forward(k,l);
-                    pyF[l]+= py[k]*forward(k,l);
-                }
-            std::vector<real_type> pxyz( g.n()*g.n());
-            //these are the matrix coefficients with which to multiply
-            for(unsigned k=0; k<pyF.size(); k++)
-                for( unsigned l=0; l<pxF.size(); l++)
-                    pxyz[k*g.n()+l]= 1.*pyF[k]*pxF[l];
-            for( unsigned k=0; k<g.n(); k++)
-                for( unsigned l=0; l<g.n(); l++)
-                {
-                    row_indices.push_back( i);
-                    column_indices.push_back( ((ll*g.Ny()+mm)*g.n()+k)*g.n()*g.Nx()+nn*g.n() + l);
-                    if( !negative)
-                        values.push_back( pxyz[k*g.n()+l]);
-                    else
-                        values.push_back(-pxyz[k*g.n()+l]);
-                }
-        }
-        else if ( idxX < 0 && idxY >=0) //there is a corresponding line
-        {
-            std::vector<real_type> px = detail::coefficients( xn, g.n());
-            std::vector<real_type> pxF(g.n(),0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                    pxF[l]+= px[k]*forward(k,l);
-            for( unsigned l=0; l<g.n(); l++)
-            {
-                row_indices.push_back( i);
-                column_indices.push_back( (ll*g.Ny()*g.n() + idxY)*g.Nx()*g.n() + nn*g.n() + l);
-                if( !negative)
-                    values.push_back( pxF[l]);
-                else
-                    values.push_back(-pxF[l]);
-            }
-        }
-        else if ( idxX >= 0 && idxY < 0) //there is a corresponding column
-        {
-            std::vector<real_type> py = detail::coefficients( yn, g.n());
-            std::vector<real_type> pyF(g.n(),0);
-            for( unsigned l=0; l<g.n(); l++)
-                for( unsigned k=0; k<g.n(); k++)
-                    pyF[l]+= py[k]*forward(k,l);
-            for( unsigned k=0; k<g.n(); k++)
-            {
-                row_indices.push_back(i);
-                column_indices.push_back(((ll*g.Ny()+mm)*g.n()+k)*g.Nx()*g.n() + idxX);
-                if(!negative)
-                    values.push_back( pyF[k]);
-                else
-                    values.push_back(-pyF[k]);
-            }
-        }
-        else //the point already exists
-        {
-            row_indices.push_back(i);
-            column_indices.push_back((ll*g.Ny()*g.n()+idxY)*g.Nx()*g.n() + idxX);
-            if( !negative)
-                values.push_back( 1.);
-            else
-                values.push_back(-1.);
-        }
-
+        points[i].ll = ll;
     }
-    cusp::coo_matrix<int, real_type, cusp::host_memory> A( x.size(), g.size(), values.size());
-    A.row_indices = row_indices; A.column_indices = column_indices; A.values = values;
-
-    return A;
+    return detail::interpolation_matrix( points, g.n(), g.Nx(), g.Ny(),
+            g.size(), forward);
 }
 /**
  * @brief Create interpolation between two grids
@@ -677,4 +644,225 @@ real_type interpolate(
     return value;
 }
 
+/**
+ * @brief Transform several vectors from dg::xspace (nodal values) to dg::lspace (modal values) and interleave the result
+ *
+ * @param in k input vectors
+ * @param g grid
+ *
+ * @ingroup misc
+ * @return the modal coefficients of all k vectors in one vector of size
+ * \c k*g.size(), where element \c i*k+j is the i-th coefficient of \c in[j]
+ * (this is the layout that the multi-field \c dg::interpolate expects)
+ */
+template<std::size_t k, class real_type>
+thrust::host_vector<real_type> forward_transform( const std::array<thrust::host_vector<real_type>,k>& in, const aRealTopology2d<real_type>& g)
+{
+    thrust::host_vector<real_type> out( k*g.size());
+    for( unsigned j=0; j<k; j++)
+    {
+        thrust::host_vector<real_type> temp = forward_transform( in[j], g);
+        for( unsigned i=0; i<g.size(); i++)
+            out[i*k+j] = temp[i];
+    }
+    return out;
+}
+
+///@cond
+namespace detail{
+//Interpolate k interleaved fields on a single point
+//N is the number of polynomial coefficients if known at compile time (else 0)
+//buffer must hold 4*g.n() values
+template<unsigned N, std::size_t k, class real_type>
+std::array<real_type,k> interpolate_fields(
+    dg::space sp,
+    const real_type* v,
+    real_type x, real_type y,
+    const aRealTopology2d<real_type>& g,
+    dg::bc bcx, dg::bc bcy, real_type* buffer)
+{
+    const unsigned n = N > 0 ? N : g.n();
+    bool negative = false;
+    g.shift( negative, x,y, bcx, bcy);
+
+    //determine which cell (x,y) lies in
+    real_type xnn = (x-g.x0())/g.hx();
+    real_type ynn = (y-g.y0())/g.hy();
+    unsigned nn = (unsigned)floor(xnn);
+    unsigned mm = (unsigned)floor(ynn);
+    //determine normalized coordinates
+    real_type xn =  2.*xnn - (real_type)(2*nn+1);
+    real_type yn =  2.*ynn - (real_type)(2*mm+1);
+    //interval correction
+    if (nn==g.Nx()) {
+        nn-=1;
+        xn = 1.;
+    }
+    if (mm==g.Ny()) {
+        mm-=1;
+        yn =1.;
+    }
+    //evaluate 2d Legendre polynomials at (xn, yn) once for all fields
+    real_type* px = buffer, *py = buffer + n;
+    create::detail::coefficients( xn, n, px);
+    create::detail::coefficients( yn, n, py);
+    if( sp == dg::xspace)
+    {
+        const real_type* forward = g.dlt().forward().data();
+        real_type* pxF = buffer + 2*n, *pyF = buffer + 3*n;
+        for( unsigned l=0; l<n; l++)
+        {
+            pxF[l] = pyF[l] = 0;
+            for( unsigned o=0; o<n; o++)
+            {
+                pxF[l]+= px[o]*forward[o*n+l];
+                pyF[l]+= py[o]*forward[o*n+l];
+            }
+        }
+        px = pxF, py = pyF;
+    }
+    //multiply all fields
+    const unsigned stride = g.Nx()*n;
+    const unsigned col_begin = mm*stride*n + nn*n;
+    std::array<real_type,k> value{};
+    for( unsigned i=0; i<n; i++)
+        for( unsigned j=0; j<n; j++)
+        {
+            const real_type* vij = v + (col_begin + i*stride + j)*k;
+            if(negative)
+                for( unsigned f=0; f<k; f++)
+                    value[f] -= vij[f]*px[j]*py[i];
+            else
+                for( unsigned f=0; f<k; f++)
+                    value[f] += vij[f]*px[j]*py[i];
+        }
+    return value;
+}
+
+template<unsigned N, std::size_t k, class real_type>
+void interpolate_fields(
+    dg::space sp,
+    const real_type* v,
+    const thrust::host_vector<real_type>& x,
+    const thrust::host_vector<real_type>& y,
+    const aRealTopology2d<real_type>& g,
+    std::array<thrust::host_vector<real_type>,k>& result,
+    dg::bc bcx, dg::bc bcy)
+{
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif //_OPENMP
+    {
+    real_type buffer[4*20];
+#ifdef _OPENMP
+    #pragma omp for
+#endif //_OPENMP
+    for( int i=0; i<(int)x.size(); i++)
+    {
+        std::array<real_type,k> value = interpolate_fields<N,k>( sp, v, x[i],
+            y[i], g, bcx, bcy, buffer);
+        for( unsigned f=0; f<k; f++)
+            result[f][i] = value[f];
+    }
+    }
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Interpolate several vectors on a single point on a 2d Grid
+ *
+ * Equivalent to (and bitwise identical with) calling the single field \c
+ * dg::interpolate \c k times, but the point is located and the polynomials
+ * are evaluated only once and all fields are multiplied in one sweep.
+ * @code
+ * thrust::host_vector<double> v = dg::forward_transform(
+ *     std::array<thrust::host_vector<double>,2>{ v0, v1}, g);
+ * std::array<double,2> value = dg::interpolate<2>( dg::lspace, v, x, y, g);
+ * @endcode
+ * @tparam k number of fields
+ * @param sp Indicate whether the elements of the vector
+ * v are in xspace (nodal values) or lspace  (modal values)
+ * @param v The k vectors to interpolate interleaved: element \c i*k+j is
+ * element \c i of the j-th vector (s.a. dg::forward_transform( ) with \c std::array argument)
+ * @param x X-coordinate of interpolation point
+ * @param y Y-coordinate of interpolation point
+ * @param g The Grid on which to operate
+ * @copydoc hide_bcx_doc
+ * @param bcy analogous to \c bcx, applies to y direction
+ *
+ * @ingroup interpolation
+ * @return the k interpolated values
+ */
+template<std::size_t k, class real_type>
+std::array<real_type,k> interpolate(
+    dg::space sp,
+    const thrust::host_vector<real_type>& v,
+    real_type x, real_type y,
+    const aRealTopology2d<real_type>& g,
+    dg::bc bcx = dg::NEU, dg::bc bcy = dg::NEU )
+{
+    assert( v.size() == k*g.size());
+    const real_type* v_ptr = thrust::raw_pointer_cast( v.data());
+    real_type buffer[4*20];
+    if( g.n() == 1)
+        return detail::interpolate_fields<1,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+    else if( g.n() == 2)
+        return detail::interpolate_fields<2,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+    else if( g.n() == 3)
+        return detail::interpolate_fields<3,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+    else if( g.n() == 4)
+        return detail::interpolate_fields<4,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+    else if( g.n() == 5)
+        return detail::interpolate_fields<5,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+    return detail::interpolate_fields<0,k>( sp, v_ptr, x, y, g, bcx, bcy, buffer);
+}
+
+/**
+ * @brief Interpolate several vectors on a batch of points on a 2d Grid
+ *
+ * Same as calling the single point version of the multi-field \c dg::interpolate
+ * for every point (the points are distributed among OpenMP threads)
+ * @tparam k number of fields
+ * @param sp Indicate whether the elements of the vector
+ * v are in xspace (nodal values) or lspace  (modal values)
+ * @param v The k vectors to interpolate interleaved: element \c i*k+j is
+ * element \c i of the j-th vector (s.a. dg::forward_transform( ) with \c std::array argument)
+ * @param x X-coordinates of interpolation points
+ * @param y Y-coordinates of interpolation points (\c y.size() must equal \c x.size())
+ * @param g The Grid on which to operate
+ * @param result (write only) contains the interpolated values of field \c j
+ * in \c result[j] (each must have size \c x.size())
+ * @copydoc hide_bcx_doc
+ * @param bcy analogous to \c bcx, applies to y direction
+ *
+ * @ingroup interpolation
+ */
+template<std::size_t k, class real_type>
+void interpolate(
+    dg::space sp,
+    const thrust::host_vector<real_type>& v,
+    const thrust::host_vector<real_type>& x,
+    const thrust::host_vector<real_type>& y,
+    const aRealTopology2d<real_type>& g,
+    std::array<thrust::host_vector<real_type>,k>& result,
+    dg::bc bcx = dg::NEU, dg::bc bcy = dg::NEU )
+{
+    assert( v.size() == k*g.size());
+    assert( x.size() == y.size());
+    const real_type* v_ptr = thrust::raw_pointer_cast( v.data());
+    if( g.n() == 1)
+        detail::interpolate_fields<1,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+    else if( g.n() == 2)
+        detail::interpolate_fields<2,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+    else if( g.n() == 3)
+        detail::interpolate_fields<3,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+    else if( g.n() == 4)
+        detail::interpolate_fields<4,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+    else if( g.n() == 5)
+        detail::interpolate_fields<5,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+    else
+        detail::interpolate_fields<0,k>( sp, v_ptr, x, y, g, result, bcx, bcy);
+}
+
 } //namespace dg
@@ -59,6 +59,23 @@ int main()
         std::cout<< "2D TEST FAILED!\n";
     else
         std::cout << "2D TEST PASSED!\n";
+    //apply the same csr matrix to several vectors at once
+    cusp::csr_matrix<int, double, cusp::host_memory> Bcsr = B;
+    const thrust::host_vector<double> vec2 = dg::evaluate( dg::cooX2d, g);
+    thrust::host_vector<double> inter2(vec), inter3(vec), interB(vec), interB2(vec);
+    dg::blas2::symv( Bcsr, vec, inter2);
+    dg::blas2::symv( Bcsr, vec2, inter3);
+    std::vector<const thrust::host_vector<double>*> vecs{ &vec, &vec2};
+    std::vector<thrust::host_vector<double>*> inters{ &interB, &interB2};
+    dg::blas2::symv( Bcsr, vecs, inters);
+    dg::blas1::axpby( 1., inter2, -1., interB);
+    dg::blas1::axpby( 1., inter3, -1., interB2);
+    error = dg::blas1::dot( interB, interB) + dg::blas1::dot( interB2, interB2);
+    std::cout << "Batched error is "<<error<<" (should be exactly zero)!\n";
+    if( error != 0)
+        std::cout<< "2D BATCHED TEST FAILED!\n";
+    else
+        std::cout << "2D BATCHED TEST PASSED!\n";
 
 
     bool passed = true;
@@ -83,6 +100,31 @@ int main()
     }
     if( passed)
         std::cout << "2D INTERPOLATE TEST PASSED!\n";
+    //interpolate several fields at once
+    thrust::host_vector<double> xyF = dg::forward_transform(
+        std::array<thrust::host_vector<double>,2>{ xs, ys}, g);
+    thrust::host_vector<double> yF = dg::forward_transform( ys, g);
+    std::array<thrust::host_vector<double>,2> xys{ x, y};
+    dg::interpolate<2>( dg::lspace, xyF, x, y, g, xys, dg::DIR, dg::DIR);
+    for( unsigned i=0; i<x.size(); i++)
+    {
+        std::array<double,2> xyi = dg::interpolate<2>(dg::lspace, xyF, x[i],y[i], g, dg::DIR, dg::DIR);
+        double xi = dg::interpolate(dg::lspace, xF, x[i],y[i], g, dg::DIR, dg::DIR);
+        double yi = dg::interpolate(dg::lspace, yF, x[i],y[i], g, dg::DIR, dg::DIR);
+        double yX = dg::interpolate(dg::xspace, ys, x[i],y[i], g, dg::DIR, dg::DIR);
+        if( xyi[0] != xi || xys[0][i] != xi)
+        {
+            std::cerr << "X NOT EQUAL "<<i<<"\t"<<xi<<"  \t"<<xyi[0]<<"\n";
+            passed = false;
+        }
+        if( fabs( yX - xyi[1]) > 1e-14 || xyi[1] != yi || xys[1][i] != yi)
+        {
+            std::cerr << "Y NOT EQUAL "<<i<<"\t"<<yX<<"  \t"<<yi<<"  \t"<<xyi[1]<<"\n";
+            passed = false;
+        }
+    }
+    if( passed)
+        std::cout << "2D MULTI-FIELD INTERPOLATE TEST PASSED!\n";
     }
     {
     bool passed = true;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <map>
+#include <vector>
 #include "dg/backend/mpi_vector.h"
 #include "dg/enums.h"
 #include "grid.h"
@@ -26,6 +28,46 @@ template<class real_type>
 struct RealMPIGrid2d;
 template<class real_type>
 struct RealMPIGrid3d;
+
+namespace detail
+{
+//MPI_Finalize deletes the attributes of MPI_COMM_SELF before anything else
+inline int free_comms_attr( MPI_Comm, int, void* comms, void*)
+{
+    std::vector<MPI_Comm>& list = *static_cast<std::vector<MPI_Comm>*>(comms);
+    for( MPI_Comm& c : list)
+        MPI_Comm_free( &c);
+    list.clear();
+    return MPI_SUCCESS;
+}
+//Keep a communicator that the library created for itself until MPI_Finalize
+//(handles may be shared by copies of a grid, so they cannot be freed earlier)
+inline void free_at_finalize( MPI_Comm comm)
+{
+    static std::vector<MPI_Comm> comms;
+    static int keyval = MPI_KEYVAL_INVALID;
+    if( keyval == MPI_KEYVAL_INVALID)
+    {
+        MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, free_comms_attr, &keyval, nullptr);
+        MPI_Comm_set_attr( MPI_COMM_SELF, keyval, &comms);
+    }
+    comms.push_back( comm);
+}
+//The plane communicator of a three-dimensional Cartesian communicator;
+//only the first call for a given comm creates a new communicator
+inline MPI_Comm plane_comm( MPI_Comm comm)
+{
+    static std::map<MPI_Comm, MPI_Comm> plane_comms;
+    if( plane_comms.count( comm) == 1)
+        return plane_comms[comm];
+    int remain_dims[] = {true,true,false};
+    MPI_Comm planeComm;
+    MPI_Cart_sub( comm, remain_dims, &planeComm); //collective call
+    free_at_finalize( planeComm);
+    plane_comms[comm] = planeComm;
+    return planeComm;
+}
+}//namespace detail
 ///@endcond
 
 
@@ -190,6 +232,19 @@ struct aRealMPITopology2d
         do_set( new_n,new_Nx,new_Ny);
     }
     /**
+    * @brief Distribute the grid onto a different process grid
+    *
+    * The global grid remains unchanged while the local grid (and
+    * all data of derived classes) is recomputed
+    * @param new_comm a two-dimensional Cartesian communicator (must evenly divide the global cell numbers)
+    * @note used by \c dg::MultigridCG2d to agglomerate coarse grids onto fewer processes
+    */
+    void set_communicator( MPI_Comm new_comm){
+        comm = new_comm;
+        check_division( g.Nx(), g.Ny(), g.bcx(), g.bcy());
+        do_set( g.n(), g.Nx(), g.Ny());
+    }
+    /**
     * @brief Map a local index plus the PID to a global vector index
     *
     * @param localIdx a local vector index
@@ -507,6 +562,21 @@ struct aRealMPITopology3d
         if( new_n == g.n() && new_Nx == g.Nx() && new_Ny == g.Ny() && new_Nz == g.Nz()) return;
         do_set(new_n,new_Nx,new_Ny,new_Nz);
     }
+    /**
+    * @brief Distribute the grid onto a different process grid
+    *
+    * The global grid remains unchanged while the local grid (and
+    * all data of derived classes) is recomputed
+    * @param new_comm a three-dimensional Cartesian communicator (must evenly divide the global cell numbers)
+    * @note used by \c dg::MultigridCG2d to agglomerate coarse grids onto fewer processes
+    * @note the plane communicator is created only at the first call with a given \c new_comm and lives until \c MPI_Finalize
+    */
+    void set_communicator( MPI_Comm new_comm){
+        comm = new_comm;
+        check_division( g.Nx(), g.Ny(), g.Nz(), g.bcx(), g.bcy(), g.bcz());
+        planeComm = detail::plane_comm( comm);
+        do_set( g.n(), g.Nx(), g.Ny(), g.Nz());
+    }
     ///@copydoc aRealMPITopology2d::local2globalIdx(int,int,int&)const
     bool local2globalIdx( int localIdx, int PID, int& globalIdx)const
     {
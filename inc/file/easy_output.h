@@ -4,6 +4,7 @@
 #include <netcdf.h>
 #include "dg/topology/grid.h"
 #ifdef MPI_VERSION
+#include <netcdf_par.h>
 #include "dg/backend/mpi_vector.h"
 #include "dg/topology/mpi_grid.h"
 #endif //MPI_VERSION
@@ -120,7 +121,9 @@ struct NC_Error_Handle
 * or each process funnels its data through the master rank (\c false),
 * which involves communication but may be faster than the former method.
 * @attention In the MPI version (i) all processes must call this function and (ii) if \c parallel==true a **parallel netcdf** must be
-* linked, the file opened with the \c NC_MPIIO flag from the \c netcdf_par.h header and the variable be marked with \c NC_COLLECTIVE access while if \c parallel==false we need **serial netcdf** and only the master thread needs to open and access the file.
+* linked and all processes must have opened the file with \c nc_create_par or \c nc_open_par (cf. \c netcdf_par.h header) while if \c parallel==false we need **serial netcdf** and only the master thread needs to open and access the file.
+* In parallel mode the variable is marked for \c NC_COLLECTIVE access and every process writes its own local block as a hyperslab, so no process needs to hold the global field;
+* processes of the file communicator that are not part of the grid communicator must call \c put_vara_empty instead.
 * Note that serious performance penalties have been observed on some platforms for parallel netcdf.
 */
 template<class host_vector>
@@ -155,7 +158,9 @@ void put_var_double(int ncid, int varid, const dg::aTopology2d& grid,
 * or each process funnels its data through the master rank (\c false),
 * which involves communication but may be faster than the former method.
 * @attention In the MPI version (i) all processes must call this function and (ii) if \c parallel==true a **parallel netcdf** must be
-* linked, the file opened with the \c NC_MPIIO flag from the \c netcdf_par.h header and the variable be marked with \c NC_COLLECTIVE access while if \c parallel==false we need **serial netcdf** and only the master thread needs to open and access the file.
+* linked and all processes must have opened the file with \c nc_create_par or \c nc_open_par (cf. \c netcdf_par.h header) while if \c parallel==false we need **serial netcdf** and only the master thread needs to open and access the file.
+* In parallel mode the variable is marked for \c NC_COLLECTIVE access and every process writes its own local block as a hyperslab, so no process needs to hold the global field;
+* processes of the file communicator that are not part of the grid communicator must call \c put_vara_empty instead.
 * Note that serious performance penalties have been observed on some platforms for parallel netcdf.
 */
 template<class host_vector>
@@ -243,6 +248,7 @@ void put_var_double(int ncid, int varid, const dg::aMPITopology2d& grid,
         MPI_Cart_coords( comm, rank, 2, coords);
         start[0] = coords[1]*count[0],
         start[1] = coords[0]*count[1],
+        err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
         err = nc_put_vara_double( ncid, varid, start, count,
             data.data().data());
     }
@@ -269,6 +275,7 @@ void put_vara_double(int ncid, int varid, unsigned slice,
         MPI_Cart_coords( comm, rank, 2, coords);
         start[1] = coords[1]*count[1],
         start[2] = coords[0]*count[2],
+        err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
         err = nc_put_vara_double( ncid, varid, start, count,
             data.data().data());
     }
@@ -349,6 +356,7 @@ void put_var_double(int ncid, int varid,
         start[0] = coords[2]*count[0],
         start[1] = coords[1]*count[1],
         start[2] = coords[0]*count[2];
+        err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
         err = nc_put_vara_double( ncid, varid, start, count,
             data.data().data());
     }
@@ -377,6 +385,7 @@ void put_vara_double(int ncid, int varid, unsigned slice,
         start[1] = coords[2]*count[1],
         start[2] = coords[1]*count[2],
         start[3] = coords[0]*count[3];
+        err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
         err = nc_put_vara_double( ncid, varid, start, count,
             data.data().data());
     }
@@ -408,6 +417,28 @@ void put_vara_double(int ncid, int varid, unsigned slice,
         MPI_Barrier( comm);
     }
 }
+
+/**
+ * @brief Take part in a collective write of a variable without contributing data
+ *
+ * In parallel mode (cf. \c put_vara_double) all processes that opened the file
+ * must take part in every write. Processes that hold no data for \c varid,
+ * for example processes outside the first plane when a 2d field of a 3d
+ * computation is written, call this function instead.
+ * @param ncid Forwarded to \c nc_put_vara_double
+ * @param varid Forwarded to \c nc_put_vara_double
+ * @attention Only call this function for a file opened with parallel netcdf
+ */
+inline void put_vara_empty( int ncid, int varid)
+{
+    file::NC_Error_Handle err;
+    int ndims;
+    err = nc_inq_varndims( ncid, varid, &ndims);
+    std::vector<size_t> start( ndims, 0), count( ndims, 0);
+    double dummy;
+    err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
+    err = nc_put_vara_double( ncid, varid, start.data(), count.data(), &dummy);
+}
 #endif //MPI_VERSION
 
 ///@}
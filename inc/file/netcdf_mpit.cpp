@@ -30,19 +30,29 @@ int main(int argc, char* argv[])
     std::string hello = "Hello world\n";
     dg::MPI_Vector<thrust::host_vector<double>> data = dg::evaluate( function, grid);
 
+    //write with parallel netcdf if the program is called with "parallel"
+    bool parallel = ( argc > 1 && std::string( argv[1]) == "parallel");
+    if(rank==0)std::cout << "Write in "<<(parallel ? "parallel" : "serial")<<" mode\n";
+    //in parallel mode every process takes part in all file operations
+    bool master = (rank==0 || parallel);
     //create NetCDF File
     int ncid=0;
     dg::file::NC_Error_Handle err;
-    if(rank==0)err = nc_create( "testmpi.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
-    if(rank==0)err = nc_put_att_text( ncid, NC_GLOBAL, "input", hello.size(), hello.data());
+    if(parallel)
+        err = nc_create_par( "testmpi.nc", NC_NETCDF4|NC_MPIIO|NC_CLOBBER, MPI_COMM_WORLD, MPI_INFO_NULL, &ncid);
+    else if(rank==0)
+        err = nc_create( "testmpi.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+    if(master)err = nc_put_att_text( ncid, NC_GLOBAL, "input", hello.size(), hello.data());
 
     int dimids[4], tvarID;
-    if(rank==0)err = dg::file::define_dimensions( ncid, dimids, &tvarID, grid);
+    if(master)err = dg::file::define_dimensions( ncid, dimids, &tvarID, grid);
     int dataID;
-    if(rank==0)err = nc_def_var( ncid, "data", NC_DOUBLE, 4, dimids, &dataID);
+    if(master)err = nc_def_var( ncid, "data", NC_DOUBLE, 4, dimids, &dataID);
 
     /* Write metadata to file. */
-    if(rank==0)err = nc_enddef(ncid);
+    if(master)err = nc_enddef(ncid);
+    //writes to unlimited variables must be collective
+    if(parallel)err = nc_var_par_access( ncid, tvarID, NC_COLLECTIVE);
 
     size_t Tcount=1, Tstart=0;
     double time = 0;
@@ -55,10 +65,10 @@ int main(int argc, char* argv[])
         data = dg::evaluate( function, grid);
         dg::blas1::scal( data, cos( time));
         //write dataset (one timeslice)
-        dg::file::put_vara_double( ncid, dataID, i, grid, data, false);
-        if(rank==0)err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
+        dg::file::put_vara_double( ncid, dataID, i, grid, data, parallel);
+        if(master)err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
     }
-    if(rank==0)err = nc_close(ncid);
+    if(master)err = nc_close(ncid);
     MPI_Finalize();
     return 0;
 }
@@ -104,6 +104,18 @@ int main(int argc, char * argv[])
     ds( aligned, derivative);
     double norm = dg::blas2::dot(vol3d, derivative);
     std::cout << "# Norm Centered Derivative "<<sqrt( norm)<<" (compare with that of ds_mpit)\n";
+    ///##########################################################///
+    std::cout << "# TEST LOCKSTEP fieldline integration against single lines\n";
+    dg::geo::FieldalignedData data1 = dsFA.make_data( bhat, g3d, dg::NEU, dg::NEU, 1e-8, mx, my, -1, 1);
+    dg::geo::FieldalignedData data8 = dsFA.make_data( bhat, g3d, dg::NEU, dg::NEU, 1e-8, mx, my, -1, 8);
+    const dg::Grid2d g2d( R_0-a, R_0+a, -a, a, n, Nx, Ny);
+    dg::HVec hfun = dg::evaluate( init0, g2d), plus1( hfun), plus8( hfun);
+    dg::blas2::symv( data1.plus, hfun, plus1);
+    dg::blas2::symv( data8.plus, hfun, plus8);
+    dg::blas1::axpby( 1., data1.hp, -1., data8.hp);
+    dg::blas1::axpby( 1., plus1, -1., plus8);
+    std::cout << "    Difference hp:   "<<sqrt( dg::blas1::dot( data8.hp, data8.hp))<<" (compare with 1e-8)\n";
+    std::cout << "    Difference plus: "<<sqrt( dg::blas1::dot( plus8, plus8)/dg::blas1::dot( plus1, plus1))<<" (compare with 1e-8)\n";
 
     return 0;
 }
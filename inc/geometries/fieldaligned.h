@@ -1,6 +1,8 @@
 #pragma once
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <numeric>
 #include <cusp/csr_matrix.h>
 
 #include "dg/backend/transpose.h"
@@ -79,9 +81,9 @@ struct DSField
         dg::blas1::pointwiseDivide(v_zeta, v_phi, v_zeta);
         dg::blas1::pointwiseDivide(v_eta, v_phi, v_eta);
         dg::blas1::pointwiseDivide(1.,    v_phi, v_phi);
-        dzetadphi_  = dg::forward_transform( v_zeta, g );
-        detadphi_   = dg::forward_transform( v_eta, g );
-        dsdphi_     = dg::forward_transform( v_phi, g );
+        //interleave dzetadphi, detadphi and dsdphi
+        m_v = dg::forward_transform( std::array<thrust::host_vector<double>,3>{
+                v_zeta, v_eta, v_phi}, g);
     }
     //interpolate the vectors given in the constructor on the given point
     void operator()(double t, const std::array<double,3>& y, std::array<double,3>& yp) const
@@ -92,12 +94,10 @@ struct DSField
             return;
         }
         // else shift point into domain
-        yp[0] = interpolate(dg::lspace, dzetadphi_, y[0], y[1], *m_g);
-        yp[1] = interpolate(dg::lspace, detadphi_,  y[0], y[1], *m_g);
-        yp[2] = interpolate(dg::lspace, dsdphi_,    y[0], y[1], *m_g);
+        yp = dg::interpolate<3>( dg::lspace, m_v, y[0], y[1], *m_g);
     }
     private:
-    thrust::host_vector<double> dzetadphi_, detadphi_, dsdphi_;
+    thrust::host_vector<double> m_v;
     dg::ClonePtr<dg::aGeometry2d> m_g;
     bool m_in_box;
 };
@@ -107,7 +107,109 @@ real_type ds_norm( const std::array<real_type,3>& x0){
     return sqrt( x0[0]*x0[0] +x0[1]*x0[1] + x0[2]*x0[2]);
 }
 
+//Apply a DSField(Cylindrical) to a batch of points at once
+template<class Field>
+struct DSFieldBatch
+{
+    DSFieldBatch( const Field& field): m_field( field){}
+    void operator()( double t, const std::array<thrust::host_vector<double>,3>& y,
+        std::array<thrust::host_vector<double>,3>& yp) const
+    {
+        for( unsigned i=0; i<y[0].size(); i++)
+        {
+            std::array<double,3> yi{y[0][i], y[1][i], y[2][i]}, ypi;
+            m_field( t, yi, ypi);
+            yp[0][i] = ypi[0], yp[1][i] = ypi[1], yp[2][i] = ypi[2];
+        }
+    }
+    private:
+    const Field& m_field;
+};
+
+//the error of every single line in a batch must be smaller than the tolerance
+template<class real_type>
+real_type ds_batch_norm( const std::array<thrust::host_vector<real_type>,3>& x0){
+    real_type norm = 0;
+    for( unsigned i=0; i<x0[0].size(); i++)
+        norm = std::max( norm, ds_norm( std::array<real_type,3>{x0[0][i], x0[1][i], x0[2][i]}));
+    return norm;
+}
+
+/**
+ * Integrate the fieldlines starting at (y0[0][i], y0[1][i], y0[2][i]) from
+ * phi = 0 to phi = deltaPhi for all i with integrate[i] == true and store the
+ * end points in y1 and the number of adaptive steps in steps
+ *
+ * The lines are distributed among OpenMP threads with dynamic scheduling since
+ * lines close to the X-point need many more steps than the others.
+ * If batch_size > 1 consecutive lines are integrated in lockstep with a common
+ * step size, which amortizes the overhead of the timestepper per step
+ * at the price of taking as many steps as the worst line in the batch.
+ * Masked lines are skipped (y1 and steps are not written).
+ */
+template<class Field, class real_type>
+void integrate_fieldlines( const Field& field,
+    const std::array<thrust::host_vector<real_type>,3>& y0,
+    const thrust::host_vector<bool>& integrate,
+    std::array<thrust::host_vector<real_type>,3>& y1,
+    thrust::host_vector<unsigned>& steps,
+    real_type deltaPhi, real_type eps, unsigned batch_size)
+{
+    const int size = y0[0].size();
+    if( batch_size <= 1)
+    {
+#ifdef _OPENMP
+        #pragma omp parallel for schedule( dynamic, 8)
+#endif //_OPENMP
+        for( int i=0; i<size; i++)
+        {
+            if( !integrate[i])
+                continue;
+            std::array<real_type,3> coords{y0[0][i],y0[1][i],y0[2][i]}, coords1;
+            steps[i] = dg::integrateERK( "Dormand-Prince-7-4-5", field, 0.,
+                coords, deltaPhi, coords1, 0., dg::pid_control, ds_norm, eps,
+                1e-10);
+            y1[0][i] = coords1[0], y1[1][i] = coords1[1], y1[2][i] = coords1[2];
+        }
+        return;
+    }
+    DSFieldBatch<Field> batch_field( field);
+    const int num_batches = (size + batch_size - 1)/batch_size;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule( dynamic, 1)
+#endif //_OPENMP
+    for( int b=0; b<num_batches; b++)
+    {
+        std::vector<int> idx;
+        for( int i=b*batch_size; i<std::min<int>( size, (b+1)*batch_size); i++)
+            if( integrate[i])
+                idx.push_back( i);
+        if( idx.empty())
+            continue;
+        std::array<thrust::host_vector<real_type>,3> coords, coords1;
+        for( unsigned k=0; k<3; k++)
+        {
+            coords[k].resize( idx.size());
+            for( unsigned j=0; j<idx.size(); j++)
+                coords[k][j] = y0[k][idx[j]];
+        }
+        coords1 = coords;
+        unsigned number = dg::integrateERK( "Dormand-Prince-7-4-5",
+            batch_field, 0., coords, deltaPhi, coords1, 0., dg::pid_control,
+            ds_batch_norm<real_type>, eps, 1e-10);
+        for( unsigned j=0; j<idx.size(); j++)
+        {
+            for( unsigned k=0; k<3; k++)
+                y1[k][idx[j]] = coords1[k][j];
+            steps[idx[j]] = number;
+        }
+    }
+}
+
 //used in constructor of Fieldaligned
+//steps contains the total number of steps of the plus and minus integration of each line
+//only lines i with i%stride == offset are integrated, the output of all
+//other lines is zero (so that the results of several processes can be summed)
 template<class real_type>
 void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl0& vec,
     const dg::aRealGeometry2d<real_type>& grid_field,
@@ -118,7 +220,9 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl0& vec,
     thrust::host_vector<real_type>& ym2b,
     thrust::host_vector<bool>& in_boxp,
     thrust::host_vector<bool>& in_boxm,
-    real_type deltaPhi, real_type eps)
+    thrust::host_vector<unsigned>& steps,
+    real_type deltaPhi, real_type eps, unsigned batch_size = 1,
+    unsigned stride = 1, unsigned offset = 0)
 {
     //grid_field contains the global geometry for the field and the boundaries
     //grid_evaluate contains the points to actually integrate
@@ -128,63 +232,131 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl0& vec,
     y[2] = dg::evaluate( dg::zero, grid_evaluate); //s
     yp.fill(tmp); ym.fill(tmp); yp2b = ym2b = tmp; //allocate memory for output
     in_boxp.resize( tmp.size()), in_boxm.resize( tmp.size() );
+    const unsigned size = grid_evaluate.size();
+    thrust::host_vector<bool> mine( size);
+    for( unsigned i=0; i<size; i++)
+        mine[i] = ( i%stride == offset);
+    thrust::host_vector<unsigned> stepsP( size, 0), stepsM( size, 0);
+    std::array<thrust::host_vector<real_type>,3> yp2, ym2;
+    //field in case of cartesian grid
+    bool cartesian = ( nullptr != dynamic_cast<const dg::CartesianGrid2d*>( &grid_field));
+    {
     //construct field on high polynomial grid, then integrate it
     dg::geo::detail::DSField field( vec, grid_field, false);
-    //field in case of cartesian grid
     dg::geo::detail::DSFieldCylindrical cyl_field(vec, grid_field, false);
-    const unsigned size = grid_evaluate.size();
+    //x,y,s
+    if( cartesian)
+    {
+        integrate_fieldlines( cyl_field, y, mine, yp, stepsP, deltaPhi, eps, batch_size);
+        integrate_fieldlines( cyl_field, y, mine, ym, stepsM, -deltaPhi, eps, batch_size);
+    }
+    else
+    {
+        integrate_fieldlines( field, y, mine, yp, stepsP, deltaPhi, eps, batch_size);
+        integrate_fieldlines( field, y, mine, ym, stepsM, -deltaPhi, eps, batch_size);
+    }
+    }
     for( unsigned i=0; i<size; i++)
     {
-        std::array<real_type,3> coords{y[0][i],y[1][i],y[2][i]}, coordsP, coordsM;
-        //x,y,s
-        real_type phi1 = deltaPhi;
-        if( dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
-            dg::integrateERK( "Dormand-Prince-7-4-5", cyl_field, 0., coords, phi1, coordsP, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-        else
-            dg::integrateERK( "Dormand-Prince-7-4-5", field, 0., coords, phi1, coordsP, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-        phi1 =  - deltaPhi;
-        if( dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
-            dg::integrateERK( "Dormand-Prince-7-4-5", cyl_field, 0., coords, phi1, coordsM, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-        else
-            dg::integrateERK( "Dormand-Prince-7-4-5", field, 0., coords, phi1, coordsM, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-        yp[0][i] = coordsP[0], yp[1][i] = coordsP[1], yp[2][i] = coordsP[2];
-        ym[0][i] = coordsM[0], ym[1][i] = coordsM[1], ym[2][i] = coordsM[2];
         in_boxp[i] = grid_field.contains( yp[0][i], yp[1][i]) ? true : false;
         in_boxm[i] = grid_field.contains( ym[0][i], ym[1][i]) ? true : false;
     }
-    yp2b = yp[2], ym2b = ym[2];
+    steps.resize( size);
+    for( unsigned i=0; i<size; i++)
+        steps[i] = stepsP[i] + stepsM[i];
+    yp2 = yp, ym2 = ym;
     //Now integrate again but this time find the boundary distance
-    field = dg::geo::detail::DSField( vec, grid_field,true);
-    cyl_field = dg::geo::detail::DSFieldCylindrical(vec, grid_field, true);
+    thrust::host_vector<bool> outp( size), outm( size);
     for( unsigned i=0; i<size; i++)
+        outp[i] = mine[i] && !in_boxp[i], outm[i] = mine[i] && !in_boxm[i];
+    {
+    dg::geo::detail::DSField field( vec, grid_field, true);
+    dg::geo::detail::DSFieldCylindrical cyl_field(vec, grid_field, true);
+    if( cartesian)
     {
-        std::array<real_type,3> coords{y[0][i],y[1][i],y[2][i]}, coordsP, coordsM;
-        if( false == in_boxp[i])
+        integrate_fieldlines( cyl_field, y, outp, yp2, stepsP, deltaPhi, eps, batch_size);
+        integrate_fieldlines( cyl_field, y, outm, ym2, stepsM, -deltaPhi, eps, batch_size);
+    }
+    else
+    {
+        integrate_fieldlines( field, y, outp, yp2, stepsP, deltaPhi, eps, batch_size);
+        integrate_fieldlines( field, y, outm, ym2, stepsM, -deltaPhi, eps, batch_size);
+    }
+    }
+    for( unsigned i=0; i<size; i++)
+    {
+        if( outp[i]) steps[i] += stepsP[i];
+        if( outm[i]) steps[i] += stepsM[i];
+    }
+    yp2b = yp2[2], ym2b = ym2[2];
+    for( unsigned i=0; i<size; i++)
+        if( !mine[i])
         {
-            //x,y,s
-            real_type phi1 = deltaPhi;
-            if( dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
-                dg::integrateERK( "Dormand-Prince-7-4-5", cyl_field, 0., coords, phi1, coordsP, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-            else
-                dg::integrateERK( "Dormand-Prince-7-4-5", field, 0., coords, phi1, coordsP, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-            yp2b[i] = coordsP[2];
+            for( unsigned k=0; k<3; k++)
+                yp[k][i] = ym[k][i] = 0;
+            yp2b[i] = ym2b[i] = 0;
+            in_boxp[i] = in_boxm[i] = false;
+            steps[i] = 0;
         }
-        if( false == in_boxm[i])
-        {
-            real_type phi1 =  - deltaPhi;
-            if( dynamic_cast<const dg::CartesianGrid2d*>( &grid_field))
-                dg::integrateERK( "Dormand-Prince-7-4-5", cyl_field, 0., coords, phi1, coordsM, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-            else
-                dg::integrateERK( "Dormand-Prince-7-4-5", field, 0., coords, phi1, coordsM, 0., dg::pid_control, ds_norm, eps,1e-10); //integration
-            ym2b[i] = coordsM[2];
-        }
-    }
 }
 
 
 }//namespace detail
 ///@endcond
 
+/**
+ * @brief The data a \c Fieldaligned object is made of
+ *
+ * Integrating the fieldlines and creating the interpolation matrices is the
+ * expensive part of the construction of a \c Fieldaligned object. The result
+ * depends only on the vector field, the perpendicular grid, the boundary
+ * conditions and the numerical parameters \c eps, \c mx, \c my
+ * and \c deltaPhi and can thus be stored (e.g. in a file) and reused.
+ * All vectors have the (local) size of the perpendicular grid.
+ * @note In the MPI version the column indices of the matrices are global indices
+ * @ingroup fieldaligned
+ */
+struct FieldalignedData
+{
+    dg::IHMatrix plus;  //!< interpolation in next plane (local rows)
+    dg::IHMatrix minus; //!< interpolation in previous plane (local rows)
+    thrust::host_vector<double> hp;  //!< distance to next plane \f$ s_{k+1}-s_k\f$
+    thrust::host_vector<double> hm;  //!< negative distance to previous plane \f$ s_{k-1}-s_k\f$
+    thrust::host_vector<double> hbp; //!< distance to the boundary in plus direction
+    thrust::host_vector<double> hbm; //!< negative distance to the boundary in minus direction
+    thrust::host_vector<double> bbm; //!< 1 if fieldline intersects wall in minus but not in plus direction
+    thrust::host_vector<double> bbo; //!< 1 if fieldline intersects wall in both directions
+    thrust::host_vector<double> bbp; //!< 1 if fieldline intersects wall in plus but not in minus direction
+};
+
+///@cond
+namespace detail{
+template<class Geometry>
+void check_fieldaligned_bc( const Geometry& grid, dg::bc bcx, dg::bc bcy)
+{
+    if( (grid.bcx() == PER && bcx != PER) || (grid.bcx() != PER && bcx == PER) )
+        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting periodicity in x. The grid says "<<bc2str(grid.bcx())<<" while the parameter says "<<bc2str(bcx)));
+    if( (grid.bcy() == PER && bcy != PER) || (grid.bcy() != PER && bcy == PER) )
+        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting boundary conditions in y. The grid says "<<bc2str(grid.bcy())<<" while the parameter says "<<bc2str(bcy)));
+}
+inline void create_fieldaligned_masks( const thrust::host_vector<bool>& in_boxp,
+    const thrust::host_vector<bool>& in_boxm, FieldalignedData& data)
+{
+    data.bbm = thrust::host_vector<double>( in_boxp.size(), 0.);
+    data.bbo = data.bbp = data.bbm;
+    for( unsigned i=0; i<in_boxp.size(); i++)
+    {
+        if( !in_boxp[i] && !in_boxm[i])
+            data.bbo[i] = 1.;
+        else if( !in_boxp[i] && in_boxm[i])
+            data.bbp[i] = 1.;
+        else if( in_boxp[i] && !in_boxm[i])
+            data.bbm[i] = 1.;
+        // else all are 0
+    }
+}
+}//namespace detail
+///@endcond
 
     /*!@class hide_fieldaligned_physics_parameters
     * @tparam Limiter Class that can be evaluated on a 2d grid, returns 1 if there
@@ -204,6 +376,7 @@ void integrate_all_fieldlines2d( const dg::geo::CylindricalVectorLvl0& vec,
     * high as possible, 10 is a good start)
     * @param my analogous to \c mx, applies to y direction
     * @param deltaPhi Is either <0 (then it's ignored), or may differ from \c grid.hz() if \c grid.Nz()==1, then \c deltaPhi is taken instead of \c grid.hz()
+    * @param batch_size If > 1 this many consecutive fieldlines are integrated in lockstep with a common step size (see \c detail::integrate_fieldlines); 1 integrates every line with its own step size
     * @note If there is a limiter, the boundary condition on the first/last plane is set
         by the \c grid.bcz() variable and can be changed by the set_boundaries function.
         If there is no limiter, the boundary condition is periodic.
@@ -238,9 +411,9 @@ struct Fieldaligned
         Limiter limit = FullLimiter(),
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
-        double deltaPhi = -1):
+        double deltaPhi = -1, unsigned batch_size = 1):
             Fieldaligned( dg::geo::createBHat(vec),
-                grid, bcx, bcy, limit, eps, mx, my, deltaPhi)
+                grid, bcx, bcy, limit, eps, mx, my, deltaPhi, batch_size)
     {
     }
 
@@ -255,7 +428,47 @@ struct Fieldaligned
         Limiter limit = FullLimiter(),
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
-        double deltaPhi = -1);
+        double deltaPhi = -1, unsigned batch_size = 1):
+            Fieldaligned( make_data( vec, grid, bcx, bcy, eps, mx, my, deltaPhi, batch_size),
+                grid, bcx, bcy, limit)
+    {
+    }
+    /**
+     * @brief Construct from previously computed data (e.g. read from a cache)
+     *
+     * Only the interpolation matrices are transposed and the vectors are
+     * copied into all planes, no fieldlines are integrated
+     * @param data The result of \c make_data with the same \c grid, \c bcx and \c bcy
+     * @param grid The grid
+     * @param bcx boundary condition in x (must be the same as in \c make_data)
+     * @param bcy boundary condition in y (must be the same as in \c make_data)
+     * @param limit Instance of the limiter class
+     * @sa make_data
+     */
+    template <class Limiter>
+    Fieldaligned(const FieldalignedData& data,
+        const ProductGeometry& grid,
+        dg::bc bcx = dg::NEU,
+        dg::bc bcy = dg::NEU,
+        Limiter limit = FullLimiter());
+    /**
+     * @brief Integrate fieldlines and compute the data a \c Fieldaligned object is made of
+     *
+     * This is the expensive part of the construction
+     * @param vec The vector field to integrate
+     * @param grid The grid on which to integrate fieldlines.
+     * @param bcx boundary condition in x for the interpolation
+     * @param bcy boundary condition in y for the interpolation
+     * @copydoc hide_fieldaligned_numerics_parameters
+     * @return the data to construct a \c Fieldaligned object
+     */
+    static FieldalignedData make_data(const dg::geo::CylindricalVectorLvl0& vec,
+        const ProductGeometry& grid,
+        dg::bc bcx = dg::NEU,
+        dg::bc bcy = dg::NEU,
+        double eps = 1e-5,
+        unsigned mx=10, unsigned my=10,
+        double deltaPhi = -1, unsigned batch_size = 1);
     /**
     * @brief Perfect forward parameters to one of the constructors
     * @tparam Params deduced by the compiler
@@ -429,6 +642,8 @@ struct Fieldaligned
     *
     * @return the input interpolated onto the grid given in the constructor
     * @note the interpolation weights are taken in the phi distance not the s-distance, which makes the interpolation linear in phi
+    * @note Does not change the state of the object, so with a \c container of
+    * \c dg::SerialTag several threads may call this function concurrently
     */
     container interpolate_from_coarse_grid( const ProductGeometry& grid_coarse, const container& coarse);
     /**
@@ -437,6 +652,8 @@ struct Fieldaligned
     * @param grid_coarse The coarse grid (\c coarse_grid.Nz() must integer divide \c Nz from input grid) The x and y dimensions must be equal
     * @param coarse the 2d input vector
     * @param out the integral (2d vector)
+    * @note Does not change the state of the object, so with a \c container of
+    * \c dg::SerialTag several threads may call this function concurrently
     */
     void integrate_between_coarse_grid( const ProductGeometry& grid_coarse, const container& coarse, container& out );
     private:
@@ -469,28 +686,17 @@ struct Fieldaligned
 
 ////////////////////////////////////DEFINITIONS///////////////////////////////////////
 template<class Geometry, class IMatrix, class container>
-template <class Limiter>
-Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
+FieldalignedData Fieldaligned<Geometry, IMatrix, container>::make_data(
     const dg::geo::CylindricalVectorLvl0& vec, const Geometry& grid,
-    dg::bc bcx, dg::bc bcy, Limiter limit, double eps,
-    unsigned mx, unsigned my, double deltaPhi)
+    dg::bc bcx, dg::bc bcy, double eps,
+    unsigned mx, unsigned my, double deltaPhi, unsigned batch_size)
 {
     ///Let us check boundary conditions:
-    if( (grid.bcx() == PER && bcx != PER) || (grid.bcx() != PER && bcx == PER) )
-        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting periodicity in x. The grid says "<<bc2str(grid.bcx())<<" while the parameter says "<<bc2str(bcx)));
-    if( (grid.bcy() == PER && bcy != PER) || (grid.bcy() != PER && bcy == PER) )
-        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting boundary conditions in y. The grid says "<<bc2str(grid.bcy())<<" while the parameter says "<<bc2str(bcy)));
-    m_Nz=grid.Nz(), m_bcx = bcx, m_bcy = bcy, m_bcz=grid.bcz();
-    m_g.reset(grid);
+    detail::check_fieldaligned_bc( grid, bcx, bcy);
     if( deltaPhi <=0) deltaPhi = grid.hz();
     else assert( grid.Nz() == 1 || grid.hz()==deltaPhi);
     ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
     dg::ClonePtr<dg::aGeometry2d> grid_coarse( grid.perp_grid()) ;
-    ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
-    m_perp_size = grid_coarse->size();
-    dg::assign( dg::pullback(limit, *grid_coarse), m_limiter);
-    dg::assign( dg::evaluate(zero, *grid_coarse), m_left);
-    m_ghostM = m_ghostP = m_right = m_left;
     ///%%%%%%%%%%Set starting points and integrate field lines%%%%%%%%%%%//
 #ifdef DG_BENCHMARK
     dg::Timer t;
@@ -507,9 +713,19 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
     t.tic();
 #endif //DG_BENCHMARK
     thrust::host_vector<bool> in_boxp, in_boxm;
-    thrust::host_vector<double> hbp, hbm;
+    FieldalignedData data;
+    thrust::host_vector<unsigned> steps;
     detail::integrate_all_fieldlines2d( vec, *grid_magnetic, *grid_coarse,
-            yp_coarse, ym_coarse, hbp, hbm, in_boxp, in_boxm, deltaPhi, eps);
+            yp_coarse, ym_coarse, data.hbp, data.hbm, in_boxp, in_boxm, steps, deltaPhi, eps,
+            batch_size);
+#ifdef DG_BENCHMARK
+    {
+    unsigned min_steps = *std::min_element( steps.begin(), steps.end());
+    unsigned max_steps = *std::max_element( steps.begin(), steps.end());
+    double avg_steps = std::accumulate( steps.begin(), steps.end(), 0.)/(double)steps.size();
+    std::cout << "# DS: Steps per fieldline min/avg/max: "<<min_steps<<" "<<avg_steps<<" "<<max_steps<<"\n";
+    }
+#endif //DG_BENCHMARK
     dg::IHMatrix interpolate = dg::create::interpolation( grid_fine, *grid_coarse);  //INTERPOLATE TO FINE GRID
     yp.fill(dg::evaluate( dg::zero, grid_fine));
     ym = yp;
@@ -524,60 +740,71 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
     t.tic();
 #endif //DG_BENCHMARK
     ///%%%%%%%%%%%%%%%%Create interpolation and projection%%%%%%%%%%%%%%//
-    dg::IHMatrix plusFine  = dg::create::interpolation( yp[0], yp[1], *grid_coarse, bcx, bcy), plus, plusT;
-    dg::IHMatrix minusFine = dg::create::interpolation( ym[0], ym[1], *grid_coarse, bcx, bcy), minus, minusT;
+    dg::IHMatrix plusFine  = dg::create::interpolation( yp[0], yp[1], *grid_coarse, bcx, bcy);
+    dg::IHMatrix minusFine = dg::create::interpolation( ym[0], ym[1], *grid_coarse, bcx, bcy);
     if( mx == my && mx == 1)
     {
-        plus = plusFine;
-        minus = minusFine;
+        data.plus = plusFine;
+        data.minus = minusFine;
     }
     else
     {
         dg::IHMatrix projection = dg::create::projection( *grid_coarse, grid_fine);
-        cusp::multiply( projection, plusFine, plus);
-        cusp::multiply( projection, minusFine, minus);
+        cusp::multiply( projection, plusFine, data.plus);
+        cusp::multiply( projection, minusFine, data.minus);
     }
 #ifdef DG_BENCHMARK
     t.toc();
     std::cout << "# DS: Multiplication PI    took: "<<t.diff()<<"\n";
 #endif //DG_BENCHMARK
-    plusT = dg::transpose( plus);
-    minusT = dg::transpose( minus);
-    dg::blas2::transfer( plus, m_plus);
+    data.hp = yp_coarse[2], data.hm = ym_coarse[2];
+    detail::create_fieldaligned_masks( in_boxp, in_boxm, data);
+    return data;
+}
+
+template<class Geometry, class IMatrix, class container>
+template <class Limiter>
+Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
+    const FieldalignedData& data, const Geometry& grid,
+    dg::bc bcx, dg::bc bcy, Limiter limit)
+{
+    detail::check_fieldaligned_bc( grid, bcx, bcy);
+    m_Nz=grid.Nz(), m_bcx = bcx, m_bcy = bcy, m_bcz=grid.bcz();
+    m_g.reset(grid);
+    ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
+    dg::ClonePtr<dg::aGeometry2d> grid_coarse( grid.perp_grid()) ;
+    ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
+    m_perp_size = grid_coarse->size();
+    if( data.hp.size() != m_perp_size || (unsigned)data.plus.num_rows != m_perp_size)
+        throw dg::Error( dg::Message(_ping_)<<"Fieldaligned: data of size "<<data.hp.size()<<" does not fit to grid of size "<<m_perp_size);
+    dg::assign( dg::pullback(limit, *grid_coarse), m_limiter);
+    dg::assign( dg::evaluate(zero, *grid_coarse), m_left);
+    m_ghostM = m_ghostP = m_right = m_left;
+    dg::IHMatrix plusT = dg::transpose( data.plus);
+    dg::IHMatrix minusT = dg::transpose( data.minus);
+    dg::blas2::transfer( data.plus, m_plus);
     dg::blas2::transfer( plusT, m_plusT);
-    dg::blas2::transfer( minus, m_minus);
+    dg::blas2::transfer( data.minus, m_minus);
     dg::blas2::transfer( minusT, m_minusT);
     ///%%%%%%%%%%%%%%%%%%%%copy into h vectors %%%%%%%%%%%%%%%%%%%//
     dg::assign( dg::evaluate( dg::zero, grid), m_hm);
     m_temp  = dg::split( m_hm, grid); //3d vector
     m_f     = dg::split( (const container&)m_hm, grid);
     m_hbp = m_hbm = m_hp = m_hm;
-    dg::assign( yp_coarse[2], m_hp2d); //2d vector
-    dg::assign( ym_coarse[2], m_hm2d); //2d vector
-    assign3dfrom2d( hbp, m_hbp, grid);
-    assign3dfrom2d( hbm, m_hbm, grid);
-    assign3dfrom2d( yp_coarse[2], m_hp, grid);
-    assign3dfrom2d( ym_coarse[2], m_hm, grid);
+    dg::assign( data.hp, m_hp2d); //2d vector
+    dg::assign( data.hm, m_hm2d); //2d vector
+    assign3dfrom2d( data.hbp, m_hbp, grid);
+    assign3dfrom2d( data.hbm, m_hbm, grid);
+    assign3dfrom2d( data.hp, m_hp, grid);
+    assign3dfrom2d( data.hm, m_hm, grid);
     dg::blas1::scal( m_hm2d, -1.);
     dg::blas1::scal( m_hbm, -1.);
     dg::blas1::scal( m_hm, -1.);
-
     ///%%%%%%%%%%%%%%%%%%%%create mask vectors %%%%%%%%%%%%%%%%%%%//
-    thrust::host_vector<double> bbm( in_boxp.size(),0.), bbo(bbm), bbp(bbm);
-    for( unsigned i=0; i<in_boxp.size(); i++)
-    {
-        if( !in_boxp[i] && !in_boxm[i])
-            bbo[i] = 1.;
-        else if( !in_boxp[i] && in_boxm[i])
-            bbp[i] = 1.;
-        else if( in_boxp[i] && !in_boxm[i])
-            bbm[i] = 1.;
-        // else all are 0
-    }
     m_bbm = m_bbo = m_bbp = m_hm;
-    assign3dfrom2d( bbm, m_bbm, grid);
-    assign3dfrom2d( bbo, m_bbo, grid);
-    assign3dfrom2d( bbp, m_bbp, grid);
+    assign3dfrom2d( data.bbm, m_bbm, grid);
+    assign3dfrom2d( data.bbo, m_bbo, grid);
+    assign3dfrom2d( data.bbp, m_bbp, grid);
 }
 
 template<class G, class I, class container>
@@ -660,16 +887,17 @@ container Fieldaligned<G, I,container>::interpolate_from_coarse_grid( const G& g
 
     container out = dg::evaluate( dg::zero, *m_g);
     container helper = dg::evaluate( dg::zero, *m_g);
-    dg::split( helper, m_temp, *m_g);
+    //use local views (and not m_temp) so that several threads may call this function
+    std::vector<dg::View< container>> helper_split = dg::split( helper, *m_g);
     std::vector<dg::View< container>> out_split = dg::split( out, *m_g);
     std::vector<dg::View< const container>> in_split = dg::split( in, grid);
     for ( int i=0; i<(int)Nz_coarse; i++)
     {
         //1. copy input vector to appropriate place in output
         dg::blas1::copy( in_split[i], out_split[i*cphi]);
-        dg::blas1::copy( in_split[i], m_temp[i*cphi]);
+        dg::blas1::copy( in_split[i], helper_split[i*cphi]);
     }
-    //Step 1 needs to finish so that m_temp contains values everywhere
+    //Step 1 needs to finish so that helper contains values everywhere
     //2. Now apply plus and minus T to fill in the rest
     for ( int i=0; i<(int)Nz_coarse; i++)
     {
@@ -678,7 +906,7 @@ container Fieldaligned<G, I,container>::interpolate_from_coarse_grid( const G& g
             //!!! The value of f at the plus plane is I^- of the current plane
             dg::blas2::symv( m_minus, out_split[i*cphi+j-1], out_split[i*cphi+j]);
             //!!! The value of f at the minus plane is I^+ of the current plane
-            dg::blas2::symv( m_plus, m_temp[(i*cphi+cphi+1-j)%Nz], m_temp[i*cphi+cphi-j]);
+            dg::blas2::symv( m_plus, helper_split[(i*cphi+cphi+1-j)%Nz], helper_split[i*cphi+cphi-j]);
         }
     }
     //3. Now add up with appropriate weights
@@ -687,7 +915,7 @@ container Fieldaligned<G, I,container>::interpolate_from_coarse_grid( const G& g
         {
             double alpha = (double)(cphi-j)/(double)cphi;
             double beta = (double)j/(double)cphi;
-            dg::blas1::axpby( alpha, out_split[i*cphi+j], beta, m_temp[i*cphi+j], out_split[i*cphi+j]);
+            dg::blas1::axpby( alpha, out_split[i*cphi+j], beta, helper_split[i*cphi+j], out_split[i*cphi+j]);
         }
     return out;
 }
@@ -729,12 +957,16 @@ void Fieldaligned<G, I, container>::ePlus( enum whichMatrix which, const contain
     dg::split( f, m_f, *m_g);
     dg::split( fpe, m_temp, *m_g);
     //1. compute 2d interpolation in every plane and store in m_temp
+    //   (the matrix is applied to all planes in one sweep)
+    std::vector<const dg::View<const container>*> f_ptr( m_Nz);
+    std::vector<dg::View<container>*> temp_ptr( m_Nz);
     for( unsigned i0=0; i0<m_Nz; i0++)
     {
         unsigned ip = (i0==m_Nz-1) ? 0:i0+1;
-        if(which == einsPlus)           dg::blas2::symv( m_plus,   m_f[ip], m_temp[i0]);
-        else if(which == einsMinusT)    dg::blas2::symv( m_minusT, m_f[ip], m_temp[i0]);
+        f_ptr[i0] = &m_f[ip], temp_ptr[i0] = &m_temp[i0];
     }
+    if(which == einsPlus)           dg::blas2::symv( m_plus,   f_ptr, temp_ptr);
+    else if(which == einsMinusT)    dg::blas2::symv( m_minusT, f_ptr, temp_ptr);
     //2. apply right boundary conditions in last plane
     unsigned i0=m_Nz-1;
     if( m_bcz != dg::PER)
@@ -758,12 +990,16 @@ void Fieldaligned<G, I, container>::eMinus( enum whichMatrix which, const contai
     dg::split( f, m_f, *m_g);
     dg::split( fme, m_temp, *m_g);
     //1. compute 2d interpolation in every plane and store in m_temp
+    //   (the matrix is applied to all planes in one sweep)
+    std::vector<const dg::View<const container>*> f_ptr( m_Nz);
+    std::vector<dg::View<container>*> temp_ptr( m_Nz);
     for( unsigned i0=0; i0<m_Nz; i0++)
     {
         unsigned im = (i0==0) ? m_Nz-1:i0-1;
-        if(which == einsPlusT)          dg::blas2::symv( m_plusT, m_f[im], m_temp[i0]);
-        else if (which == einsMinus)    dg::blas2::symv( m_minus, m_f[im], m_temp[i0]);
+        f_ptr[i0] = &m_f[im], temp_ptr[i0] = &m_temp[i0];
     }
+    if(which == einsPlusT)          dg::blas2::symv( m_plusT, f_ptr, temp_ptr);
+    else if (which == einsMinus)    dg::blas2::symv( m_minus, f_ptr, temp_ptr);
     //2. apply left boundary conditions in first plane
     unsigned i0=0;
     if( m_bcz != dg::PER)
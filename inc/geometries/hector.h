@@ -29,27 +29,24 @@ struct Interpolate
     Interpolate( const thrust::host_vector<real_type>& fZeta,
                  const thrust::host_vector<real_type>& fEta,
                  const dg::aTopology2d& g2d ):
-        iter0_( dg::forward_transform( fZeta, g2d) ),
-        iter1_( dg::forward_transform(  fEta, g2d) ),
+        iter_( dg::forward_transform( std::array<thrust::host_vector<real_type>,2>{
+                    fZeta, fEta}, g2d) ),
         g_(g2d), zeta1_(g2d.x1()), eta1_(g2d.y1()){}
     void operator()(real_type t, const thrust::host_vector<real_type>& zeta, thrust::host_vector<real_type>& fZeta)
     {
-        fZeta[0] = interpolate( dg::lspace, iter0_, fmod( zeta[0]+zeta1_, zeta1_), fmod( zeta[1]+eta1_, eta1_), g_);
-        fZeta[1] = interpolate( dg::lspace, iter1_, fmod( zeta[0]+zeta1_, zeta1_), fmod( zeta[1]+eta1_, eta1_), g_);
-        //fZeta[0] = interpolate(  zeta[0], zeta[1], iter0_, g_);
-        //fZeta[1] = interpolate(  zeta[0], zeta[1], iter1_, g_);
+        std::array<real_type,2> f = dg::interpolate<2>( dg::lspace, iter_, fmod( zeta[0]+zeta1_, zeta1_), fmod( zeta[1]+eta1_, eta1_), g_);
+        fZeta[0] = f[0], fZeta[1] = f[1];
     }
     void operator()(real_type t, const std::array<thrust::host_vector<real_type>,2 >& zeta, std::array< thrust::host_vector<real_type>,2 >& fZeta)
     {
         for( unsigned i=0; i<zeta[0].size(); i++)
         {
-            fZeta[0][i] = interpolate( dg::lspace, iter0_, fmod( zeta[0][i]+zeta1_, zeta1_), fmod( zeta[1][i]+eta1_, eta1_), g_);
-            fZeta[1][i] = interpolate( dg::lspace, iter1_, fmod( zeta[0][i]+zeta1_, zeta1_), fmod( zeta[1][i]+eta1_, eta1_), g_);
+            std::array<real_type,2> f = dg::interpolate<2>( dg::lspace, iter_, fmod( zeta[0][i]+zeta1_, zeta1_), fmod( zeta[1][i]+eta1_, eta1_), g_);
+            fZeta[0][i] = f[0], fZeta[1][i] = f[1];
         }
     }
     private:
-    thrust::host_vector<real_type> iter0_;
-    thrust::host_vector<real_type> iter1_;
+    thrust::host_vector<real_type> iter_; //interleaved
     dg::RealGrid2d<real_type> g_;
     real_type zeta1_, eta1_;
 };
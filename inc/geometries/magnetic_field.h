@@ -147,6 +147,34 @@ struct MagneticFieldParameters
     description m_description;
 };
 
+/**
+ * @brief The values of \f$ \psi_p\f$, its first and second derivatives and of \f$ I\f$ and its first derivatives at a point
+ * @sa dg::geo::TokamakMagneticField::evaluate
+ */
+struct MagneticFieldValues
+{
+    double psip, //!< \f$ \psi_p\f$
+           psipR, //!< \f$ \partial_R\psi_p\f$
+           psipZ, //!< \f$ \partial_Z\psi_p\f$
+           psipRR, //!< \f$ \partial_R\partial_R\psi_p\f$
+           psipRZ, //!< \f$ \partial_R\partial_Z\psi_p\f$
+           psipZZ, //!< \f$ \partial_Z\partial_Z\psi_p\f$
+           ipol, //!< \f$ I\f$
+           ipolR, //!< \f$ \partial_R I\f$
+           ipolZ; //!< \f$ \partial_Z I\f$
+};
+
+/**
+ * @brief Fused evaluation of all flux functions of a magnetic field
+ *
+ * Signature <tt> void ( unsigned size, const double* R, const double* Z, MagneticFieldValues* values) </tt>:
+ * for \c i<size write the values at \c (R[i],Z[i]) into \c values[i]
+ * @note Equilibria that share sub-expressions (like logarithms or powers of
+ * R and Z) among \f$ \psi_p\f$ and its derivatives provide such an evaluator that
+ * computes these only once per point, see e.g. \c dg::geo::solovev::Evaluator
+ */
+using MagneticFieldEvaluator = std::function<void(unsigned, const double*, const double*, MagneticFieldValues*)>;
+
 /**
 * @brief A tokamak field as given by R0, Psi and Ipol plus Meta-data like shape and equilibrium
 
@@ -165,6 +193,20 @@ struct TokamakMagneticField
     TokamakMagneticField( double R0, const CylindricalFunctorsLvl2& psip, const
             CylindricalFunctorsLvl1& ipol , MagneticFieldParameters gp
             ): m_R0(R0), m_psip(psip), m_ipol(ipol), m_params(gp){}
+    /**
+     * @brief Construct with a fused evaluator
+     *
+     * @param R0 \f$ R_0\f$
+     * @param psip the flux function and its derivatives
+     * @param ipol the current and its derivatives
+     * @param gp Meta-data
+     * @param eval computes the same values as \c psip and \c ipol for many points in one pass (used in \c evaluate)
+     */
+    TokamakMagneticField( double R0, const CylindricalFunctorsLvl2& psip, const
+            CylindricalFunctorsLvl1& ipol , MagneticFieldParameters gp,
+            const MagneticFieldEvaluator& eval
+            ): m_R0(R0), m_psip(psip), m_ipol(ipol), m_params(gp), m_eval(eval){}
+    ///@note resets the fused evaluator
     void set( double R0, const CylindricalFunctorsLvl2& psip, const
             CylindricalFunctorsLvl1& ipol , MagneticFieldParameters gp)
     {
@@ -172,6 +214,7 @@ struct TokamakMagneticField
         m_psip=psip;
         m_ipol=ipol;
         m_params = gp;
+        m_eval = nullptr;
     }
     /// \f$ R_0 \f$
     double R0()const {return m_R0;}
@@ -203,11 +246,56 @@ struct TokamakMagneticField
      */
     const MagneticFieldParameters& params() const{return m_params;}
 
+    /**
+     * @brief Evaluate \f$ \psi_p\f$, all its derivatives and \f$ I\f$ and its derivatives at many points in one pass
+     *
+     * Uses the fused evaluator if the field was constructed with one and calls every
+     * functor in turn else.
+     * @param size number of points
+     * @param R R-coordinates of the points (of size \c size)
+     * @param Z Z-coordinates of the points (of size \c size)
+     * @param values (write only) contains the values at the points on output (of size \c size)
+     */
+    void evaluate( unsigned size, const double* R, const double* Z, MagneticFieldValues* values) const
+    {
+        if( m_eval)
+        {
+            m_eval( size, R, Z, values);
+            return;
+        }
+        for( unsigned i=0; i<size; i++)
+        {
+            values[i].psip   = m_psip.f()(R[i], Z[i]);
+            values[i].psipR  = m_psip.dfx()(R[i], Z[i]);
+            values[i].psipZ  = m_psip.dfy()(R[i], Z[i]);
+            values[i].psipRR = m_psip.dfxx()(R[i], Z[i]);
+            values[i].psipRZ = m_psip.dfxy()(R[i], Z[i]);
+            values[i].psipZZ = m_psip.dfyy()(R[i], Z[i]);
+            values[i].ipol   = m_ipol.f()(R[i], Z[i]);
+            values[i].ipolR  = m_ipol.dfx()(R[i], Z[i]);
+            values[i].ipolZ  = m_ipol.dfy()(R[i], Z[i]);
+        }
+    }
+    /**
+     * @brief Evaluate \f$ \psi_p\f$, all its derivatives and \f$ I\f$ and its derivatives at one point
+     *
+     * @param R R-coordinate
+     * @param Z Z-coordinate
+     * @return all values at \c (R,Z)
+     */
+    MagneticFieldValues evaluate( double R, double Z) const
+    {
+        MagneticFieldValues values;
+        evaluate( 1, &R, &Z, &values);
+        return values;
+    }
+
     private:
     double m_R0;
     CylindricalFunctorsLvl2 m_psip;
     CylindricalFunctorsLvl1 m_ipol;
     MagneticFieldParameters m_params;
+    MagneticFieldEvaluator m_eval;
 };
 
 ///@cond
@@ -241,6 +329,7 @@ static inline CylindricalFunctorsLvl2 periodify( const CylindricalFunctorsLvl2&
  * @param bcx boundary condition in x (determines how function is periodified)
  * @param bcy boundary condition in y (determines how function is periodified)
  * @attention So far this was only tested for Neumann boundary conditions. It is uncertain if Dirichlet boundary conditions work
+ * @note The returned field has no fused evaluator
  *
  * @return new periodified magnetic field
  */
@@ -252,6 +341,31 @@ static inline TokamakMagneticField periodify( const TokamakMagneticField& mag, d
             periodify( mag.get_ipol(), R0, R1, Z0, Z1, bcx, bcy), mag.params());
 }
 
+///@cond
+namespace detail{
+// The following compute derived quantities from the values of a single
+// evaluation of the field such that every functor needs only one
+inline double invB( double R0, double R, const MagneticFieldValues& v)
+{
+    return R/(R0*sqrt(v.ipol*v.ipol + v.psipR*v.psipR +v.psipZ*v.psipZ)) ;
+}
+inline double bR( double R0, double R, double invB, const MagneticFieldValues& v)
+{
+    double Rn = R/R0;
+    return -1./R/invB + invB/Rn/Rn*(v.ipol*v.ipolR + v.psipR*v.psipRR + v.psipZ*v.psipRZ);
+}
+inline double bZ( double R0, double R, double invB, const MagneticFieldValues& v)
+{
+    double Rn = R/R0;
+    return (invB/Rn/Rn)*(v.ipol*v.ipolZ + v.psipR*v.psipRZ + v.psipZ*v.psipZZ);
+}
+inline double gradLnB( double R0, double R, double invB, const MagneticFieldValues& v)
+{
+    return R0*invB*invB*(bR(R0,R,invB,v)*v.psipZ-bZ(R0,R,invB,v)*v.psipR)/R ;
+}
+}//namespace detail
+///@endcond
+
 ///@brief \f$   |B| = R_0\sqrt{I^2+(\nabla\psi)^2}/R   \f$
 struct Bmodule : public aCylindricalFunctor<Bmodule>
 {
@@ -315,15 +429,13 @@ struct LnB : public aCylindricalFunctor<LnB>
  */
 struct BR: public aCylindricalFunctor<BR>
 {
-    BR(const TokamakMagneticField& mag): m_invB(mag), m_mag(mag) { }
+    BR(const TokamakMagneticField& mag): m_mag(mag) { }
     double do_compute(double R, double Z) const
     {
-        double Rn;
-        Rn = R/m_mag.R0();
-        return -1./R/m_invB(R,Z) + m_invB(R,Z)/Rn/Rn*(m_mag.ipol()(R,Z)*m_mag.ipolR()(R,Z) + m_mag.psipR()(R,Z)*m_mag.psipRR()(R,Z) + m_mag.psipZ()(R,Z)*m_mag.psipRZ()(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        return detail::bR( m_mag.R0(), R, detail::invB( m_mag.R0(), R, v), v);
     }
   private:
-    InvB m_invB;
     TokamakMagneticField m_mag;
 };
 
@@ -337,16 +449,14 @@ struct BR: public aCylindricalFunctor<BR>
  */
 struct BZ: public aCylindricalFunctor<BZ>
 {
-    BZ(const TokamakMagneticField& mag ): m_mag(mag), m_invB(mag) { }
+    BZ(const TokamakMagneticField& mag ): m_mag(mag) { }
     double do_compute(double R, double Z) const
     {
-        double Rn;
-        Rn = R/m_mag.R0();
-        return (m_invB(R,Z)/Rn/Rn)*(m_mag.ipol()(R,Z)*m_mag.ipolZ()(R,Z) + m_mag.psipR()(R,Z)*m_mag.psipRZ()(R,Z) + m_mag.psipZ()(R,Z)*m_mag.psipZZ()(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        return detail::bZ( m_mag.R0(), R, detail::invB( m_mag.R0(), R, v), v);
     }
   private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
 };
 
 ///@brief Approximate \f$ \mathcal{K}^{R}_{\nabla B} \f$
@@ -355,7 +465,7 @@ struct BZ: public aCylindricalFunctor<BZ>
 ///@copydoc hide_toroidal_approximation_note
 struct CurvatureNablaBR: public aCylindricalFunctor<CurvatureNablaBR>
 {
-    CurvatureNablaBR(const TokamakMagneticField& mag, int sign): m_invB(mag), m_bZ(mag) {
+    CurvatureNablaBR(const TokamakMagneticField& mag, int sign): m_mag(mag) {
         if( sign >0)
             m_sign = +1.;
         else
@@ -363,12 +473,13 @@ struct CurvatureNablaBR: public aCylindricalFunctor<CurvatureNablaBR>
     }
     double do_compute( double R, double Z) const
     {
-        return -m_sign*m_invB(R,Z)*m_invB(R,Z)*m_bZ(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_mag.R0(), R, v);
+        return -m_sign*invB*invB*detail::bZ( m_mag.R0(), R, invB, v);
     }
     private:
     double m_sign;
-    InvB m_invB;
-    BZ m_bZ;
+    TokamakMagneticField m_mag;
 };
 
 ///@brief Approximate \f$  \mathcal{K}^{Z}_{\nabla B}  \f$
@@ -377,7 +488,7 @@ struct CurvatureNablaBR: public aCylindricalFunctor<CurvatureNablaBR>
 ///@copydoc hide_toroidal_approximation_note
 struct CurvatureNablaBZ: public aCylindricalFunctor<CurvatureNablaBZ>
 {
-    CurvatureNablaBZ( const TokamakMagneticField& mag, int sign): m_invB(mag), m_bR(mag) {
+    CurvatureNablaBZ( const TokamakMagneticField& mag, int sign): m_mag(mag) {
         if( sign >0)
             m_sign = +1.;
         else
@@ -385,12 +496,13 @@ struct CurvatureNablaBZ: public aCylindricalFunctor<CurvatureNablaBZ>
     }
     double do_compute( double R, double Z) const
     {
-        return m_sign*m_invB(R,Z)*m_invB(R,Z)*m_bR(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_mag.R0(), R, v);
+        return m_sign*invB*invB*detail::bR( m_mag.R0(), R, invB, v);
     }
     private:
     double m_sign;
-    InvB m_invB;
-    BR m_bR;
+    TokamakMagneticField m_mag;
 };
 
 ///@brief Approximate \f$ \mathcal{K}^{R}_{\vec{\kappa}}=0 \f$
@@ -435,7 +547,7 @@ struct CurvatureKappaZ: public aCylindricalFunctor<CurvatureKappaZ>
 ///@copydoc hide_toroidal_approximation_note
 struct DivCurvatureKappa: public aCylindricalFunctor<DivCurvatureKappa>
 {
-    DivCurvatureKappa( const TokamakMagneticField& mag, int sign): m_invB(mag), m_bZ(mag){
+    DivCurvatureKappa( const TokamakMagneticField& mag, int sign): m_mag(mag){
         if( sign >0)
             m_sign = +1.;
         else
@@ -443,12 +555,13 @@ struct DivCurvatureKappa: public aCylindricalFunctor<DivCurvatureKappa>
     }
     double do_compute( double R, double Z) const
     {
-        return m_sign*m_bZ(R,Z)*m_invB(R,Z)*m_invB(R,Z)/R;
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_mag.R0(), R, v);
+        return m_sign*detail::bZ( m_mag.R0(), R, invB, v)*invB*invB/R;
     }
     private:
     double m_sign;
-    InvB m_invB;
-    BZ m_bZ;
+    TokamakMagneticField m_mag;
 };
 
 ///@brief Approximate \f$  \vec{\nabla}\cdot \mathcal{K}_{\nabla B}  \f$
@@ -470,17 +583,16 @@ struct DivCurvatureNablaB: public aCylindricalFunctor<DivCurvatureNablaB>
 /// \f$ \mathcal{K}^R_{\nabla B} =-\frac{R_0I}{ B^3R}  \frac{\partial B}{\partial Z}  \f$
 struct TrueCurvatureNablaBR: public aCylindricalFunctor<TrueCurvatureNablaBR>
 {
-    TrueCurvatureNablaBR(const TokamakMagneticField& mag): m_R0(mag.R0()), m_mag(mag), m_invB(mag), m_bZ(mag) { }
+    TrueCurvatureNablaBR(const TokamakMagneticField& mag): m_R0(mag.R0()), m_mag(mag) { }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z), ipol = m_mag.ipol()(R,Z);
-        return -invB*invB*invB*ipol*m_R0/R*m_bZ(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_R0, R, v);
+        return -invB*invB*invB*v.ipol*m_R0/R*detail::bZ( m_R0, R, invB, v);
     }
     private:
     double m_R0;
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BZ m_bZ;
 };
 
 ///@brief True \f$ \mathcal{K}^{Z}_{\nabla B} \f$
@@ -488,17 +600,16 @@ struct TrueCurvatureNablaBR: public aCylindricalFunctor<TrueCurvatureNablaBR>
 /// \f$ \mathcal{K}^Z_{\nabla B} =\frac{R_0I}{ B^3R}  \frac{\partial B}{\partial R}  \f$
 struct TrueCurvatureNablaBZ: public aCylindricalFunctor<TrueCurvatureNablaBZ>
 {
-    TrueCurvatureNablaBZ(const TokamakMagneticField& mag): m_R0(mag.R0()), m_mag(mag), m_invB(mag), m_bR(mag) { }
+    TrueCurvatureNablaBZ(const TokamakMagneticField& mag): m_R0(mag.R0()), m_mag(mag) { }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z), ipol = m_mag.ipol()(R,Z);
-        return invB*invB*invB*ipol*m_R0/R*m_bR(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_R0, R, v);
+        return invB*invB*invB*v.ipol*m_R0/R*detail::bR( m_R0, R, invB, v);
     }
     private:
     double m_R0;
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
 };
 
 ///@brief True \f$ \mathcal{K}^{\varphi}_{\nabla B} \f$
@@ -506,80 +617,72 @@ struct TrueCurvatureNablaBZ: public aCylindricalFunctor<TrueCurvatureNablaBZ>
 /// \f$ \mathcal{K}^\varphi_{\nabla B} =\frac{1}{ B^3R^2}\left( \frac{\partial\psi}{\partial Z} \frac{\partial B}{\partial Z} + \frac{\partial \psi}{\partial R}\frac{\partial B}{\partial R} \right) \f$
 struct TrueCurvatureNablaBP: public aCylindricalFunctor<TrueCurvatureNablaBP>
 {
-    TrueCurvatureNablaBP(const TokamakMagneticField& mag): m_mag(mag), m_invB(mag),m_bR(mag), m_bZ(mag) { }
+    TrueCurvatureNablaBP(const TokamakMagneticField& mag): m_mag(mag) { }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB*invB/R/R*(m_mag.psipZ()(R,Z)*m_bZ(R,Z) + m_mag.psipR()(R,Z)*m_bR(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        return R0*invB*invB*invB/R/R*(v.psipZ*detail::bZ( R0, R, invB, v) + v.psipR*detail::bR( R0, R, invB, v));
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
-    BZ m_bZ;
 };
 
 ///@brief True \f$ \mathcal{K}^R_{\vec{\kappa}} \f$
 struct TrueCurvatureKappaR: public aCylindricalFunctor<TrueCurvatureKappaR>
 {
-    TrueCurvatureKappaR( const TokamakMagneticField& mag):m_mag(mag), m_invB(mag), m_bZ(mag){ }
+    TrueCurvatureKappaR( const TokamakMagneticField& mag):m_mag(mag){ }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB/R*(m_mag.ipolZ()(R,Z) - m_mag.ipol()(R,Z)*invB*m_bZ(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        return R0*invB*invB/R*(v.ipolZ - v.ipol*invB*detail::bZ( R0, R, invB, v));
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BZ m_bZ;
 };
 
 ///@brief True \f$ \mathcal{K}^Z_{\vec{\kappa}} \f$
 struct TrueCurvatureKappaZ: public aCylindricalFunctor<TrueCurvatureKappaZ>
 {
-    TrueCurvatureKappaZ( const TokamakMagneticField& mag):m_mag(mag), m_invB(mag), m_bR(mag){ }
+    TrueCurvatureKappaZ( const TokamakMagneticField& mag):m_mag(mag){ }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB/R*( - m_mag.ipolR()(R,Z) + m_mag.ipol()(R,Z)*invB*m_bR(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        return R0*invB*invB/R*( - v.ipolR + v.ipol*invB*detail::bR( R0, R, invB, v));
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
 };
 ///@brief True \f$ \mathcal{K}^\varphi_{\vec{\kappa}} \f$
 struct TrueCurvatureKappaP: public aCylindricalFunctor<TrueCurvatureKappaP>
 {
-    TrueCurvatureKappaP( const TokamakMagneticField& mag):m_mag(mag), m_invB(mag), m_bR(mag), m_bZ(mag){ }
+    TrueCurvatureKappaP( const TokamakMagneticField& mag):m_mag(mag){ }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB/R/R*(
-            + invB*m_mag.psipZ()(R,Z)*m_bZ(R,Z) + invB *m_mag.psipR()(R,Z)*m_bR(R,Z)
-            + m_mag.psipR()(R,Z)/R - m_mag.psipRR()(R,Z) - m_mag.psipZZ()(R,Z));
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        return R0*invB*invB/R/R*(
+            + invB*v.psipZ*detail::bZ( R0, R, invB, v) + invB *v.psipR*detail::bR( R0, R, invB, v)
+            + v.psipR/R - v.psipRR - v.psipZZ);
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
-    BZ m_bZ;
 };
 
 ///@brief True \f$  \vec{\nabla}\cdot \mathcal{K}_{\vec{\kappa}}  \f$
 struct TrueDivCurvatureKappa: public aCylindricalFunctor<TrueDivCurvatureKappa>
 {
-    TrueDivCurvatureKappa( const TokamakMagneticField& mag): m_mag(mag), m_invB(mag), m_bR(mag), m_bZ(mag){}
+    TrueDivCurvatureKappa( const TokamakMagneticField& mag): m_mag(mag){}
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB*invB/R*( m_mag.ipolR()(R,Z)*m_bZ(R,Z) - m_mag.ipolZ()(R,Z)*m_bR(R,Z) );
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        return R0*invB*invB*invB/R*( v.ipolR*detail::bZ( R0, R, invB, v) - v.ipolZ*detail::bR( R0, R, invB, v) );
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
-    BZ m_bZ;
 };
 
 ///@brief True \f$  \vec{\nabla}\cdot \mathcal{K}_{\nabla B}  \f$
@@ -600,17 +703,15 @@ struct TrueDivCurvatureNablaB: public aCylindricalFunctor<TrueDivCurvatureNablaB
  */
 struct GradLnB: public aCylindricalFunctor<GradLnB>
 {
-    GradLnB( const TokamakMagneticField& mag): m_mag(mag), m_invB(mag), m_bR(mag), m_bZ(mag) { }
+    GradLnB( const TokamakMagneticField& mag): m_mag(mag) { }
     double do_compute( double R, double Z) const
     {
-        double invB = m_invB(R,Z);
-        return m_mag.R0()*invB*invB*(m_bR(R,Z)*m_mag.psipZ()(R,Z)-m_bZ(R,Z)*m_mag.psipR()(R,Z))/R ;
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double invB = detail::invB( m_mag.R0(), R, v);
+        return detail::gradLnB( m_mag.R0(), R, invB, v);
     }
     private:
     TokamakMagneticField m_mag;
-    InvB m_invB;
-    BR m_bR;
-    BZ m_bZ;
 };
 /**
  * @brief \f$  \nabla \cdot \vec b \f$
@@ -801,56 +902,62 @@ inline CylindricalVectorLvl0 createGradPsip( const TokamakMagneticField& mag){
 ///@brief \f$ \nabla_\parallel b^R \f$
 struct GradBHatR: public aCylindricalFunctor<GradBHatR>
 {
-    GradBHatR( const TokamakMagneticField& mag): m_bhatR(mag), m_divb(mag), m_mag(mag){}
+    GradBHatR( const TokamakMagneticField& mag): m_mag(mag){}
     double do_compute( double R, double Z) const
     {
-        double ipol = m_mag.ipol()(R,Z);
-        double psipR = m_mag.psipR()(R,Z), psipZ = m_mag.psipZ()(R,Z);
-        double psipZZ = m_mag.psipZZ()(R,Z), psipRZ = m_mag.psipRZ()(R,Z);
-        return  m_divb(R,Z)*m_bhatR(R,Z) +
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        double divb = -detail::gradLnB( R0, R, invB, v);
+        double bhatR = invB*R0/R*v.psipZ;
+        double ipol = v.ipol;
+        double psipR = v.psipR, psipZ = v.psipZ;
+        double psipZZ = v.psipZZ, psipRZ = v.psipRZ;
+        return  divb*bhatR +
                 ( psipZ*(psipRZ-psipZ/R) - psipZZ*psipR  )/
                     (ipol*ipol + psipR*psipR + psipZ*psipZ);
     }
     private:
-    BHatR m_bhatR;
-    Divb m_divb;
     TokamakMagneticField m_mag;
 };
 ///@brief \f$ \nabla_\parallel b^Z \f$
 struct GradBHatZ: public aCylindricalFunctor<GradBHatZ>
 {
-    GradBHatZ( const TokamakMagneticField& mag): m_bhatZ(mag), m_divb(mag), m_mag(mag){}
+    GradBHatZ( const TokamakMagneticField& mag): m_mag(mag){}
     double do_compute( double R, double Z) const
     {
-        double ipol = m_mag.ipol()(R,Z);
-        double psipR = m_mag.psipR()(R,Z), psipZ = m_mag.psipZ()(R,Z);
-        double psipRR = m_mag.psipRR()(R,Z), psipRZ = m_mag.psipRZ()(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        double divb = -detail::gradLnB( R0, R, invB, v);
+        double bhatZ = -invB*R0/R*v.psipR;
+        double ipol = v.ipol;
+        double psipR = v.psipR, psipZ = v.psipZ;
+        double psipRR = v.psipRR, psipRZ = v.psipRZ;
 
-        return  m_divb(R,Z)*m_bhatZ(R,Z) +
+        return  divb*bhatZ +
                 (psipR*(psipRZ+psipZ/R) - psipRR*psipZ)/
                     (ipol*ipol + psipR*psipR + psipZ*psipZ);
     }
     private:
-    BHatZ m_bhatZ;
-    Divb m_divb;
     TokamakMagneticField m_mag;
 };
 ///@brief \f$ \nabla_\parallel b^\varphi \f$
 struct GradBHatP: public aCylindricalFunctor<GradBHatP>
 {
-    GradBHatP( const TokamakMagneticField& mag): m_bhatP(mag), m_divb(mag), m_mag(mag){}
+    GradBHatP( const TokamakMagneticField& mag): m_mag(mag){}
     double do_compute( double R, double Z) const
     {
-        double ipol = m_mag.ipol()(R,Z), ipolR = m_mag.ipolR()(R,Z), ipolZ  = m_mag.ipolZ()(R,Z);
-        double psipR = m_mag.psipR()(R,Z), psipZ = m_mag.psipZ()(R,Z);
+        MagneticFieldValues v = m_mag.evaluate( R, Z);
+        double R0 = m_mag.R0(), invB = detail::invB( R0, R, v);
+        double divb = -detail::gradLnB( R0, R, invB, v);
+        double bhatP = invB*R0*v.ipol/R/R;
+        double ipol = v.ipol, ipolR = v.ipolR, ipolZ  = v.ipolZ;
+        double psipR = v.psipR, psipZ = v.psipZ;
 
-        return  m_divb(R,Z)*m_bhatP(R,Z) +
+        return  divb*bhatP +
              (psipZ*(ipolR/R - 2.*ipol/R/R) - ipolZ/R*psipR)/
                     (ipol*ipol + psipR*psipR + psipZ*psipZ);
     }
     private:
-    BHatP m_bhatP;
-    Divb m_divb;
     TokamakMagneticField m_mag;
 };
 
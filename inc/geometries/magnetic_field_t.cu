@@ -77,6 +77,28 @@ int main( int argc, char* argv[])
     std::cout << "psipZZ( 1-e,0)         "<<mag.psipZZ()(gp.R_0-gp.a,0.)+N2*mag.psipR()(gp.R_0-gp.a,0)<<"\n";
     std::cout << "psipRR( 1-de,ke)       "<<mag.psipRR()(R_H,Z_H)+N3*mag.psipZ()(R_H,Z_H)<<"\n";
 
+    std::cout << "Test fused evaluation (values must be 0)\n";
+    {
+        dg::Grid2d grid2d(gp.R_0-gp.a,gp.R_0+gp.a,-gp.a*gp.elongation,gp.a*gp.elongation, 3,20,20);
+        dg::HVec R = dg::evaluate( dg::cooX2d, grid2d), Z = dg::evaluate( dg::cooY2d, grid2d);
+        std::vector<dg::geo::MagneticFieldValues> values( R.size());
+        mag.evaluate( R.size(), &R[0], &Z[0], &values[0]);
+        double diff = 0;
+        for( unsigned i=0; i<R.size(); i++)
+        {
+            diff += fabs( values[i].psip   - mag.psip()(R[i],Z[i]));
+            diff += fabs( values[i].psipR  - mag.psipR()(R[i],Z[i]));
+            diff += fabs( values[i].psipZ  - mag.psipZ()(R[i],Z[i]));
+            diff += fabs( values[i].psipRR - mag.psipRR()(R[i],Z[i]));
+            diff += fabs( values[i].psipRZ - mag.psipRZ()(R[i],Z[i]));
+            diff += fabs( values[i].psipZZ - mag.psipZZ()(R[i],Z[i]));
+            diff += fabs( values[i].ipol   - mag.ipol()(R[i],Z[i]));
+            diff += fabs( values[i].ipolR  - mag.ipolR()(R[i],Z[i]));
+            diff += fabs( values[i].ipolZ  - mag.ipolZ()(R[i],Z[i]));
+        }
+        std::cout << "Difference fused - separate:  "<<diff<<"\n";
+    }
+
     std::cout << "Test accuracy of curvatures (values must be close to 0)\n";
     dg::geo::CylindricalVectorLvl0 bhat_ = dg::geo::createBHat( mag);
     dg::geo::CylindricalVectorLvl0 curvB_ = dg::geo::createTrueCurvatureNablaB( mag);
@@ -71,9 +71,9 @@ struct Fieldaligned< ProductMPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY
         Limiter limit = FullLimiter(),
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
-        double deltaPhi = -1):
+        double deltaPhi = -1, unsigned batch_size = 1):
             Fieldaligned( dg::geo::createBHat(vec),
-                grid, bcx, bcy, limit, eps, mx, my, deltaPhi)
+                grid, bcx, bcy, limit, eps, mx, my, deltaPhi, batch_size)
     {
     }
     template <class Limiter>
@@ -84,7 +84,24 @@ struct Fieldaligned< ProductMPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY
         Limiter limit = FullLimiter(),
         double eps = 1e-5,
         unsigned mx=10, unsigned my=10,
-        double deltaPhi = -1);
+        double deltaPhi = -1, unsigned batch_size = 1):
+            Fieldaligned( make_data( vec, grid, bcx, bcy, eps, mx, my, deltaPhi, batch_size),
+                grid, bcx, bcy, limit)
+    {
+    }
+    template <class Limiter>
+    Fieldaligned(const FieldalignedData& data,
+        const ProductMPIGeometry& grid,
+        dg::bc bcx = dg::NEU,
+        dg::bc bcy = dg::NEU,
+        Limiter limit = FullLimiter());
+    static FieldalignedData make_data(const dg::geo::CylindricalVectorLvl0& vec,
+        const ProductMPIGeometry& grid,
+        dg::bc bcx = dg::NEU,
+        dg::bc bcy = dg::NEU,
+        double eps = 1e-5,
+        unsigned mx=10, unsigned my=10,
+        double deltaPhi = -1, unsigned batch_size = 1);
     template<class ...Params>
     void construct( Params&& ...ps)
     {
@@ -186,34 +203,22 @@ struct Fieldaligned< ProductMPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY
 };
 //////////////////////////////////////DEFINITIONS/////////////////////////////////////
 template<class MPIGeometry, class LocalIMatrix, class CommunicatorXY, class LocalContainer>
-template <class Limiter>
-Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<LocalContainer> >::Fieldaligned(
+FieldalignedData Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<LocalContainer> >::make_data(
     const dg::geo::CylindricalVectorLvl0& vec, const MPIGeometry& grid,
-    dg::bc bcx, dg::bc bcy, Limiter limit, double eps,
-    unsigned mx, unsigned my, double deltaPhi)
+    dg::bc bcx, dg::bc bcy, double eps,
+    unsigned mx, unsigned my, double deltaPhi, unsigned batch_size)
 {
     ///Let us check boundary conditions:
-    if( (grid.bcx() == PER && bcx != PER) || (grid.bcx() != PER && bcx == PER) )
-        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting periodicity in x. The grid says "<<bc2str(grid.bcx())<<" while the parameter says "<<bc2str(bcx)));
-    if( (grid.bcy() == PER && bcy != PER) || (grid.bcy() != PER && bcy == PER) )
-        throw( dg::Error(dg::Message(_ping_)<<"Fieldaligned: Got conflicting boundary conditions in y. The grid says "<<bc2str(grid.bcy())<<" while the parameter says "<<bc2str(bcy)));
-    m_Nz=grid.local().Nz(), m_bcz=grid.bcz(), m_bcx = bcx, m_bcy = bcy;
-    m_g.reset(grid);
+    detail::check_fieldaligned_bc( grid, bcx, bcy);
     if( deltaPhi <=0) deltaPhi = grid.hz();
     else assert( grid.Nz() == 1 || grid.hz()==deltaPhi);
     int dims[3], periods[3], coords[3];
-    MPI_Cart_get( m_g->communicator(), 3, dims, periods, coords);
-    m_coords2 = coords[2], m_sizeZ = dims[2];
+    MPI_Cart_get( grid.communicator(), 3, dims, periods, coords);
+    const unsigned coords2 = coords[2], sizeZ = dims[2];
     ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
     dg::ClonePtr<aMPIGeometry2d> grid_coarse( grid.perp_grid());
     ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
-    m_perp_size = grid_coarse->local().size();
-    dg::assign( dg::pullback(limit, *grid_coarse), m_limiter);
-    dg::assign( dg::evaluate(zero, *grid_coarse), m_left);
-    m_ghostM = m_ghostP = m_right = m_left;
-#ifdef _DG_CUDA_UNAWARE_MPI
-    m_recv_buffer = m_send_buffer = m_ghostP.data();
-#endif
+    const unsigned perp_size = grid_coarse->local().size();
     ///%%%%%%%%%%Set starting points and integrate field lines%%%%%%%%%%%//
 #ifdef DG_BENCHMARK
     dg::Timer t;
@@ -233,9 +238,50 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     t.tic();
 #endif
     thrust::host_vector<bool> in_boxp, in_boxm;
-    thrust::host_vector<double> hbp, hbm;
+    FieldalignedData data;
+    thrust::host_vector<double>& hbp = data.hbp, & hbm = data.hbm;
+    thrust::host_vector<unsigned> steps;
+    //every process integrates the lines starting in its own subdomain;
+    //processes that share the subdomain (i.e. differ only in z) each
+    //integrate every sizeZ-th line and combine the results
     detail::integrate_all_fieldlines2d( vec, *global_grid_magnetic, grid_coarse->local(),
-            yp_coarse, ym_coarse, hbp, hbm, in_boxp, in_boxm, deltaPhi, eps);
+            yp_coarse, ym_coarse, hbp, hbm, in_boxp, in_boxm, steps, deltaPhi, eps,
+            batch_size, sizeZ, coords2);
+    if( sizeZ > 1)
+    {
+        MPI_Comm comm_z;
+        int remain_dims[] = {false,false,true};
+        MPI_Cart_sub( grid.communicator(), remain_dims, &comm_z);
+        for( unsigned k=0; k<3; k++)
+        {
+            MPI_Allreduce( MPI_IN_PLACE, thrust::raw_pointer_cast(yp_coarse[k].data()),
+                perp_size, MPI_DOUBLE, MPI_SUM, comm_z);
+            MPI_Allreduce( MPI_IN_PLACE, thrust::raw_pointer_cast(ym_coarse[k].data()),
+                perp_size, MPI_DOUBLE, MPI_SUM, comm_z);
+        }
+        MPI_Allreduce( MPI_IN_PLACE, thrust::raw_pointer_cast(hbp.data()),
+            perp_size, MPI_DOUBLE, MPI_SUM, comm_z);
+        MPI_Allreduce( MPI_IN_PLACE, thrust::raw_pointer_cast(hbm.data()),
+            perp_size, MPI_DOUBLE, MPI_SUM, comm_z);
+        MPI_Comm_free( &comm_z);
+        for( unsigned i=0; i<perp_size; i++)
+        {
+            in_boxp[i] = global_grid_magnetic->contains( yp_coarse[0][i], yp_coarse[1][i]);
+            in_boxm[i] = global_grid_magnetic->contains( ym_coarse[0][i], ym_coarse[1][i]);
+        }
+    }
+#ifdef DG_BENCHMARK
+    {
+    //load imbalance between processes: total number of steps per process
+    unsigned long local_steps = std::accumulate( steps.begin(), steps.end(), 0ul), min_steps, max_steps, sum_steps;
+    MPI_Reduce( &local_steps, &min_steps, 1, MPI_UNSIGNED_LONG, MPI_MIN, 0, grid.communicator());
+    MPI_Reduce( &local_steps, &max_steps, 1, MPI_UNSIGNED_LONG, MPI_MAX, 0, grid.communicator());
+    MPI_Reduce( &local_steps, &sum_steps, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, grid.communicator());
+    int size;
+    MPI_Comm_size( grid.communicator(), &size);
+    if(rank==0) std::cout << "# DS: Steps per process min/avg/max: "<<min_steps<<" "<<sum_steps/size<<" "<<max_steps<<"\n";
+    }
+#endif
     dg::IHMatrix interpolate = dg::create::interpolation( grid_fine.local(), grid_coarse->local());  //INTERPOLATE TO FINE GRID
     yp.fill(dg::evaluate( dg::zero, grid_fine.local())); ym = yp;
     for( int i=0; i<2; i++)
@@ -249,8 +295,8 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     t.tic();
 #endif
     ///%%%%%%%%%%%%%%%%Create interpolation and projection%%%%%%%%%%%%%%//
-    dg::IHMatrix plusFine  = dg::create::interpolation( yp[0], yp[1], grid_coarse->global(), bcx, bcy), plus;
-    dg::IHMatrix minusFine = dg::create::interpolation( ym[0], ym[1], grid_coarse->global(), bcx, bcy), minus;
+    dg::IHMatrix plusFine  = dg::create::interpolation( yp[0], yp[1], grid_coarse->global(), bcx, bcy), & plus = data.plus;
+    dg::IHMatrix minusFine = dg::create::interpolation( ym[0], ym[1], grid_coarse->global(), bcx, bcy), & minus = data.minus;
     if( mx == my && mx == 1)
     {
         plus = plusFine;
@@ -267,11 +313,46 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     if(rank==0) std::cout << "# DS: Multiplication PI     took: "<<t.diff()<<"\n";
     t.tic();
 #endif
-    dg::MIHMatrix temp = dg::convert( plus, *grid_coarse), tempT;
+    data.hp = yp_coarse[2], data.hm = ym_coarse[2];
+    detail::create_fieldaligned_masks( in_boxp, in_boxm, data);
+    return data;
+}
+
+template<class MPIGeometry, class LocalIMatrix, class CommunicatorXY, class LocalContainer>
+template <class Limiter>
+Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<LocalContainer> >::Fieldaligned(
+    const FieldalignedData& data, const MPIGeometry& grid,
+    dg::bc bcx, dg::bc bcy, Limiter limit)
+{
+    detail::check_fieldaligned_bc( grid, bcx, bcy);
+    m_Nz=grid.local().Nz(), m_bcz=grid.bcz(), m_bcx = bcx, m_bcy = bcy;
+    m_g.reset(grid);
+    int dims[3], periods[3], coords[3];
+    MPI_Cart_get( m_g->communicator(), 3, dims, periods, coords);
+    m_coords2 = coords[2], m_sizeZ = dims[2];
+    ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
+    dg::ClonePtr<aMPIGeometry2d> grid_coarse( grid.perp_grid());
+    ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
+    m_perp_size = grid_coarse->local().size();
+    if( data.hp.size() != m_perp_size || (unsigned)data.plus.num_rows != m_perp_size)
+        throw dg::Error( dg::Message(_ping_)<<"Fieldaligned: data of size "<<data.hp.size()<<" does not fit to grid of local size "<<m_perp_size);
+    dg::assign( dg::pullback(limit, *grid_coarse), m_limiter);
+    dg::assign( dg::evaluate(zero, *grid_coarse), m_left);
+    m_ghostM = m_ghostP = m_right = m_left;
+#ifdef _DG_CUDA_UNAWARE_MPI
+    m_recv_buffer = m_send_buffer = m_ghostP.data();
+#endif
+#ifdef DG_BENCHMARK
+    dg::Timer t;
+    int rank;
+    MPI_Comm_rank( grid.communicator(), &rank);
+    t.tic();
+#endif
+    dg::MIHMatrix temp = dg::convert( data.plus, *grid_coarse), tempT;
     tempT  = dg::transpose( temp);
     dg::blas2::transfer( temp, m_plus);
     dg::blas2::transfer( tempT, m_plusT);
-    temp = dg::convert( minus, *grid_coarse);
+    temp = dg::convert( data.minus, *grid_coarse);
     tempT  = dg::transpose( temp);
     dg::blas2::transfer( temp, m_minus);
     dg::blas2::transfer( tempT, m_minusT);
@@ -286,32 +367,21 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     m_f = dg::split( (const MPI_Vector<LocalContainer>&)m_hm, grid);
     m_hbp = m_hbm = m_hp = m_hm;
     dg::assign( dg::evaluate( dg::zero, *grid_coarse), m_hp2d);
-    dg::assign( yp_coarse[2], m_hp2d.data()); //2d vector
+    dg::assign( data.hp, m_hp2d.data()); //2d vector
     dg::assign( dg::evaluate( dg::zero, *grid_coarse), m_hm2d);
-    dg::assign( ym_coarse[2], m_hm2d.data()); //2d vector
-    assign3dfrom2d( hbp, m_hbp, grid);
-    assign3dfrom2d( hbm, m_hbm, grid);
-    assign3dfrom2d( yp_coarse[2], m_hp, grid);
-    assign3dfrom2d( ym_coarse[2], m_hm, grid);
+    dg::assign( data.hm, m_hm2d.data()); //2d vector
+    assign3dfrom2d( data.hbp, m_hbp, grid);
+    assign3dfrom2d( data.hbm, m_hbm, grid);
+    assign3dfrom2d( data.hp, m_hp, grid);
+    assign3dfrom2d( data.hm, m_hm, grid);
     dg::blas1::scal( m_hm2d, -1.);
     dg::blas1::scal( m_hbm, -1.);
     dg::blas1::scal( m_hm, -1.);
     ///%%%%%%%%%%%%%%%%%%%%create mask vectors %%%%%%%%%%%%%%%%%%%//
-    thrust::host_vector<double> bbm( in_boxp.size(),0.), bbo(bbm), bbp(bbm);
-    for( unsigned i=0; i<in_boxp.size(); i++)
-    {
-        if( !in_boxp[i] && !in_boxm[i])
-            bbo[i] = 1.;
-        else if( !in_boxp[i] && in_boxm[i])
-            bbp[i] = 1.;
-        else if( in_boxp[i] && !in_boxm[i])
-            bbm[i] = 1.;
-        // else all are 0
-    }
     m_bbm = m_bbo = m_bbp = m_hm;
-    assign3dfrom2d( bbm, m_bbm, grid);
-    assign3dfrom2d( bbo, m_bbo, grid);
-    assign3dfrom2d( bbp, m_bbp, grid);
+    assign3dfrom2d( data.bbm, m_bbm, grid);
+    assign3dfrom2d( data.bbo, m_bbo, grid);
+    assign3dfrom2d( data.bbp, m_bbp, grid);
 }
 
 template<class G, class M, class C, class container>
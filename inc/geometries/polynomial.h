@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cmath>
 #include <vector>
+#include <array>
 
 #include "dg/blas.h"
 
@@ -26,6 +27,41 @@ namespace geo
  */
 namespace polynomial
 {
+///@cond
+namespace detail{
+//coefficients of the derivative (d/dR)^dR (d/dZ)^dZ of the polynomial c (size M*N)
+inline std::vector<double> derive( const std::vector<double>& c, unsigned M, unsigned N, unsigned dR, unsigned dZ)
+{
+    std::vector<double>  beta ( (M-dR)*(N-dZ));
+    for( unsigned i=0; i<M-dR; i++)
+        for( unsigned j=0; j<N-dZ; j++)
+        {
+            unsigned factor = 1;
+            for( unsigned k=1; k<=dR; k++)
+                factor *= i+k;
+            for( unsigned k=1; k<=dZ; k++)
+                factor *= j+k;
+            beta[i*(N-dZ)+j] = (double)factor*c[ (i+dR)*N +j+dZ];
+        }
+    return beta;
+}
+inline double horner( const double * c, unsigned M, double x)
+{
+    double b = c[M-1];
+    for( unsigned i=0; i<M-1; i++)
+        b = c[M-2-i] + b*x;
+    return b;
+}
+//same as dg::Horner2d but uses the given workspace cx of size M
+inline double horner2d( const std::vector<double>& c, unsigned M, unsigned N, double x, double y, double* cx)
+{
+    for( unsigned i=0; i<M; i++)
+        cx[i] = horner( &c[i*N], N, y);
+    return horner( cx, M, x);
+}
+}//namespace detail
+///@endcond
+
 ///@addtogroup polynomial
 ///@{
 
@@ -57,13 +93,8 @@ struct Psip: public aCylindricalFunctor<Psip>
 struct PsipR: public aCylindricalFunctor<PsipR>
 {
     ///@copydoc Psip::Psip()
-    PsipR( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp){
-        std::vector<double>  beta ( (gp.M-1)*gp.N);
-        for( unsigned i=0; i<gp.M-1; i++)
-            for( unsigned j=0; j<gp.N; j++)
-                beta[i*gp.N+j] = (double)(i+1)*gp.c[ ( i+1)*gp.N +j];
-        m_horner = Horner2d( beta, gp.M-1, gp.N);
-    }
+    PsipR( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp),
+        m_horner( detail::derive( gp.c, gp.M, gp.N, 1, 0), gp.M-1, gp.N){}
     double do_compute(double R, double Z) const
     {
         return m_pp*m_horner( R/m_R0,Z/m_R0);
@@ -75,13 +106,8 @@ struct PsipR: public aCylindricalFunctor<PsipR>
 struct PsipRR: public aCylindricalFunctor<PsipRR>
 {
     ///@copydoc Psip::Psip()
-    PsipRR( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp){
-        std::vector<double>  beta ( (gp.M-2)*gp.N);
-        for( unsigned i=0; i<gp.M-2; i++)
-            for( unsigned j=0; j<gp.N; j++)
-                beta[i*gp.N+j] = (double)((i+2)*(i+1))*gp.c[ (i+2)*gp.N +j];
-        m_horner = Horner2d( beta, gp.M-2, gp.N);
-    }
+    PsipRR( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp),
+        m_horner( detail::derive( gp.c, gp.M, gp.N, 2, 0), gp.M-2, gp.N){}
     double do_compute(double R, double Z) const
     {
         return m_pp/m_R0*m_horner( R/m_R0,Z/m_R0);
@@ -93,13 +119,8 @@ struct PsipRR: public aCylindricalFunctor<PsipRR>
 struct PsipZ: public aCylindricalFunctor<PsipZ>
 {
     ///@copydoc Psip::Psip()
-    PsipZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp){
-        std::vector<double>  beta ( gp.M*(gp.N-1));
-        for( unsigned i=0; i<gp.M; i++)
-            for( unsigned j=0; j<gp.N-1; j++)
-                beta[i*(gp.N-1)+j] = (double)(j+1)*gp.c[ i*gp.N +j+1];
-        m_horner = Horner2d( beta, gp.M, gp.N-1);
-    }
+    PsipZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp),
+        m_horner( detail::derive( gp.c, gp.M, gp.N, 0, 1), gp.M, gp.N-1){}
     double do_compute(double R, double Z) const
     {
         return m_pp*m_horner( R/m_R0,Z/m_R0);
@@ -111,13 +132,8 @@ struct PsipZ: public aCylindricalFunctor<PsipZ>
 struct PsipZZ: public aCylindricalFunctor<PsipZZ>
 {
     ///@copydoc Psip::Psip()
-    PsipZZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp){
-        std::vector<double>  beta ( gp.M*(gp.N-2));
-        for( unsigned i=0; i<gp.M; i++)
-            for( unsigned j=0; j<gp.N-2; j++)
-                beta[i*(gp.N-2)+j] = (double)((j+2)*(j+1))*gp.c[ i*gp.N +j+2];
-        m_horner = Horner2d( beta, gp.M, gp.N-2);
-    }
+    PsipZZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp),
+        m_horner( detail::derive( gp.c, gp.M, gp.N, 0, 2), gp.M, gp.N-2){}
     double do_compute(double R, double Z) const
     {
         return m_pp/m_R0*m_horner(R/m_R0,Z/m_R0);
@@ -129,13 +145,8 @@ struct PsipZZ: public aCylindricalFunctor<PsipZZ>
 struct PsipRZ: public aCylindricalFunctor<PsipRZ>
 {
     ///@copydoc Psip::Psip()
-    PsipRZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp){
-        std::vector<double>  beta ( (gp.M-1)*(gp.N-1));
-        for( unsigned i=0; i<gp.M-1; i++)
-            for( unsigned j=0; j<gp.N-1; j++)
-                beta[i*(gp.N-1)+j] = (double)((j+1)*(i+1))*gp.c[ (i+1)*gp.N +j+1];
-        m_horner = Horner2d( beta, gp.M-1, gp.N-1);
-    }
+    PsipRZ( Parameters gp ): m_R0(gp.R_0),  m_pp(gp.pp),
+        m_horner( detail::derive( gp.c, gp.M, gp.N, 1, 1), gp.M-1, gp.N-1){}
     double do_compute(double R, double Z) const
     {
         return m_pp/m_R0*m_horner(R/m_R0,Z/m_R0);
@@ -145,6 +156,53 @@ struct PsipRZ: public aCylindricalFunctor<PsipRZ>
     Horner2d m_horner;
 };
 
+/**
+ * @brief Fused evaluation of \c Psip, all its derivatives and the constant current
+ *
+ * Normalizes the coordinates once per point and evaluates all polynomials
+ * in a single stack workspace (instead of allocating one per polynomial and point as \c dg::Horner2d).
+ * The result is the same as the one of the individual functors.
+ * @sa dg::geo::MagneticFieldEvaluator
+ */
+struct Evaluator
+{
+    ///@copydoc Psip::Psip()
+    Evaluator( Parameters gp ): m_R0(gp.R_0), m_pp(gp.pp), m_pi(gp.pi), m_M(gp.M), m_N(gp.N),
+        m_c{ gp.c,
+            detail::derive( gp.c, gp.M, gp.N, 1, 0),
+            detail::derive( gp.c, gp.M, gp.N, 0, 1),
+            detail::derive( gp.c, gp.M, gp.N, 2, 0),
+            detail::derive( gp.c, gp.M, gp.N, 1, 1),
+            detail::derive( gp.c, gp.M, gp.N, 0, 2)}
+    { }
+    ///@brief Write the values at \c (R[i],Z[i]) into \c values[i] for all \c i<size
+    void operator()( unsigned size, const double* R, const double* Z, MagneticFieldValues* values) const
+    {
+        //the workspace lives on the stack unless the polynomial is unusually large
+        double buffer[32];
+        std::vector<double> large( m_M > 32 ? m_M : 0);
+        double* cx = m_M > 32 ? large.data() : buffer;
+        const unsigned M = m_M, N = m_N;
+        for( unsigned i=0; i<size; i++)
+        {
+            double Rn = R[i]/m_R0, Zn = Z[i]/m_R0;
+            MagneticFieldValues& v = values[i];
+            v.psip   = m_R0*m_pp*detail::horner2d( m_c[0], M,   N,   Rn, Zn, cx);
+            v.psipR  = m_pp*detail::horner2d(      m_c[1], M-1, N,   Rn, Zn, cx);
+            v.psipZ  = m_pp*detail::horner2d(      m_c[2], M,   N-1, Rn, Zn, cx);
+            v.psipRR = m_pp/m_R0*detail::horner2d( m_c[3], M-2, N,   Rn, Zn, cx);
+            v.psipRZ = m_pp/m_R0*detail::horner2d( m_c[4], M-1, N-1, Rn, Zn, cx);
+            v.psipZZ = m_pp/m_R0*detail::horner2d( m_c[5], M,   N-2, Rn, Zn, cx);
+            v.ipol = m_pi;
+            v.ipolR = v.ipolZ = 0;
+        }
+    }
+  private:
+    double m_R0, m_pp, m_pi;
+    unsigned m_M, m_N;
+    std::array<std::vector<double>,6> m_c;
+};
+
 static inline dg::geo::CylindricalFunctorsLvl2 createPsip( Parameters gp)
 {
     return CylindricalFunctorsLvl2( Psip(gp), PsipR(gp), PsipZ(gp),
@@ -163,6 +221,7 @@ static inline dg::geo::CylindricalFunctorsLvl1 createIpol( Parameters gp)
  * @brief Create a Polynomial Magnetic field
  *
  * Based on \c dg::geo::polynomial::Psip(gp) and \c dg::geo::polynomial::Ipol(gp)
+ * with fused evaluator \c dg::geo::polynomial::Evaluator(gp)
  * @param gp Polynomial parameters
  * @return A magnetic field object
  * @ingroup polynomial
@@ -173,7 +232,7 @@ static inline dg::geo::TokamakMagneticField createPolynomialField(
     MagneticFieldParameters params( gp.a, gp.elongation, gp.triangularity,
             equilibrium::polynomial, modifier::none, str2description.at( gp.description));
     return TokamakMagneticField( gp.R_0, polynomial::createPsip(gp),
-        polynomial::createIpol(gp), params);
+        polynomial::createIpol(gp), params, polynomial::Evaluator(gp));
 }
 
 } //namespace geo
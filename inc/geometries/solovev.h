@@ -28,6 +28,99 @@ namespace geo
  */
 namespace solovev
 {
+///@cond
+namespace detail{
+//the powers of R/R_0, Z/R_0 and the logarithm shared by psip and all its derivatives
+struct Monomials
+{
+    Monomials( double R, double Z, double R0)
+    {
+        Rn = R/R0; Rn2 = Rn*Rn; Rn3 = Rn2*Rn; Rn4 = Rn2*Rn2; Rn5 = Rn3*Rn2;
+        Zn = Z/R0; Zn2 = Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2; Zn5 = Zn3*Zn2; Zn6 = Zn3*Zn3;
+        lgRn= log(Rn);
+    }
+    double Rn,Rn2,Rn3,Rn4,Rn5,Zn,Zn2,Zn3,Zn4,Zn5,Zn6,lgRn;
+};
+inline double psip( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn2 = p.Rn2, Rn4 = p.Rn4, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, Zn4 = p.Zn4, Zn5 = p.Zn5, Zn6 = p.Zn6, lgRn = p.lgRn;
+    return   R0*pp*( Rn4/8.+ A * ( 1./2.* Rn2* lgRn-(Rn4)/8.)
+                  + c[0]  //c[0] entspricht c_1
+          + c[1]  *Rn2
+          + c[2]  *(Zn2 - Rn2 * lgRn )
+          + c[3]  *(Rn4 - 4.* Rn2*Zn2 )
+          + c[4]  *(3.* Rn4 * lgRn  -9.*Rn2*Zn2 -12.* Rn2*Zn2 * lgRn + 2.*Zn4)
+          + c[5]  *(Rn4*Rn2-12.* Rn4*Zn2 +8.* Rn2 *Zn4 )
+          + c[6]  *(-15.*Rn4*Rn2 * lgRn + 75.* Rn4 *Zn2 + 180.* Rn4*Zn2 * lgRn
+                     -140.*Rn2*Zn4 - 120.* Rn2*Zn4 *lgRn + 8.* Zn6 )
+          + c[7]  *Zn
+          + c[8]  *Rn2*Zn
+                  + c[9] *(Zn2*Zn - 3.* Rn2*Zn * lgRn)
+          + c[10] *( 3. * Rn4*Zn - 4. * Rn2*Zn3)
+          + c[11] *(-45.* Rn4*Zn + 60.* Rn4*Zn* lgRn - 80.* Rn2*Zn3* lgRn + 8. * Zn5)
+                  );
+}
+
+inline double psipR( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn = p.Rn, Rn3 = p.Rn3, Rn5 = p.Rn5, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, Zn4 = p.Zn4, lgRn = p.lgRn;
+    return   pp*(Rn3/2. + (Rn/2. - Rn3/2. + Rn*lgRn)* A +
+    2.* Rn* c[1] + (-Rn - 2.* Rn*lgRn)* c[2] + (4.*Rn3 - 8.* Rn *Zn2)* c[3] +
+    (3. *Rn3 - 30.* Rn *Zn2 + 12. *Rn3*lgRn -  24.* Rn *Zn2*lgRn)* c[4]
+    + (6 *Rn5 - 48 *Rn3 *Zn2 + 16.* Rn *Zn4)*c[5]
+    + (-15. *Rn5 + 480. *Rn3 *Zn2 - 400.* Rn *Zn4 - 90. *Rn5*lgRn +
+        720. *Rn3 *Zn2*lgRn - 240.* Rn *Zn4*lgRn)* c[6] +
+    2.* Rn *Zn *c[8] + (-3. *Rn *Zn - 6.* Rn* Zn*lgRn)* c[9] + (12. *Rn3* Zn - 8.* Rn *Zn3)* c[10] + (-120. *Rn3* Zn - 80.* Rn *Zn3 + 240. *Rn3* Zn*lgRn -
+        160.* Rn *Zn3*lgRn) *c[11]
+      );
+}
+
+inline double psipRR( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn2 = p.Rn2, Rn4 = p.Rn4, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, Zn4 = p.Zn4, lgRn = p.lgRn;
+    return   pp/R0*( (3.* Rn2)/2. + (3./2. - (3. *Rn2)/2. +lgRn) *A +  2.* c[1] + (-3. - 2.*lgRn)* c[2] + (12. *Rn2 - 8. *Zn2) *c[3] +
+     (21. *Rn2 - 54. *Zn2 + 36. *Rn2*lgRn - 24. *Zn2*lgRn)* c[4]
+     + (30. *Rn4 - 144. *Rn2 *Zn2 + 16.*Zn4)*c[5] + (-165. *Rn4 + 2160. *Rn2 *Zn2 - 640. *Zn4 - 450. *Rn4*lgRn +
+      2160. *Rn2 *Zn2*lgRn - 240. *Zn4*lgRn)* c[6] +
+      2.* Zn* c[8] + (-9. *Zn - 6.* Zn*lgRn) *c[9]
+ +   (36. *Rn2* Zn - 8. *Zn3) *c[10]
+ +   (-120. *Rn2* Zn - 240. *Zn3 + 720. *Rn2* Zn*lgRn - 160. *Zn3*lgRn)* c[11]);
+}
+
+inline double psipZ( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn2 = p.Rn2, Rn4 = p.Rn4, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, Zn4 = p.Zn4, Zn5 = p.Zn5, lgRn = p.lgRn;
+    return   pp*(2.* Zn* c[2]
+        -  8. *Rn2* Zn* c[3] +
+          ((-18.)*Rn2 *Zn + 8. *Zn3 - 24. *Rn2* Zn*lgRn) *c[4]
+        + ((-24.) *Rn4* Zn + 32. *Rn2 *Zn3)* c[5]
+        + (150. *Rn4* Zn - 560. *Rn2 *Zn3 + 48. *Zn5 + 360. *Rn4* Zn*lgRn - 480. *Rn2 *Zn3*lgRn)* c[6]
+        + c[7]
+        + Rn2 * c[8]
+        + (3. *Zn2 - 3. *Rn2*lgRn)* c[9]
+        + (3. *Rn4 - 12. *Rn2 *Zn2) *c[10]
+        + ((-45.)*Rn4 + 40. *Zn4 + 60. *Rn4*lgRn -  240. *Rn2 *Zn2*lgRn)* c[11]);
+}
+
+inline double psipZZ( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn2 = p.Rn2, Rn4 = p.Rn4, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, Zn4 = p.Zn4, lgRn = p.lgRn;
+    return   pp/R0*( 2.* c[2] - 8. *Rn2* c[3] + (-18. *Rn2 + 24. *Zn2 - 24. *Rn2*lgRn) *c[4] + (-24.*Rn4 + 96. *Rn2 *Zn2) *c[5]
+    + (150. *Rn4 - 1680. *Rn2 *Zn2 + 240. *Zn4 + 360. *Rn4*lgRn - 1440. *Rn2 *Zn2*lgRn)* c[6] + 6.* Zn* c[9] -  24. *Rn2 *Zn *c[10] + (160. *Zn3 - 480. *Rn2* Zn*lgRn) *c[11]);
+}
+
+inline double psipRZ( double R0, double A, double pp, const std::vector<double>& c, const Monomials& p)
+{
+    double Rn = p.Rn, Rn3 = p.Rn3, Zn = p.Zn, Zn2 = p.Zn2, Zn3 = p.Zn3, lgRn = p.lgRn;
+    return   pp/R0*(
+          -16.* Rn* Zn* c[3] + (-60.* Rn* Zn - 48.* Rn* Zn*lgRn)* c[4] + (-96. *Rn3* Zn + 64.*Rn *Zn3)* c[5]
+        + (960. *Rn3 *Zn - 1600.* Rn *Zn3 + 1440. *Rn3* Zn*lgRn - 960. *Rn *Zn3*lgRn) *c[6] +  2.* Rn* c[8] + (-3.* Rn - 6.* Rn*lgRn)* c[9]
+        + (12. *Rn3 - 24.* Rn *Zn2) *c[10] + (-120. *Rn3 - 240. *Rn *Zn2 + 240. *Rn3*lgRn -   480.* Rn *Zn2*lgRn)* c[11]
+             );
+}
+}//namespace detail
+///@endcond
+
 ///@addtogroup solovev
 ///@{
 
@@ -68,25 +161,7 @@ struct Psip: public aCylindricalFunctor<Psip>
     Psip( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) {}
     double do_compute(double R, double Z) const
     {
-        double Rn,Rn2,Rn4,Zn,Zn2,Zn3,Zn4,Zn5,Zn6,lgRn;
-        Rn = R/m_R0; Rn2 = Rn*Rn; Rn4 = Rn2*Rn2;
-        Zn = Z/m_R0; Zn2 = Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2; Zn5 = Zn3*Zn2; Zn6 = Zn3*Zn3;
-        lgRn= log(Rn);
-        return   m_R0*m_pp*( Rn4/8.+ m_A * ( 1./2.* Rn2* lgRn-(Rn4)/8.)
-                      + m_c[0]  //m_c[0] entspricht c_1
-              + m_c[1]  *Rn2
-              + m_c[2]  *(Zn2 - Rn2 * lgRn )
-              + m_c[3]  *(Rn4 - 4.* Rn2*Zn2 )
-              + m_c[4]  *(3.* Rn4 * lgRn  -9.*Rn2*Zn2 -12.* Rn2*Zn2 * lgRn + 2.*Zn4)
-              + m_c[5]  *(Rn4*Rn2-12.* Rn4*Zn2 +8.* Rn2 *Zn4 )
-              + m_c[6]  *(-15.*Rn4*Rn2 * lgRn + 75.* Rn4 *Zn2 + 180.* Rn4*Zn2 * lgRn
-                         -140.*Rn2*Zn4 - 120.* Rn2*Zn4 *lgRn + 8.* Zn6 )
-              + m_c[7]  *Zn
-              + m_c[8]  *Rn2*Zn
-                      + m_c[9] *(Zn2*Zn - 3.* Rn2*Zn * lgRn)
-              + m_c[10] *( 3. * Rn4*Zn - 4. * Rn2*Zn3)
-              + m_c[11] *(-45.* Rn4*Zn + 60.* Rn4*Zn* lgRn - 80.* Rn2*Zn3* lgRn + 8. * Zn5)
-                      );
+        return detail::psip( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -117,19 +192,7 @@ struct PsipR: public aCylindricalFunctor<PsipR>
     PsipR( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) {}
     double do_compute(double R, double Z) const
     {
-        double Rn,Rn2,Rn3,Rn5,Zn,Zn2,Zn3,Zn4,lgRn;
-        Rn = R/m_R0; Rn2 = Rn*Rn; Rn3 = Rn2*Rn;  Rn5 = Rn3*Rn2;
-        Zn = Z/m_R0; Zn2 =Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2;
-        lgRn= log(Rn);
-        return   m_pp*(Rn3/2. + (Rn/2. - Rn3/2. + Rn*lgRn)* m_A +
-        2.* Rn* m_c[1] + (-Rn - 2.* Rn*lgRn)* m_c[2] + (4.*Rn3 - 8.* Rn *Zn2)* m_c[3] +
-        (3. *Rn3 - 30.* Rn *Zn2 + 12. *Rn3*lgRn -  24.* Rn *Zn2*lgRn)* m_c[4]
-        + (6 *Rn5 - 48 *Rn3 *Zn2 + 16.* Rn *Zn4)*m_c[5]
-        + (-15. *Rn5 + 480. *Rn3 *Zn2 - 400.* Rn *Zn4 - 90. *Rn5*lgRn +
-            720. *Rn3 *Zn2*lgRn - 240.* Rn *Zn4*lgRn)* m_c[6] +
-        2.* Rn *Zn *m_c[8] + (-3. *Rn *Zn - 6.* Rn* Zn*lgRn)* m_c[9] + (12. *Rn3* Zn - 8.* Rn *Zn3)* m_c[10] + (-120. *Rn3* Zn - 80.* Rn *Zn3 + 240. *Rn3* Zn*lgRn -
-            160.* Rn *Zn3*lgRn) *m_c[11]
-          );
+        return detail::psipR( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -158,17 +221,7 @@ struct PsipRR: public aCylindricalFunctor<PsipRR>
     PsipRR( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) {}
     double do_compute(double R, double Z) const
     {
-       double Rn,Rn2,Rn4,Zn,Zn2,Zn3,Zn4,lgRn;
-       Rn = R/m_R0; Rn2 = Rn*Rn;  Rn4 = Rn2*Rn2;
-       Zn = Z/m_R0; Zn2 =Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2;
-       lgRn= log(Rn);
-       return   m_pp/m_R0*( (3.* Rn2)/2. + (3./2. - (3. *Rn2)/2. +lgRn) *m_A +  2.* m_c[1] + (-3. - 2.*lgRn)* m_c[2] + (12. *Rn2 - 8. *Zn2) *m_c[3] +
-         (21. *Rn2 - 54. *Zn2 + 36. *Rn2*lgRn - 24. *Zn2*lgRn)* m_c[4]
-         + (30. *Rn4 - 144. *Rn2 *Zn2 + 16.*Zn4)*m_c[5] + (-165. *Rn4 + 2160. *Rn2 *Zn2 - 640. *Zn4 - 450. *Rn4*lgRn +
-      2160. *Rn2 *Zn2*lgRn - 240. *Zn4*lgRn)* m_c[6] +
-      2.* Zn* m_c[8] + (-9. *Zn - 6.* Zn*lgRn) *m_c[9]
- +   (36. *Rn2* Zn - 8. *Zn3) *m_c[10]
- +   (-120. *Rn2* Zn - 240. *Zn3 + 720. *Rn2* Zn*lgRn - 160. *Zn3*lgRn)* m_c[11]);
+        return detail::psipRR( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -194,22 +247,7 @@ struct PsipZ: public aCylindricalFunctor<PsipZ>
     PsipZ( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) { }
     double do_compute(double R, double Z) const
     {
-        double Rn,Rn2,Rn4,Zn,Zn2,Zn3,Zn4,Zn5,lgRn;
-        Rn = R/m_R0; Rn2 = Rn*Rn;  Rn4 = Rn2*Rn2;
-        Zn = Z/m_R0; Zn2 = Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2; Zn5 = Zn3*Zn2;
-        lgRn= log(Rn);
-
-        return   m_pp*(2.* Zn* m_c[2]
-            -  8. *Rn2* Zn* m_c[3] +
-              ((-18.)*Rn2 *Zn + 8. *Zn3 - 24. *Rn2* Zn*lgRn) *m_c[4]
-            + ((-24.) *Rn4* Zn + 32. *Rn2 *Zn3)* m_c[5]
-            + (150. *Rn4* Zn - 560. *Rn2 *Zn3 + 48. *Zn5 + 360. *Rn4* Zn*lgRn - 480. *Rn2 *Zn3*lgRn)* m_c[6]
-            + m_c[7]
-            + Rn2 * m_c[8]
-            + (3. *Zn2 - 3. *Rn2*lgRn)* m_c[9]
-            + (3. *Rn4 - 12. *Rn2 *Zn2) *m_c[10]
-            + ((-45.)*Rn4 + 40. *Zn4 + 60. *Rn4*lgRn -  240. *Rn2 *Zn2*lgRn)* m_c[11]);
-
+        return detail::psipZ( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -232,12 +270,7 @@ struct PsipZZ: public aCylindricalFunctor<PsipZZ>
     PsipZZ( Parameters gp): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) { }
     double do_compute(double R, double Z) const
     {
-        double Rn,Rn2,Rn4,Zn,Zn2,Zn3,Zn4,lgRn;
-        Rn = R/m_R0; Rn2 = Rn*Rn; Rn4 = Rn2*Rn2;
-        Zn = Z/m_R0; Zn2 =Zn*Zn; Zn3 = Zn2*Zn; Zn4 = Zn2*Zn2;
-        lgRn= log(Rn);
-        return   m_pp/m_R0*( 2.* m_c[2] - 8. *Rn2* m_c[3] + (-18. *Rn2 + 24. *Zn2 - 24. *Rn2*lgRn) *m_c[4] + (-24.*Rn4 + 96. *Rn2 *Zn2) *m_c[5]
-        + (150. *Rn4 - 1680. *Rn2 *Zn2 + 240. *Zn4 + 360. *Rn4*lgRn - 1440. *Rn2 *Zn2*lgRn)* m_c[6] + 6.* Zn* m_c[9] -  24. *Rn2 *Zn *m_c[10] + (160. *Zn3 - 480. *Rn2* Zn*lgRn) *m_c[11]);
+        return detail::psipZZ( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -262,15 +295,7 @@ struct PsipRZ: public aCylindricalFunctor<PsipRZ>
     PsipRZ( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_c(gp.c) { }
     double do_compute(double R, double Z) const
     {
-        double Rn,Rn2,Rn3,Zn,Zn2,Zn3,lgRn;
-        Rn = R/m_R0; Rn2 = Rn*Rn; Rn3 = Rn2*Rn;
-        Zn = Z/m_R0; Zn2 =Zn*Zn; Zn3 = Zn2*Zn;
-        lgRn= log(Rn);
-        return   m_pp/m_R0*(
-              -16.* Rn* Zn* m_c[3] + (-60.* Rn* Zn - 48.* Rn* Zn*lgRn)* m_c[4] + (-96. *Rn3* Zn + 64.*Rn *Zn3)* m_c[5]
-            + (960. *Rn3 *Zn - 1600.* Rn *Zn3 + 1440. *Rn3* Zn*lgRn - 960. *Rn *Zn3*lgRn) *m_c[6] +  2.* Rn* m_c[8] + (-3.* Rn - 6.* Rn*lgRn)* m_c[9]
-            + (12. *Rn3 - 24.* Rn *Zn2) *m_c[10] + (-120. *Rn3 - 240. *Rn *Zn2 + 240. *Rn3*lgRn -   480.* Rn *Zn2*lgRn)* m_c[11]
-                 );
+        return detail::psipRZ( m_R0, m_A, m_pp, m_c, detail::Monomials( R, Z, m_R0));
     }
   private:
     double m_R0, m_A, m_pp;
@@ -347,6 +372,45 @@ struct IpolZ: public aCylindricalFunctor<IpolZ>
     std::function<double(double,double)> m_psip, m_psipZ;
 };
 
+/**
+ * @brief Fused evaluation of \c Psip, all its derivatives and \c Ipol, \c IpolR, \c IpolZ
+ *
+ * The powers of \f$ \bar R\f$, \f$ \bar Z\f$ and \f$ \ln \bar R\f$ are computed only
+ * once per point and \f$ I\f$ is computed from the already known values of \f$ \psi_p\f$.
+ * The result is the same as the one of the individual functors.
+ * @sa dg::geo::MagneticFieldEvaluator
+ */
+struct Evaluator
+{
+    ///@copydoc Psip::Psip()
+    Evaluator( Parameters gp ): m_R0(gp.R_0), m_A(gp.A), m_pp(gp.pp), m_ppI(gp.pp), m_pi(gp.pi), m_c(gp.c) {
+        if( gp.pp == 0.)
+            m_ppI = 1.; //safety measure to avoid divide by zero errors (as in Ipol)
+    }
+    ///@brief Write the values at \c (R[i],Z[i]) into \c values[i] for all \c i<size
+    void operator()( unsigned size, const double* R, const double* Z, MagneticFieldValues* values) const
+    {
+        for( unsigned i=0; i<size; i++)
+        {
+            detail::Monomials p( R[i], Z[i], m_R0);
+            MagneticFieldValues& v = values[i];
+            v.psip   = detail::psip(   m_R0, m_A, m_pp, m_c, p);
+            v.psipR  = detail::psipR(  m_R0, m_A, m_pp, m_c, p);
+            v.psipZ  = detail::psipZ(  m_R0, m_A, m_pp, m_c, p);
+            v.psipRR = detail::psipRR( m_R0, m_A, m_pp, m_c, p);
+            v.psipRZ = detail::psipRZ( m_R0, m_A, m_pp, m_c, p);
+            v.psipZZ = detail::psipZZ( m_R0, m_A, m_pp, m_c, p);
+            double sqrtI = sqrt(-2.*m_A* v.psip /m_R0/m_ppI + 1.);
+            v.ipol  = m_pi*sqrtI;
+            v.ipolR = -m_pi/sqrtI*(m_A*v.psipR/m_R0/m_ppI);
+            v.ipolZ = -m_pi/sqrtI*(m_A*v.psipZ/m_R0/m_ppI);
+        }
+    }
+  private:
+    double m_R0, m_A, m_pp, m_ppI, m_pi;
+    std::vector<double> m_c;
+};
+
 static inline dg::geo::CylindricalFunctorsLvl2 createPsip( const Parameters& gp)
 {
     return CylindricalFunctorsLvl2( Psip(gp), PsipR(gp), PsipZ(gp),
@@ -369,6 +433,7 @@ static inline dg::geo::CylindricalFunctorsLvl1 createIpol( const Parameters& gp,
  * @brief Create a Solovev Magnetic field
  *
  * Based on \c dg::geo::solovev::Psip(gp) and \c dg::geo::solovev::Ipol(gp)
+ * with fused evaluator \c dg::geo::solovev::Evaluator(gp)
  * @param gp Solovev parameters
  * @return A magnetic field object
  * @ingroup solovev
@@ -379,7 +444,8 @@ static inline dg::geo::TokamakMagneticField createSolovevField(
     MagneticFieldParameters params = { gp.a, gp.elongation, gp.triangularity,
             equilibrium::solovev, modifier::none, str2description.at( gp.description)};
     return TokamakMagneticField( gp.R_0, solovev::createPsip(gp),
-        solovev::createIpol(gp, solovev::createPsip(gp)), params);
+        solovev::createIpol(gp, solovev::createPsip(gp)), params,
+        solovev::Evaluator(gp));
 }
 /**
  * @brief Create a modified Solovev Magnetic field
@@ -0,0 +1,412 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "dg/file/nc_utilities.h"
+
+namespace feltor
+{
+
+/**
+ * @brief Write time slices into a netcdf file in a background thread
+ *
+ * All netcdf calls on the file are queued and executed in order by a
+ * dedicated writer thread while the caller continues with the time loop.
+ * Every queued job owns a copy of its data. If the queued data exceeds a
+ * given number of bytes the caller blocks until the writer catches up
+ * (back-pressure), so the memory overhead is bounded.
+ *
+ * In MPI all processes call the put functions. The data is gathered on the
+ * master rank in the calling thread (which is why \c MPI_THREAD_FUNNELED
+ * suffices) and only the master rank owns a writer thread and opens the file.
+ * An error in the writer thread is rethrown in the caller at the next call.
+ *
+ * Alternatively, in MPI the writer can use parallel netcdf, where every
+ * process writes its own block with collective calls. Since collective MPI
+ * calls must stay in the main thread these writes are executed immediately.
+ */
+struct AsyncWriter
+{
+    /**
+     * @brief Start the writer thread
+     *
+     * @param file_name an existing netcdf file (all variables must be defined)
+     * @param max_bytes maximum size of the data queued for output
+     * @param master true if this process writes to the file (in MPI the rank 0)
+     */
+    AsyncWriter( std::string file_name, size_t max_bytes, bool master = true):
+        m_file( file_name), m_max( max_bytes), m_master( master)
+    {
+        if( m_master)
+            m_thread = std::thread( [this](){ this->loop();});
+    }
+#ifdef MPI_VERSION
+    /**
+     * @brief Write synchronously with parallel netcdf
+     *
+     * Every process opens the file and writes its own local block
+     * (cf. \c dg::file::put_vara_double with \c parallel==true)
+     * @param file_name an existing netcdf-4 file (all variables must be defined)
+     * @param comm all processes in \c comm must call every member function
+     */
+    AsyncWriter( std::string file_name, MPI_Comm comm):
+        m_file( file_name), m_max( 0), m_master( true), m_parallel( true),
+        m_comm( comm){ }
+#endif //MPI_VERSION
+    AsyncWriter( const AsyncWriter&) = delete;
+    AsyncWriter& operator=( const AsyncWriter&) = delete;
+    ///@brief Write all remaining data and join the writer thread
+    ~AsyncWriter()
+    {
+        if( !m_thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock( m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    ///@brief Queue opening the file for write access
+    void open()
+    {
+        std::string file = m_file;
+#ifdef MPI_VERSION
+        if( m_parallel)
+        {
+            MPI_Comm comm = m_comm;
+            push( [file, comm]( int& ncid){
+                dg::file::NC_Error_Handle err;
+                err = nc_open_par( file.data(), NC_WRITE|NC_MPIIO, comm,
+                    MPI_INFO_NULL, &ncid);
+            }, 0);
+            return;
+        }
+#endif //MPI_VERSION
+        push( [file]( int& ncid){
+            dg::file::NC_Error_Handle err;
+            err = nc_open( file.data(), NC_WRITE, &ncid);
+        }, 0);
+    }
+    ///@brief Queue closing the file (afterwards it can be read by others)
+    void close()
+    {
+        push( []( int& ncid){
+            dg::file::NC_Error_Handle err;
+            err = nc_close( ncid);
+        }, 0);
+    }
+    ///@brief Queue writing \c time into the time variable at \c slice
+    void put_time( int varid, unsigned slice, double time)
+    {
+        Block block;
+        block.start = {slice}, block.count = {1}, block.data = {time};
+        put_blocks( varid, {block});
+    }
+
+    /**
+     * @brief Queue writing a time slice (cf. \c dg::file::put_vara_double)
+     *
+     * @param varid variable id
+     * @param slice the time slice to write
+     * @param grid the grid of the data
+     * @param data is copied so it can be overwritten after the call
+     */
+    template<class host_vector>
+    void put_vara_double( int varid, unsigned slice, const dg::aTopology2d& grid,
+        const host_vector& data)
+    {
+        Block block;
+        block.start = { slice, 0, 0};
+        block.count = { 1, grid.n()*grid.Ny(), grid.n()*grid.Nx()};
+        block.data.assign( data.begin(), data.end());
+        put_blocks( varid, {block});
+    }
+    ///@copydoc put_vara_double(int,unsigned,const dg::aTopology2d&,const host_vector&)
+    template<class host_vector>
+    void put_vara_double( int varid, unsigned slice, const dg::aTopology3d& grid,
+        const host_vector& data)
+    {
+        Block block;
+        block.start = { slice, 0, 0, 0};
+        block.count = { 1, grid.Nz(), grid.n()*grid.Ny(), grid.n()*grid.Nx()};
+        block.data.assign( data.begin(), data.end());
+        put_blocks( varid, {block});
+    }
+    /**
+     * @brief Queue writing a time-independent variable (cf. \c dg::file::put_var_double)
+     *
+     * @param varid variable id
+     * @param grid the grid of the data
+     * @param data is copied so it can be overwritten after the call
+     */
+    template<class host_vector>
+    void put_var_double( int varid, const dg::aTopology3d& grid,
+        const host_vector& data)
+    {
+        Block block;
+        block.start = { 0, 0, 0};
+        block.count = { grid.Nz(), grid.n()*grid.Ny(), grid.n()*grid.Nx()};
+        block.data.assign( data.begin(), data.end());
+        put_blocks( varid, {block});
+    }
+#ifdef MPI_VERSION
+    /**
+     * @brief Gather data on the master rank and queue writing a time slice
+     *
+     * @attention All processes in the communicator of \c grid must call this function
+     * and rank 0 of the communicator must be the master
+     */
+    template<class host_vector>
+    void put_vara_double( int varid, unsigned slice, const dg::aMPITopology2d& grid,
+        const dg::MPI_Vector<host_vector>& data)
+    {
+        put_blocks( varid, gather( slice, true, grid.local().n(), {grid.local().Nx(),
+            grid.local().Ny()}, grid.communicator(), data.data()));
+    }
+
+    ///@copydoc put_vara_double(int,unsigned,const dg::aMPITopology2d&,const dg::MPI_Vector<host_vector>&)
+    template<class host_vector>
+    void put_vara_double( int varid, unsigned slice, const dg::aMPITopology3d& grid,
+        const dg::MPI_Vector<host_vector>& data)
+    {
+        put_blocks( varid, gather( slice, true, grid.local().n(), {grid.local().Nx(),
+            grid.local().Ny(), grid.local().Nz()}, grid.communicator(), data.data()));
+    }
+    /**
+     * @brief Gather data on the master rank and queue writing a time-independent variable
+     *
+     * @attention All processes in the communicator of \c grid must call this function
+     * and rank 0 of the communicator must be the master
+     */
+    template<class host_vector>
+    void put_var_double( int varid, const dg::aMPITopology3d& grid,
+        const dg::MPI_Vector<host_vector>& data)
+    {
+        put_blocks( varid, gather( 0, false, grid.local().n(), {grid.local().Nx(),
+            grid.local().Ny(), grid.local().Nz()}, grid.communicator(), data.data()));
+    }
+#endif //MPI_VERSION
+    /**
+     * @brief Take part in a collective write without contributing data
+     *
+     * In parallel mode processes that are not part of the grid communicator
+     * call this function instead of \c put_vara_double. Does nothing otherwise.
+     * @param varid variable id
+     */
+    void put_empty( int varid)
+    {
+#ifdef MPI_VERSION
+        if( m_parallel)
+            push( [varid]( int& ncid){
+                dg::file::put_vara_empty( ncid, varid);
+            }, 0);
+#endif //MPI_VERSION
+    }
+
+    ///@brief Block until all queued data is written
+    void wait()
+    {
+        if( !m_master || m_parallel)
+            return;
+        std::unique_lock<std::mutex> lock( m_mutex);
+        m_cv.wait( lock, [this]{ return m_queue.empty() || m_error;});
+        rethrow();
+    }
+    ///@brief Total time in seconds the caller was blocked because the queue was full
+    double blocked_time() const{
+        std::lock_guard<std::mutex> lock( m_mutex);
+        return m_blocked;
+    }
+    ///@brief Number of bytes currently queued
+    size_t queued_bytes() const{
+        std::lock_guard<std::mutex> lock( m_mutex);
+        return m_bytes;
+    }
+    private:
+    struct Block
+    {
+        std::vector<size_t> start, count;
+        std::vector<double> data;
+    };
+    struct Job
+    {
+        std::function<void(int&)> write;
+        size_t bytes;
+    };
+#ifdef MPI_VERSION
+    //the block of process rrank in comm without data
+    static Block make_block( unsigned slice, bool time_dependent,
+        unsigned n, const std::vector<unsigned>& local_N, MPI_Comm comm, int rrank)
+    {
+        int dims = local_N.size();
+        std::vector<int> coords( dims);
+        MPI_Cart_coords( comm, rrank, dims, &coords[0]);
+        Block block;
+        if( time_dependent)
+            block.start.push_back( slice), block.count.push_back( 1);
+        //netcdf has the reverse order of dimensions
+        for( int d=dims-1; d>=0; d--)
+        {
+            unsigned count = d==2 ? local_N[d] : n*local_N[d];
+            block.start.push_back( coords[d]*count);
+            block.count.push_back( count);
+        }
+        return block;
+    }
+    //receive the local data of every process on rank 0 of comm
+    //(in parallel mode every process keeps its own block)
+    template<class host_vector>
+    std::vector<Block> gather( unsigned slice, bool time_dependent,
+        unsigned n, std::vector<unsigned> local_N, MPI_Comm comm,
+        const host_vector& data)
+    {
+        int rank, size;
+        MPI_Comm_rank( comm, &rank);
+        MPI_Comm_size( comm, &size);
+        std::vector<Block> blocks;
+        if( m_parallel)
+        {
+            blocks.push_back( make_block( slice, time_dependent, n, local_N, comm, rank));
+            blocks[0].data.assign( data.begin(), data.end());
+            return blocks;
+        }
+        if( rank != 0)
+        {
+            MPI_Send( thrust::raw_pointer_cast( data.data()), data.size(),
+                MPI_DOUBLE, 0, rank, comm);
+            return blocks;
+        }
+        blocks.resize( size);
+        for( int rrank=0; rrank<size; rrank++)
+        {
+            Block& block = blocks[rrank];
+            block = make_block( slice, time_dependent, n, local_N, comm, rrank);
+            block.data.resize( data.size());
+            if( rrank == 0)
+                block.data.assign( data.begin(), data.end());
+            else
+            {
+                MPI_Status status;
+                MPI_Recv( block.data.data(), data.size(), MPI_DOUBLE,
+                    rrank, rrank, comm, &status);
+            }
+        }
+        return blocks;
+    }
+#endif //MPI_VERSION
+    void put_blocks( int varid, std::vector<Block> blocks)
+    {
+        size_t bytes = 0;
+        for( auto& block : blocks)
+            bytes += block.data.size()*sizeof(double);
+        auto shared = std::make_shared<std::vector<Block>>( std::move(blocks));
+        bool collective = m_parallel;
+        push( [varid, shared, collective]( int& ncid){
+            dg::file::NC_Error_Handle err;
+#ifdef MPI_VERSION
+            if( collective)
+                err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
+#endif //MPI_VERSION
+            for( auto& block : *shared)
+                err = nc_put_vara_double( ncid, varid, block.start.data(),
+                    block.count.data(), block.data.data());
+        }, bytes);
+    }
+    void push( std::function<void(int&)> write, size_t bytes)
+    {
+        if( !m_master)
+            return;
+        if( m_parallel)
+        {
+            write( m_ncid);
+            return;
+        }
+        std::unique_lock<std::mutex> lock( m_mutex);
+        rethrow();
+        //back-pressure: wait until the writer has caught up
+        if( !m_queue.empty() && m_bytes + bytes > m_max)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            m_cv.wait( lock, [&]{ return m_queue.empty() ||
+                m_bytes + bytes <= m_max || m_error;});
+            m_blocked += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - t0).count();
+            rethrow();
+        }
+        m_queue.push_back( Job{ std::move(write), bytes});
+        m_bytes += bytes;
+        lock.unlock();
+        m_cv.notify_all();
+    }
+    //must be called with m_mutex locked
+    void rethrow()
+    {
+        if( m_error)
+        {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception( error);
+        }
+    }
+    void loop()
+    {
+        int ncid = -1;
+        while( true)
+        {
+            std::unique_lock<std::mutex> lock( m_mutex);
+            m_cv.wait( lock, [this]{ return !m_queue.empty() || m_stop;});
+            if( m_queue.empty()) // && m_stop
+                return;
+            Job& job = m_queue.front();
+            lock.unlock();
+            std::exception_ptr error;
+            try{
+                job.write( ncid);
+            }
+            catch( ...){
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_bytes -= job.bytes;
+            m_queue.pop_front();
+            if( error)
+            {
+                //discard the remaining jobs; the caller sees the error
+                m_error = error;
+                m_bytes = 0;
+                m_queue.clear();
+            }
+            lock.unlock();
+            m_cv.notify_all();
+        }
+    }
+    std::string m_file;
+    size_t m_max;
+    bool m_master;
+    bool m_parallel = false;
+#ifdef MPI_VERSION
+    MPI_Comm m_comm;
+#endif //MPI_VERSION
+    int m_ncid = -1; //only used in parallel mode
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job> m_queue;
+    size_t m_bytes = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    double m_blocked = 0.;
+};
+
+}//namespace feltor
@@ -234,13 +234,23 @@ struct AddResistivity{
 };
 }//namespace routines
 
+//A cache that never has the data and never stores it
+struct NoFieldalignedCache
+{
+    bool read( dg::geo::FieldalignedData&) const{ return false;}
+    void write( const dg::geo::FieldalignedData&) const{}
+};
+
 template< class Geometry, class IMatrix, class Matrix, class Container >
 struct Explicit
 {
     using vector = std::array<std::array<Container,2>,2>;
     using container = Container;
+    //cache can be used to store the Fieldaligned construction (cf. fieldaligned_cache.h)
+    template<class FieldalignedCache = NoFieldalignedCache>
     Explicit( const Geometry& g, feltor::Parameters p,
-        dg::geo::TokamakMagneticField mag ); //full system means explicit AND implicit
+        dg::geo::TokamakMagneticField mag,
+        const FieldalignedCache& cache = FieldalignedCache()); //full system means explicit AND implicit
 
     //Given N_i-1 initialize n_e-1 such that phi=0
     void initializene( const Container& ni, Container& ne);
@@ -426,10 +436,12 @@ struct Explicit
         std::array<std::array<Container,2>,2>& yp);
     void construct_mag( const Geometry&, feltor::Parameters,
         dg::geo::TokamakMagneticField);
+    template<class FieldalignedCache>
     void construct_bhat( const Geometry&, feltor::Parameters,
-        dg::geo::TokamakMagneticField);
+        dg::geo::TokamakMagneticField, const FieldalignedCache&);
     void construct_invert( const Geometry&, feltor::Parameters,
         dg::geo::TokamakMagneticField);
+    bool failed( const std::vector<unsigned>& number) const;
 
     Container m_UE2;
     Container m_temp0, m_temp1, m_temp2;//helper variables
@@ -461,8 +473,10 @@ struct Explicit
     std::vector<dg::Helmholtz3d<Geometry, Matrix, Container> > m_multi_invgammaP,
         m_multi_invgammaN, m_multi_induction;
 
-    dg::MultigridCG2d<Geometry, Matrix, Container> m_multigrid;
+    //planes may converge independently in the perpendicular solves (plane_cg)
+    dg::MultigridCG2d<Geometry, Matrix, Container, dg::PlaneCG<Container>> m_multigrid;
     dg::Extrapolation<Container> m_old_phi, m_old_psi, m_old_gammaN, m_old_apar;
+    dg::ProjectionExtrapolation<Container> m_proj_phi, m_proj_psi, m_proj_gammaN;
 
     dg::SparseTensor<Container> m_hh;
 
@@ -527,13 +541,27 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_mag(
 
 }
 template<class Grid, class IMatrix, class Matrix, class Container>
+template<class FieldalignedCache>
 void Explicit<Grid, IMatrix, Matrix, Container>::construct_bhat(
-    const Grid& g, feltor::Parameters p, dg::geo::TokamakMagneticField mag)
+    const Grid& g, feltor::Parameters p, dg::geo::TokamakMagneticField mag,
+    const FieldalignedCache& cache)
 {
     //in DS we take the true bhat
     auto bhat = dg::geo::createBHat( mag);
-    m_fa.construct( bhat, g, p.bcxN, p.bcyN, dg::geo::NoLimiter(),
-        p.rk4eps, p.mx, p.my, 2.*M_PI/(double)p.Nz );
+    //the field line integration is expensive so try the cache first
+    dg::geo::FieldalignedData data;
+    int found = cache.read( data);
+#ifdef MPI_VERSION
+    //all processes need to agree since the construction is collective
+    MPI_Allreduce( MPI_IN_PLACE, &found, 1, MPI_INT, MPI_LAND, g.communicator());
+#endif //MPI_VERSION
+    if( !found)
+    {
+        data = decltype(m_fa)::make_data( bhat, g, p.bcxN, p.bcyN,
+            p.rk4eps, p.mx, p.my, 2.*M_PI/(double)p.Nz );
+        cache.write( data);
+    }
+    m_fa.construct( data, g, p.bcxN, p.bcyN, dg::geo::NoLimiter());
     //m_fa_N.construct( bhat, g, p.bcxN, p.bcyN, dg::geo::NoLimiter(),
     //    p.rk4eps, p.mx, p.my, 2.*M_PI/(double)p.Nz );
     //if( p.bcxU == p.bcxN && p.bcyU == p.bcyN)
@@ -618,11 +646,27 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_invert(
             m_multi_invgammaN[u].elliptic().set_compute_in_2d( true);
             m_multi_induction[u].elliptic().set_compute_in_2d( true);
         }
+        //by default all planes are one system (same as dg::CG)
+        m_multigrid.solver(u).set_compute_in_2d( p.plane_cg && p.curvmode != "true");
     }
 }
+template<class Geometry, class IMatrix, class Matrix, class Container>
+bool Explicit<Geometry, IMatrix, Matrix, Container>::failed(
+    const std::vector<unsigned>& number) const
+{
+    unsigned max_number = number[0];
+#ifdef MPI_VERSION
+    //processes with different planes iterate independently if plane_cg
+    MPI_Allreduce( MPI_IN_PLACE, &max_number, 1, MPI_UNSIGNED, MPI_MAX,
+        m_multigrid.grid(0).communicator());
+#endif //MPI_VERSION
+    return max_number == m_multigrid.max_iter();
+}
 template<class Grid, class IMatrix, class Matrix, class Container>
+template<class FieldalignedCache>
 Explicit<Grid, IMatrix, Matrix, Container>::Explicit( const Grid& g,
-    feltor::Parameters p, dg::geo::TokamakMagneticField mag):
+    feltor::Parameters p, dg::geo::TokamakMagneticField mag,
+    const FieldalignedCache& cache):
 #ifdef DG_MANUFACTURED
     m_R( dg::pullback( dg::cooX3d, g)),
     m_Z( dg::pullback( dg::cooY3d, g)),
@@ -638,6 +682,9 @@ Explicit<Grid, IMatrix, Matrix, Container>::Explicit( const Grid& g,
     m_multigrid( g, p.stages),
     m_old_phi( 2, dg::evaluate( dg::zero, g)),
     m_old_psi( m_old_phi), m_old_gammaN( m_old_phi), m_old_apar( m_old_phi),
+    m_proj_phi( p.predictor == "projection" ? p.predictor_max : 0,
+        dg::evaluate( dg::zero, g)),
+    m_proj_psi( m_proj_phi), m_proj_gammaN( m_proj_phi),
     m_p(p)
 {
     //--------------------------init vectors to 0-----------------//
@@ -656,7 +703,7 @@ Explicit<Grid, IMatrix, Matrix, Container>::Explicit( const Grid& g,
 
     //--------------------------Construct-------------------------//
     construct_mag( g, p, mag);
-    construct_bhat( g, p, mag);
+    construct_bhat( g, p, mag, cache);
     construct_invert( g, p, mag);
 }
 
@@ -670,7 +717,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::initializene(
         // ne-1 = Gamma (ni-1)
         std::vector<unsigned> number = m_multigrid.direct_solve(
             m_multi_invgammaN, target, src, m_p.eps_gamma);
-        if(  number[0] == m_multigrid.max_iter())
+        if( failed( number))
             throw dg::Fail( m_p.eps_gamma);
     }
 }
@@ -728,20 +775,27 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_phi(
     else
     {
         //compute Gamma N_i - n_e
-        m_old_gammaN.extrapolate( time, m_temp0);
 #ifdef DG_MANUFACTURED
         dg::blas1::copy( y[1], m_temp1);
         dg::blas1::evaluate( m_temp1, dg::plus_equals(), manufactured::SGammaNi{
             m_p.mu[0],m_p.mu[1],m_p.tau[0],m_p.tau[1],m_p.eta,
             m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
-        std::vector<unsigned> numberG = m_multigrid.direct_solve(
-            m_multi_invgammaN, m_temp0, m_temp1, m_p.eps_gamma);
+        const Container& rhsG = m_temp1;
 #else
-        std::vector<unsigned> numberG = m_multigrid.direct_solve(
-            m_multi_invgammaN, m_temp0, y[1], m_p.eps_gamma);
+        const Container& rhsG = y[1];
 #endif //DG_MANUFACTURED
-        m_old_gammaN.update( time, m_temp0);
-        if(  numberG[0] == m_multigrid.max_iter())
+        std::vector<unsigned> numberG;
+        if( m_p.predictor == "projection")
+            numberG = m_multigrid.direct_solve( m_multi_invgammaN, m_temp0,
+                rhsG, m_p.eps_gamma, m_proj_gammaN);
+        else
+        {
+            m_old_gammaN.extrapolate( time, m_temp0);
+            numberG = m_multigrid.direct_solve( m_multi_invgammaN, m_temp0,
+                rhsG, m_p.eps_gamma);
+            m_old_gammaN.update( time, m_temp0);
+        }
+        if( failed( numberG))
             throw dg::Fail( m_p.eps_gamma);
         dg::blas1::axpby( -1., y[0], 1., m_temp0, m_temp0);
     }
@@ -751,11 +805,18 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_phi(
         m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
 #endif //DG_MANUFACTURED
     //----------Invert polarisation----------------------------//
-    m_old_phi.extrapolate( time, m_phi[0]);
-    std::vector<unsigned> number = m_multigrid.direct_solve(
-        m_multi_pol, m_phi[0], m_temp0, m_p.eps_pol);
-    m_old_phi.update( time, m_phi[0]);
-    if(  number[0] == m_multigrid.max_iter())
+    std::vector<unsigned> number;
+    if( m_p.predictor == "projection")
+        number = m_multigrid.direct_solve( m_multi_pol, m_phi[0], m_temp0,
+            m_p.eps_pol, m_proj_phi);
+    else
+    {
+        m_old_phi.extrapolate( time, m_phi[0]);
+        number = m_multigrid.direct_solve( m_multi_pol, m_phi[0], m_temp0,
+            m_p.eps_pol);
+        m_old_phi.update( time, m_phi[0]);
+    }
+    if( failed( number))
         throw dg::Fail( m_p.eps_pol[0]);
 }
 
@@ -767,20 +828,27 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_psi(
     if (m_p.tau[1] == 0.) {
         dg::blas1::copy( m_phi[0], m_phi[1]);
     } else {
-        m_old_psi.extrapolate( time, m_phi[1]);
 #ifdef DG_MANUFACTURED
         dg::blas1::copy( m_phi[0], m_temp0);
         dg::blas1::evaluate( m_temp0, dg::plus_equals(), manufactured::SGammaPhie{
             m_p.mu[0],m_p.mu[1],m_p.tau[0],m_p.tau[1],m_p.eta,
             m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
-        std::vector<unsigned> number = m_multigrid.direct_solve(
-            m_multi_invgammaP, m_phi[1], m_temp0, m_p.eps_gamma);
+        const Container& rhsP = m_temp0;
 #else
-        std::vector<unsigned> number = m_multigrid.direct_solve(
-            m_multi_invgammaP, m_phi[1], m_phi[0], m_p.eps_gamma);
+        const Container& rhsP = m_phi[0];
 #endif //DG_MANUFACTURED
-        m_old_psi.update( time, m_phi[1]);
-        if(  number[0] == m_multigrid.max_iter())
+        std::vector<unsigned> number;
+        if( m_p.predictor == "projection")
+            number = m_multigrid.direct_solve( m_multi_invgammaP, m_phi[1],
+                rhsP, m_p.eps_gamma, m_proj_psi);
+        else
+        {
+            m_old_psi.extrapolate( time, m_phi[1]);
+            number = m_multigrid.direct_solve( m_multi_invgammaP, m_phi[1],
+                rhsP, m_p.eps_gamma);
+            m_old_psi.update( time, m_phi[1]);
+        }
+        if( failed( number))
             throw dg::Fail( m_p.eps_gamma);
     }
     //-------Compute Psi and derivatives
@@ -824,7 +892,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_apar(
     std::vector<unsigned> number = m_multigrid.direct_solve(
         m_multi_induction, m_apar, m_temp0, m_p.eps_pol[0]);
     m_old_apar.update( time, m_apar);
-    if(  number[0] == m_multigrid.max_iter())
+    if( failed( number))
         throw dg::Fail( m_p.eps_pol[0]);
 #ifdef DG_MANUFACTURED
     //dg::blas1::evaluate( m_temp0, dg::plus_equals(), manufactured::SA{
@@ -856,15 +924,18 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_perp(
     // make the implementation conservative since the perp boundaries are
     // penalized away
     //y[0] = N-1, y[1] = W; fields[0] = N, fields[1] = U
+    ////////////////////perpendicular dynamics////////////////////////
+    //apply each derivative to both species in one sweep
+    dg::blas2::symv( m_dx_N, {&y[0][0], &y[0][1]}, {&m_dN[0][0], &m_dN[1][0]});
+    dg::blas2::symv( m_dy_N, {&y[0][0], &y[0][1]}, {&m_dN[0][1], &m_dN[1][1]});
+    dg::blas2::symv( m_dx_U, {&fields[1][0], &fields[1][1]}, {&m_dU[0][0], &m_dU[1][0]});
+    dg::blas2::symv( m_dy_U, {&fields[1][0], &fields[1][1]}, {&m_dU[0][1], &m_dU[1][1]});
+    if(!m_p.symmetric)
+        dg::blas2::symv( m_dz,
+            {&y[0][0], &y[0][1], &fields[1][0], &fields[1][1]},
+            {&m_dN[0][2], &m_dN[1][2], &m_dU[0][2], &m_dU[1][2]});
     for( unsigned i=0; i<2; i++)
     {
-        ////////////////////perpendicular dynamics////////////////////////
-        dg::blas2::symv( m_dx_N, y[0][i], m_dN[i][0]);
-        dg::blas2::symv( m_dy_N, y[0][i], m_dN[i][1]);
-        if(!m_p.symmetric) dg::blas2::symv( m_dz, y[0][i], m_dN[i][2]);
-        dg::blas2::symv( m_dx_U, fields[1][i], m_dU[i][0]);
-        dg::blas2::symv( m_dy_U, fields[1][i], m_dU[i][1]);
-        if(!m_p.symmetric) dg::blas2::symv( m_dz, fields[1][i], m_dU[i][2]);
         if( m_p.beta == 0){
             dg::blas1::subroutine( routines::ComputePerpConservative(
                 m_p.mu[i], m_p.tau[i]),
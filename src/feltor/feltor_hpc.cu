@@ -12,6 +12,8 @@
 
 #include "dg/file/file.h"
 #include "feltor.h"
+#include "fieldaligned_cache.h"
+#include "async_writer.h"
 #include "implicit.h"
 
 using HVec = dg::x::HVec;
@@ -23,8 +25,11 @@ using IHMatrix = dg::x::IHMatrix;
 using Geometry = dg::x::CylindricalGrid3d;
 #ifdef FELTOR_MPI
 #define MPI_OUT if(rank==0)
+//netcdf calls: in parallel output mode all processes access the file
+#define NC_OUT if(rank==0 || parallel_output)
 #else //FELTOR_MPI
 #define MPI_OUT
+#define NC_OUT
 #endif //FELTOR_MPI
 
 #include "init.h"
@@ -137,6 +142,10 @@ int main( int argc, char* argv[])
     }
     const feltor::Parameters p( js);
     MPI_OUT p.display( std::cout);
+    bool parallel_output = false;
+#ifdef FELTOR_MPI
+    parallel_output = ( p.output_mode == "parallel");
+#endif //FELTOR_MPI
     std::string inputfile = js.toStyledString(), geomfile = gs.toStyledString();
     MPI_OUT std::cout << geomfile << std::endl;
     dg::geo::TokamakMagneticField mag, mod_mag;
@@ -198,9 +207,33 @@ int main( int argc, char* argv[])
     if( p.periodify)
         mag = dg::geo::periodify( mag, Rmin, Rmax, Zmin, Zmax, dg::NEU, dg::NEU);
 
+    //the field line integration only depends on these parameters
+    //so that restarted runs and runs with the same setup share the cache
+    feltor::FieldalignedCache fa_cache;
+    if( !p.fa_cache.empty())
+    {
+        std::stringstream fa_parameters;
+        fa_parameters << std::setprecision(17) << geomfile << " "
+            << Rmin << " " << Rmax << " " << Zmin << " " << Zmax << " "
+            << p.n << " " << p.Nx << " " << p.Ny << " " << grid.Nz() << " "
+            << dg::bc2str(p.bcxN) << " " << dg::bc2str(p.bcyN) << " "
+            << p.periodify << " " << p.rk4eps << " " << p.mx << " " << p.my << " " << p.Nz;
+#ifdef FELTOR_MPI
+        fa_parameters << " " << np[0] << " " << np[1] << " " << np[2];
+#endif //FELTOR_MPI
+        std::string fa_cache_name = p.fa_cache + "/fieldaligned_"
+            + feltor::FieldalignedCache::make_key( fa_parameters.str()) + ".nc";
+        MPI_OUT std::cout << "Fieldaligned cache "<<fa_cache_name<<"\n";
+        fa_cache = feltor::FieldalignedCache( fa_cache_name, fa_parameters.str()
+            #ifdef FELTOR_MPI
+            , comm
+            #endif //FELTOR_MPI
+            );
+    }
+
     //create RHS
     MPI_OUT std::cout << "Constructing Explicit...\n";
-    feltor::Explicit< Geometry, IDMatrix, DMatrix, DVec> feltor( grid, p, mag);
+    feltor::Explicit< Geometry, IDMatrix, DMatrix, DVec> feltor( grid, p, mag, fa_cache);
     //MPI_OUT std::cout << "Constructing Implicit...\n";
     //feltor::Implicit< Geometry, IDMatrix, DMatrix, DVec> implicit( grid, p, mag);
     MPI_OUT std::cout << "Done!\n";
@@ -281,6 +314,12 @@ int main( int argc, char* argv[])
     std::string file_name = argv[3];
     int ncid=-1;
     try{
+#ifdef FELTOR_MPI
+        if( parallel_output)
+            err = nc_create_par( file_name.data(), NC_NETCDF4|NC_MPIIO|NC_CLOBBER,
+                comm, MPI_INFO_NULL, &ncid);
+        else
+#endif //FELTOR_MPI
         MPI_OUT err = nc_create( file_name.data(), NC_NETCDF4|NC_CLOBBER, &ncid);
     }catch( std::exception& e)
     {
@@ -310,13 +349,13 @@ int main( int argc, char* argv[])
     att["inputfile"] = inputfile;
     att["geomfile"] = geomfile;
     for( auto pair : att)
-        MPI_OUT err = nc_put_att_text( ncid, NC_GLOBAL,
+        NC_OUT err = nc_put_att_text( ncid, NC_GLOBAL,
             pair.first.data(), pair.second.size(), pair.second.data());
 
     // Define dimensions (t,z,y,x)
     int dim_ids[4], restart_dim_ids[3], tvarID;
-    MPI_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g3d_out, {"time", "z", "y", "x"});
-    MPI_OUT err = dg::file::define_dimensions( ncid, restart_dim_ids, grid, {"zr", "yr", "xr"});
+    NC_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g3d_out, {"time", "z", "y", "x"});
+    NC_OUT err = dg::file::define_dimensions( ncid, restart_dim_ids, grid, {"zr", "yr", "xr"});
     int dim_ids3d[3] = {dim_ids[0], dim_ids[2], dim_ids[3]};
     bool write2d = true;
 #ifdef FELTOR_MPI
@@ -328,33 +367,36 @@ int main( int argc, char* argv[])
     for ( auto& record : feltor::diagnostics3d_static_list)
     {
         int vecID;
-        MPI_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 3,
+        NC_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 3,
             &dim_ids[1], &vecID);
-        MPI_OUT err = nc_put_att_text( ncid, vecID,
+        NC_OUT err = nc_put_att_text( ncid, vecID,
             "long_name", record.long_name.size(), record.long_name.data());
-        MPI_OUT err = nc_enddef( ncid);
+        NC_OUT err = nc_enddef( ncid);
         MPI_OUT std::cout << "Computing "<<record.name<<"\n";
         record.function( transferH, var, g3d_out);
         //record.function( resultH, var, grid);
         //dg::blas2::symv( projectH, resultH, transferH);
-        dg::file::put_var_double( ncid, vecID, g3d_out, transferH);
-        MPI_OUT err = nc_redef(ncid);
+        dg::file::put_var_double( ncid, vecID, g3d_out, transferH, parallel_output);
+        NC_OUT err = nc_redef(ncid);
     }
     //create & output static 2d variables into file
     for ( auto& record : feltor::diagnostics2d_static_list)
     {
         int vecID;
-        MPI_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 2,
+        NC_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 2,
             &dim_ids[2], &vecID);
-        MPI_OUT err = nc_put_att_text( ncid, vecID,
+        NC_OUT err = nc_put_att_text( ncid, vecID,
             "long_name", record.long_name.size(), record.long_name.data());
-        MPI_OUT err = nc_enddef( ncid);
+        NC_OUT err = nc_enddef( ncid);
         MPI_OUT std::cout << "Computing2d "<<record.name<<"\n";
         //record.function( transferH, var, g3d_out); //ATTENTION: This does not work because feltor internal varialbes return full grid functions
         record.function( resultH, var, grid);
         dg::blas2::symv( projectH, resultH, transferH);
-        if(write2d)dg::file::put_var_double( ncid, vecID, *g2d_out_ptr, transferH);
-        MPI_OUT err = nc_redef(ncid);
+        if(write2d)dg::file::put_var_double( ncid, vecID, *g2d_out_ptr, transferH, parallel_output);
+#ifdef FELTOR_MPI
+        else if(parallel_output) dg::file::put_vara_empty( ncid, vecID);
+#endif //FELTOR_MPI
+        NC_OUT err = nc_redef(ncid);
     }
 
     //Create field IDs
@@ -363,9 +405,9 @@ int main( int argc, char* argv[])
         std::string name = record.name;
         std::string long_name = record.long_name;
         id4d[name] = 0;//creates a new id4d entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 4, dim_ids,
+        NC_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 4, dim_ids,
             &id4d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id4d.at(name), "long_name", long_name.size(),
+        NC_OUT err = nc_put_att_text( ncid, id4d.at(name), "long_name", long_name.size(),
             long_name.data());
     }
     for( auto& record : feltor::restart3d_list)
@@ -373,9 +415,9 @@ int main( int argc, char* argv[])
         std::string name = record.name;
         std::string long_name = record.long_name;
         restart_ids[name] = 0;//creates a new entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, restart_dim_ids,
+        NC_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, restart_dim_ids,
             &restart_ids.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, restart_ids.at(name), "long_name", long_name.size(),
+        NC_OUT err = nc_put_att_text( ncid, restart_ids.at(name), "long_name", long_name.size(),
             long_name.data());
     }
     for( auto& record : feltor::diagnostics2d_list)
@@ -383,20 +425,24 @@ int main( int argc, char* argv[])
         std::string name = record.name + "_ta2d";
         std::string long_name = record.long_name + " (Toroidal average)";
         id3d[name] = 0;//creates a new id3d entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
+        NC_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
             &id3d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
+        NC_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
             long_name.data());
 
         name = record.name + "_2d";
         long_name = record.long_name + " (Evaluated on phi = 0 plane)";
         id3d[name] = 0;
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
+        NC_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
             &id3d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
+        NC_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
             long_name.data());
     }
-    MPI_OUT err = nc_enddef(ncid);
+    NC_OUT err = nc_enddef(ncid);
+#ifdef FELTOR_MPI
+    //writes to unlimited variables must be collective
+    if(parallel_output) err = nc_var_par_access( ncid, tvarID, NC_COLLECTIVE);
+#endif //FELTOR_MPI
     ///////////////////////////////////first output/////////////////////////
     MPI_OUT std::cout << "First output ... \n";
     //first, update feltor (to get potential etc.)
@@ -407,7 +453,7 @@ int main( int argc, char* argv[])
         } catch( dg::Fail& fail) {
             MPI_OUT std::cerr << "CG failed to converge in first step to "
                               <<fail.epsilon()<<std::endl;
-            MPI_OUT err = nc_close(ncid);
+            NC_OUT err = nc_close(ncid);
 #ifdef FELTOR_MPI
             MPI_Abort(MPI_COMM_WORLD, -1);
 #endif //FELTOR_MPI
@@ -416,19 +462,19 @@ int main( int argc, char* argv[])
     }
 
     size_t start = 0, count = 1;
-    MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+    NC_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
     for( auto& record : feltor::diagnostics3d_list)
     {
         record.function( resultD, var);
         dg::blas2::symv( projectD, resultD, transferD);
         dg::assign( transferD, transferH);
-        dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
+        dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH, parallel_output);
     }
     for( auto& record : feltor::restart3d_list)
     {
         record.function( resultD, var);
         dg::assign( resultD, resultH);
-        dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
+        dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH, parallel_output);
     }
     for( auto& record : feltor::diagnostics2d_list)
     {
@@ -446,7 +492,10 @@ int main( int argc, char* argv[])
         tti.toc();
         MPI_OUT std::cout<< name << " Computing average took "<<tti.diff()<<"\n";
         tti.tic();
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d, parallel_output);
+#ifdef FELTOR_MPI
+        else if(parallel_output) dg::file::put_vara_empty( ncid, id3d.at(name));
+#endif //FELTOR_MPI
         tti.toc();
         MPI_OUT std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
         tti.tic();
@@ -456,12 +505,26 @@ int main( int argc, char* argv[])
         feltor::slice_vector3d( transferD, transferD2d, local_size2d);
         dg::assign( transferD2d, transferH2d);
         if( record.integral) time_integrals[name].init( time, transferH2d);
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d, parallel_output);
+#ifdef FELTOR_MPI
+        else if(parallel_output) dg::file::put_vara_empty( ncid, id3d.at(name));
+#endif //FELTOR_MPI
         tti.toc();
         MPI_OUT std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
     }
-    MPI_OUT err = nc_close(ncid);
+    NC_OUT err = nc_close(ncid);
     MPI_OUT std::cout << "First write successful!\n";
+    //from now on the file is written in the background
+    //(parallel output is collective and thus written synchronously)
+#ifdef FELTOR_MPI
+    std::unique_ptr<feltor::AsyncWriter> writer_ptr( parallel_output ?
+        new feltor::AsyncWriter( file_name, comm) :
+        new feltor::AsyncWriter( file_name, (size_t)p.output_buffer<<20, rank==0));
+#else
+    std::unique_ptr<feltor::AsyncWriter> writer_ptr(
+        new feltor::AsyncWriter( file_name, (size_t)p.output_buffer<<20));
+#endif //FELTOR_MPI
+    feltor::AsyncWriter& writer = *writer_ptr;
     ///////////////////////////////////////Timeloop/////////////////////////////////
     //dg::Karniadakis< std::array<std::array<DVec,2>,2 >,
     //    feltor::FeltorSpecialSolver<
@@ -579,55 +642,82 @@ int main( int argc, char* argv[])
         ti.tic();
         //////////////////////////write fields////////////////////////
         start = i;
-        MPI_OUT err = nc_open(file_name.data(), NC_WRITE, &ncid);
-        MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
-        for( auto& record : feltor::diagnostics3d_list)
-        {
-            record.function( resultD, var);
-            dg::blas2::symv( projectD, resultD, transferD);
-            dg::assign( transferD, transferH);
-            dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
-        }
-        for( auto& record : feltor::restart3d_list)
-        {
-            record.function( resultD, var);
-            dg::assign( resultD, resultH);
-            dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
-        }
-        for( auto& record : feltor::diagnostics2d_list)
-        {
-            if(record.integral) // we already computed the output...
+        try{
+            writer.open();
+            writer.put_time( tvarID, start, time);
+            for( auto& record : feltor::diagnostics3d_list)
             {
-                std::string name = record.name+"_ta2d";
-                transferH2d = time_integrals.at(name).get_integral();
-                time_integrals.at(name).flush();
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
-
-                name = record.name+"_2d";
-                transferH2d = time_integrals.at(name).get_integral( );
-                time_integrals.at(name).flush( );
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                record.function( resultD, var);
+                dg::blas2::symv( projectD, resultD, transferD);
+                dg::assign( transferD, transferH);
+                writer.put_vara_double( id4d.at(record.name), start, g3d_out, transferH);
             }
-            else // compute from scratch
+            for( auto& record : feltor::restart3d_list)
             {
                 record.function( resultD, var);
-                dg::blas2::symv( projectD, resultD, transferD);
+                dg::assign( resultD, resultH);
+                writer.put_var_double( restart_ids.at(record.name), grid, resultH);
+            }
+            for( auto& record : feltor::diagnostics2d_list)
+            {
+                if(record.integral) // we already computed the output...
+                {
+                    std::string name = record.name+"_ta2d";
+                    transferH2d = time_integrals.at(name).get_integral();
+                    time_integrals.at(name).flush();
+                    if(write2d) writer.put_vara_double( id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                    else writer.put_empty( id3d.at(name));
+
+                    name = record.name+"_2d";
+                    transferH2d = time_integrals.at(name).get_integral( );
+                    time_integrals.at(name).flush( );
+                    if(write2d) writer.put_vara_double( id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                    else writer.put_empty( id3d.at(name));
+                }
+                else // compute from scratch
+                {
+                    record.function( resultD, var);
+                    dg::blas2::symv( projectD, resultD, transferD);
 
-                std::string name = record.name+"_ta2d";
-                dg::assign( transferD, transferH);
-                toroidal_average( transferH, transferH2d, false);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
-
-                // 2d data of plane varphi = 0
-                name = record.name+"_2d";
-                feltor::slice_vector3d( transferD, transferD2d, local_size2d);
-                dg::assign( transferD2d, transferH2d);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                    std::string name = record.name+"_ta2d";
+                    dg::assign( transferD, transferH);
+                    toroidal_average( transferH, transferH2d, false);
+                    if(write2d) writer.put_vara_double( id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                    else writer.put_empty( id3d.at(name));
+
+                    // 2d data of plane varphi = 0
+                    name = record.name+"_2d";
+                    feltor::slice_vector3d( transferD, transferD2d, local_size2d);
+                    dg::assign( transferD2d, transferH2d);
+                    if(write2d) writer.put_vara_double( id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                    else writer.put_empty( id3d.at(name));
+                }
             }
+            writer.close();
+        }catch( std::exception& e)
+        {
+            MPI_OUT std::cerr << "ERROR writing output file "<<file_name<<std::endl;
+            MPI_OUT std::cerr << e.what()<<std::endl;
+#ifdef FELTOR_MPI
+            MPI_Abort(MPI_COMM_WORLD, -1);
+#endif //FELTOR_MPI
+            return -1;
         }
-        MPI_OUT err = nc_close(ncid);
         ti.toc();
-        MPI_OUT std::cout << "\n\t Time for output: "<<ti.diff()<<"s\n\n"<<std::flush;
+        MPI_OUT std::cout << "\n\t Time for output: "<<ti.diff()<<"s";
+        MPI_OUT std::cout << "\n\t Output queued: "<<writer.queued_bytes()/1e6<<"MB"
+                          << " (total wait for writer "<<writer.blocked_time()<<"s)\n\n"<<std::flush;
+    }
+    try{
+        writer.wait();
+    }catch( std::exception& e)
+    {
+        MPI_OUT std::cerr << "ERROR writing output file "<<file_name<<std::endl;
+        MPI_OUT std::cerr << e.what()<<std::endl;
+#ifdef FELTOR_MPI
+        MPI_Abort(MPI_COMM_WORLD, -1);
+#endif //FELTOR_MPI
+        return -1;
     }
     t.toc();
     unsigned hour = (unsigned)floor(t.diff()/3600);
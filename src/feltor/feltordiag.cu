@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <algorithm>
 #include "json/json.h"
 
 #include "dg/algorithm.h"
@@ -15,24 +16,42 @@ using DMatrix = dg::DMatrix;
 using IDMatrix = dg::IDMatrix;
 using IHMatrix = dg::IHMatrix;
 using Geometry = dg::CylindricalGrid3d;
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+//without OpenMP the slices are computed one at a time, so the toroidal average can stay on the device
+using FieldalignedMatrix = IDMatrix;
+using FieldalignedVec = DVec;
+#else
+//host vectors (dg::SerialTag) such that several threads can use it
+using FieldalignedMatrix = IHMatrix;
+using FieldalignedVec = HVec;
+#endif //THRUST_DEVICE_SYSTEM
 #define MPI_OUT
 #include "feltordiag.h"
+#include "slice_engine.h"
 
 int main( int argc, char* argv[])
 {
-    if( argc < 3)
+    //the number of slices that are processed together (0 means automatic)
+    unsigned batch_size = 0;
+    int first = 1;
+    if( argc > 2 && std::string( argv[1]) == "--batch-size")
     {
-        std::cerr << "Usage: "<<argv[0]<<" [input0.nc ... inputN.nc] [output.nc]\n";
+        batch_size = std::stoi( argv[2]);
+        first = 3;
+    }
+    if( argc - first < 2)
+    {
+        std::cerr << "Usage: "<<argv[0]<<" [--batch-size N] [input0.nc ... inputN.nc] [output.nc]\n";
         return -1;
     }
-    for( int i=1; i<argc-1; i++)
+    for( int i=first; i<argc-1; i++)
         std::cout << argv[i]<< " ";
     std::cout << " -> "<<argv[argc-1]<<std::endl;
 
     //------------------------open input nc file--------------------------------//
     dg::file::NC_Error_Handle err;
     int ncid_in;
-    err = nc_open( argv[1], NC_NOWRITE, &ncid_in); //open 3d file
+    err = nc_open( argv[first], NC_NOWRITE, &ncid_in); //open 3d file
     size_t length;
     err = nc_inq_attlen( ncid_in, NC_GLOBAL, "inputfile", &length);
     std::string inputfile(length, 'x');
@@ -101,11 +120,10 @@ int main( int argc, char* argv[])
     // Construct weights and temporaries
 
     dg::HVec transferH2d = dg::evaluate(dg::zero,g2d_out);
-    dg::HVec t2d_mp = dg::evaluate(dg::zero,g2d_out);
     std::cout << "Construct Fieldaligned derivative ... \n";
 
     auto bhat = dg::geo::createBHat( mag);
-    dg::geo::Fieldaligned<Geometry, IDMatrix, DVec> fieldaligned(
+    dg::geo::Fieldaligned<Geometry, FieldalignedMatrix, FieldalignedVec> fieldaligned(
         bhat, g3d_fine, dg::NEU, dg::NEU, dg::geo::NoLimiter(), //let's take NEU bc because N is not homogeneous
         p.rk4eps, 5, 5);
 
@@ -141,7 +159,7 @@ int main( int argc, char* argv[])
     dg::Grid1d g1d_out(psipO, psipmax, npsi, Npsi, dg::DIR_NEU); //inner value is always 0
     std::cout << "Cell separatrix boundary is "<<Npsi*(1.-fx_0)*g1d_out.h()+g1d_out.x0()<<"\n";
     const double f0 = ( gridX2d.x1() - gridX2d.x0() ) / ( psipmax - psipO );
-    dg::HVec t1d = dg::evaluate( dg::zero, g1d_out), fsa1d( t1d);
+    dg::HVec t1d = dg::evaluate( dg::zero, g1d_out);
     dg::HVec transfer1d = dg::evaluate(dg::zero,g1d_out);
 
     /// ------------------- Compute 1d flux labels ---------------------//
@@ -224,7 +242,6 @@ int main( int argc, char* argv[])
 
     size_t count1d[2] = {1, g1d_out.n()*g1d_out.N()};
     size_t count2d[3] = {1, g2d_out.n()*g2d_out.Ny(), g2d_out.n()*g2d_out.Nx()};
-    size_t start2d[3] = {0, 0, 0};
 
     //write 1d static vectors (psi, q-profile, ...) into file
     for( auto tp : map1d)
@@ -306,16 +323,25 @@ int main( int argc, char* argv[])
             long_name.data());
     }
     /////////////////////////////////////////////////////////////////////////
-    size_t counter = 0;
-    int ncid;
-    for( int j=1; j<argc-1; j++)
+    // open all input files and enumerate the time slices
+    struct Input
     {
-        int timeID;
-
+        int ncid, timeID;
+        std::map<std::string, int> ids; //only available variables
+    };
+    struct SliceID
+    {
+        unsigned input, step, steps;
+    };
+    std::vector<Input> inputs;
+    std::vector<SliceID> slices;
+    for( int j=first; j<argc-1; j++)
+    {
+        Input in;
         size_t steps;
         std::cout << "Opening file "<<argv[j]<<"\n";
         try{
-            err = nc_open( argv[j], NC_NOWRITE, &ncid); //open 3d file
+            err = nc_open( argv[j], NC_NOWRITE, &in.ncid); //open 3d file
         } catch ( dg::file::NC_Error& error)
         {
             std::cerr << "An error occurded opening file "<<argv[j]<<"\n";
@@ -323,178 +349,223 @@ int main( int argc, char* argv[])
             std::cerr << "Continue with next file\n";
             continue;
         }
-        err = nc_inq_unlimdim( ncid, &timeID); //Attention: Finds first unlimited dim, which hopefully is time and not energy_time
-        err = nc_inq_dimlen( ncid, timeID, &steps);
-        //steps = 3;
-        for( unsigned i=0; i<steps; i++)//timestepping
-        {
-            if( j > 1 && i == 0)
-                continue; // else we duplicate the first timestep
-            start2d[0] = i;
-            size_t start2d_out[3] = {counter, 0,0};
-            size_t start1d_out[2] = {counter, 0};
-            // read and write time
-            double time=0.;
-            err = nc_get_vara_double( ncid, timeID, start2d, count2d, &time);
-            std::cout << counter << " Timestep = " << i <<"/"<<steps-1 << "  time = " << time << std::endl;
-            counter++;
-            err = nc_put_vara_double( ncid_out, tvarID, start2d_out, count2d, &time);
-            for( auto& record : feltor::diagnostics2d_list)
+        err = nc_inq_unlimdim( in.ncid, &in.timeID); //Attention: Finds first unlimited dim, which hopefully is time and not energy_time
+        err = nc_inq_dimlen( in.ncid, in.timeID, &steps);
+        for( auto& record : feltor::diagnostics2d_list)
+            for( std::string name : {record.name+"_ta2d", record.name+"_2d"})
             {
-                std::string record_name = record.name;
-                if( record_name[0] == 'j')
-                    record_name[1] = 'v';
-                //1. Read toroidal average
-                int dataID =0;
-                bool available = true;
-                try{
-                    err = nc_inq_varid(ncid, (record.name+"_ta2d").data(), &dataID);
-                } catch ( dg::file::NC_Error& error)
-                {
-                    if(  i == 0)
-                    {
-                        std::cerr << error.what() <<std::endl;
-                        std::cerr << "Offending variable is "<<record.name+"_ta2d\n";
-                        std::cerr << "Writing zeros ... \n";
-                    }
-                    available = false;
-                }
-                if( available)
-                {
-                    err = nc_get_vara_double( ncid, dataID,
-                        start2d, count2d, transferH2d.data());
-                    DVec transferD2d = transferH2d;
-                    fieldaligned.integrate_between_coarse_grid( g3d, transferD2d, transferD2d);
-                    transferH2d = transferD2d;
-                    t2d_mp = transferH2d; //save toroidal average
-                    //2. Compute fsa and output fsa
-                    dg::blas2::symv( grid2gridX2d, transferH2d, transferH2dX); //interpolate onto X-point grid
-                    dg::blas1::pointwiseDot( transferH2dX, volX2d, transferH2dX); //multiply by sqrt(g)
-                    poloidal_average( transferH2dX, t1d, false); //average over eta
-                    dg::blas1::scal( t1d, 4*M_PI*M_PI*f0); //
-                    dg::blas1::copy( 0., fsa1d); //get rid of previous nan in fsa1d (nasty bug)
-                    if( record_name[0] != 'j')
-                        dg::blas1::pointwiseDivide( t1d, dvdpsip, fsa1d );
-                    else
-                        dg::blas1::copy( t1d, fsa1d);
-                    //3. Interpolate fsa on 2d plane : <f>
-                    dg::blas2::gemv(fsa2rzmatrix, fsa1d, transferH2d); //fsa on RZ grid
-                }
-                else
-                {
-                    dg::blas1::scal( fsa1d, 0.);
-                    dg::blas1::scal( transferH2d, 0.);
-                    dg::blas1::scal( t2d_mp, 0.);
-                }
-                err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_fsa"),
-                    start1d_out, count1d, fsa1d.data());
-                err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fsa2d"),
-                    start2d_out, count2d, transferH2d.data() );
-                if( record_name[0] == 'j')
-                    dg::blas1::pointwiseDot( t2d_mp, dvdpsip2d, t2d_mp );//make it jv
-                err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_cta2d"),
-                    start2d_out, count2d, t2d_mp.data() );
-                //4. Read 2d variable and compute fluctuations
-                available = true;
+                int dataID = 0;
                 try{
-                    err = nc_inq_varid(ncid, (record.name+"_2d").data(), &dataID);
+                    err = nc_inq_varid(in.ncid, name.data(), &dataID);
+                    in.ids[name] = dataID;
                 } catch ( dg::file::NC_Error& error)
                 {
-                    if(  i == 0)
-                    {
-                        std::cerr << error.what() <<std::endl;
-                        std::cerr << "Offending variable is "<<record.name+"_2d\n";
-                        std::cerr << "Writing zeros ... \n";
-                    }
-                    available = false;
-                }
-                if( available)
-                {
-                    err = nc_get_vara_double( ncid, dataID, start2d, count2d,
-                        t2d_mp.data());
-                    if( record_name[0] == 'j')
-                        dg::blas1::pointwiseDot( t2d_mp, dvdpsip2d, t2d_mp );
-                    dg::blas1::axpby( 1.0, t2d_mp, -1.0, transferH2d);
-                    err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fluc2d"),
-                        start2d_out, count2d, transferH2d.data() );
-
-                    //5. flux surface integral/derivative
-                    double result =0.;
-                    if( record_name[0] == 'j') //j indicates a flux
-                    {
-                        dg::blas2::symv( dpsi, fsa1d, t1d);
-                        dg::blas1::pointwiseDivide( t1d, dvdpsip, transfer1d);
-
-                        result = dg::interpolate( dg::xspace, fsa1d, -1e-12, g1d_out);
-                    }
-                    else
-                    {
-                        dg::blas1::pointwiseDot( fsa1d, dvdpsip, t1d);
-                        transfer1d = dg::integrate( t1d, g1d_out);
-
-                        result = dg::interpolate( dg::xspace, transfer1d, -1e-12, g1d_out); //make sure to take inner cell for interpolation
-                    }
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_ifs"),
-                        start1d_out, count1d, transfer1d.data());
-                    //flux surface integral/derivative on last closed flux surface
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_lcfs"),
-                        start2d_out, count2d, &result );
-                    //6. Compute norm of time-integral terms to get relative importance
-                    if( record_name[0] == 'j') //j indicates a flux
-                    {
-                        dg::blas2::symv( dpsi, fsa1d, t1d);
-                        dg::blas1::pointwiseDivide( t1d, dvdpsip, t1d); //dvjv
-                        dg::blas1::pointwiseDot( t1d, t1d, t1d);//dvjv2
-                        dg::blas1::pointwiseDot( t1d, dvdpsip, t1d);//dvjv2
-                        transfer1d = dg::integrate( t1d, g1d_out);
-                        result = dg::interpolate( dg::xspace, transfer1d, -1e-12, g1d_out);
-                        result = sqrt(result);
-                    }
-                    else
-                    {
-                        dg::blas1::pointwiseDot( fsa1d, fsa1d, t1d);
-                        dg::blas1::pointwiseDot( t1d, dvdpsip, t1d);
-                        transfer1d = dg::integrate( t1d, g1d_out);
-
-                        result = dg::interpolate( dg::xspace, transfer1d, -1e-12, g1d_out);
-                        result = sqrt(result);
-                    }
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_norm"),
-                        start2d_out, count2d, &result );
-                    //7. Compute midplane fluctuation amplitudes
-                    dg::blas1::pointwiseDot( transferH2d, transferH2d, transferH2d);
-                    dg::blas2::symv( grid2gridX2d, transferH2d, transferH2dX); //interpolate onto X-point grid
-                    dg::blas1::pointwiseDot( transferH2dX, volX2d, transferH2dX); //multiply by sqrt(g)
-                    poloidal_average( transferH2dX, t1d, false); //average over eta
-                    dg::blas1::scal( t1d, 4*M_PI*M_PI*f0); //
-                    dg::blas1::pointwiseDivide( t1d, dvdpsip, fsa1d );
-                    dg::blas1::transform ( fsa1d, fsa1d, dg::SQRT<double>() );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_std_fsa"),
-                        start1d_out, count1d, fsa1d.data());
-                }
-                else
-                {
-                    dg::blas1::scal( transferH2d, 0.);
-                    dg::blas1::scal( transfer1d, 0.);
-                    double result = 0.;
-                    err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fluc2d"),
-                        start2d_out, count2d, transferH2d.data() );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_ifs"),
-                        start1d_out, count1d, transfer1d.data());
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_lcfs"),
-                        start2d_out, count2d, &result );
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_norm"),
-                        start2d_out, count2d, &result );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_std_fsa"),
-                        start1d_out, count1d, transfer1d.data());
+                    std::cerr << error.what() <<std::endl;
+                    std::cerr << "Offending variable is "<<name<<"\n";
+                    std::cerr << "Writing zeros ... \n";
                 }
+            }
+        for( unsigned i=0; i<steps; i++)
+        {
+            if( j > first && i == 0)
+                continue; // else we duplicate the first timestep
+            slices.push_back( {(unsigned)inputs.size(), i, (unsigned)steps});
+        }
+        inputs.push_back( in);
+    }
+    //-------------------- process slices in parallel ---------------------//
+    // Slices are read and written in the IO thread of the engine and computed
+    // in parallel. grid2gridX2d, fsa2rzmatrix, dpsi and the fieldaligned
+    // object are shared, temporaries exist once per thread
+    struct Slice
+    {
+        double time = 0.;
+        std::vector<dg::HVec> ta2d, field2d; //empty if not available
+    };
+    struct Record
+    {
+        dg::HVec fsa, fsa2d, cta2d, fluc2d, ifs, std_fsa;
+        double ifs_lcfs = 0., ifs_norm = 0.;
+    };
+    struct Result
+    {
+        double time = 0.;
+        std::vector<Record> records;
+    };
+    struct Workspace
+    {
+        dg::Average<dg::HVec> poloidal_average;
+        dg::HVec transferH2d, transferH2dX, t1d, transfer1d;
+        FieldalignedVec ta2d, cta2d;
+    };
+    std::vector<Workspace> workspaces( feltor::SliceEngine::num_threads(),
+        Workspace{ poloidal_average, transferH2d, transferH2dX, t1d, transfer1d,
+        FieldalignedVec(), FieldalignedVec()});
+    const unsigned num_records = feltor::diagnostics2d_list.size();
+    std::vector<std::string> record_names;
+    for( auto& record : feltor::diagnostics2d_list)
+    {
+        std::string record_name = record.name;
+        if( record_name[0] == 'j')
+            record_name[1] = 'v';
+        record_names.push_back( record_name);
+    }
+    const dg::HVec zero1d = dg::evaluate( dg::zero, g1d_out);
+    const dg::HVec zero2d = dg::evaluate( dg::zero, g2d_out);
 
+    auto read = [&]( unsigned k)
+    {
+        dg::file::NC_Error_Handle err;
+        const SliceID& id = slices[k];
+        const Input& in = inputs[id.input];
+        size_t start2d[3] = {id.step, 0, 0};
+        Slice slice;
+        err = nc_get_vara_double( in.ncid, in.timeID, start2d, count2d, &slice.time);
+        std::cout << k << " Timestep = " << id.step <<"/"<<id.steps-1 << "  time = " << slice.time << std::endl;
+        slice.ta2d.resize( num_records), slice.field2d.resize( num_records);
+        for( unsigned r=0; r<num_records; r++)
+        {
+            std::string name = feltor::diagnostics2d_list[r].name;
+            if( in.ids.count( name+"_ta2d"))
+            {
+                slice.ta2d[r] = zero2d;
+                err = nc_get_vara_double( in.ncid, in.ids.at(name+"_ta2d"),
+                    start2d, count2d, slice.ta2d[r].data());
+            }
+            if( in.ids.count( name+"_2d"))
+            {
+                slice.field2d[r] = zero2d;
+                err = nc_get_vara_double( in.ncid, in.ids.at(name+"_2d"),
+                    start2d, count2d, slice.field2d[r].data());
+            }
+        }
+        return slice;
+    };
+    auto compute = [&]( unsigned, Slice& slice, unsigned thread)
+    {
+        Workspace& w = workspaces[thread];
+        Result result;
+        result.time = slice.time;
+        result.records.resize( num_records);
+        for( unsigned r=0; r<num_records; r++)
+        {
+            const bool flux = record_names[r][0] == 'j'; //j indicates a flux
+            Record& out = result.records[r];
+            out.fsa = zero1d, out.fsa2d = zero2d, out.cta2d = zero2d;
+            out.fluc2d = zero2d, out.ifs = zero1d, out.std_fsa = zero1d;
+            if( !slice.ta2d[r].empty())
+            {
+                //1. Toroidal average
+                dg::assign( slice.ta2d[r], w.ta2d);
+                fieldaligned.integrate_between_coarse_grid( g3d, w.ta2d, w.cta2d);
+                dg::assign( w.cta2d, out.cta2d);
+                //2. Compute fsa
+                dg::blas2::symv( grid2gridX2d, out.cta2d, w.transferH2dX); //interpolate onto X-point grid
+                dg::blas1::pointwiseDot( w.transferH2dX, volX2d, w.transferH2dX); //multiply by sqrt(g)
+                w.poloidal_average( w.transferH2dX, w.t1d, false); //average over eta
+                dg::blas1::scal( w.t1d, 4*M_PI*M_PI*f0); //
+                if( !flux)
+                    dg::blas1::pointwiseDivide( w.t1d, dvdpsip, out.fsa );
+                else
+                    dg::blas1::copy( w.t1d, out.fsa);
+                //3. Interpolate fsa on 2d plane : <f>
+                dg::blas2::gemv(fsa2rzmatrix, out.fsa, out.fsa2d); //fsa on RZ grid
             }
+            if( flux)
+                dg::blas1::pointwiseDot( out.cta2d, dvdpsip2d, out.cta2d );//make it jv
+            if( slice.field2d[r].empty())
+                continue;
+            //4. Compute fluctuations
+            dg::HVec& field2d = slice.field2d[r];
+            if( flux)
+                dg::blas1::pointwiseDot( field2d, dvdpsip2d, field2d );
+            dg::blas1::axpby( 1.0, field2d, -1.0, out.fsa2d, out.fluc2d);
+            //5. flux surface integral/derivative
+            if( flux)
+            {
+                dg::blas2::symv( dpsi, out.fsa, w.t1d);
+                dg::blas1::pointwiseDivide( w.t1d, dvdpsip, out.ifs);
 
+                out.ifs_lcfs = dg::interpolate( dg::xspace, out.fsa, -1e-12, g1d_out);
+            }
+            else
+            {
+                dg::blas1::pointwiseDot( out.fsa, dvdpsip, w.t1d);
+                out.ifs = dg::integrate( w.t1d, g1d_out);
 
-        } //end timestepping
-        err = nc_close(ncid);
+                out.ifs_lcfs = dg::interpolate( dg::xspace, out.ifs, -1e-12, g1d_out); //make sure to take inner cell for interpolation
+            }
+            //6. Compute norm of time-integral terms to get relative importance
+            if( flux)
+            {
+                dg::blas2::symv( dpsi, out.fsa, w.t1d);
+                dg::blas1::pointwiseDivide( w.t1d, dvdpsip, w.t1d); //dvjv
+                dg::blas1::pointwiseDot( w.t1d, w.t1d, w.t1d);//dvjv2
+                dg::blas1::pointwiseDot( w.t1d, dvdpsip, w.t1d);//dvjv2
+            }
+            else
+            {
+                dg::blas1::pointwiseDot( out.fsa, out.fsa, w.t1d);
+                dg::blas1::pointwiseDot( w.t1d, dvdpsip, w.t1d);
+            }
+            w.transfer1d = dg::integrate( w.t1d, g1d_out);
+            out.ifs_norm = sqrt( dg::interpolate( dg::xspace, w.transfer1d, -1e-12, g1d_out));
+            //7. Compute midplane fluctuation amplitudes
+            dg::blas1::pointwiseDot( out.fluc2d, out.fluc2d, w.transferH2d);
+            dg::blas2::symv( grid2gridX2d, w.transferH2d, w.transferH2dX); //interpolate onto X-point grid
+            dg::blas1::pointwiseDot( w.transferH2dX, volX2d, w.transferH2dX); //multiply by sqrt(g)
+            w.poloidal_average( w.transferH2dX, w.t1d, false); //average over eta
+            dg::blas1::scal( w.t1d, 4*M_PI*M_PI*f0); //
+            dg::blas1::pointwiseDivide( w.t1d, dvdpsip, out.std_fsa );
+            dg::blas1::transform ( out.std_fsa, out.std_fsa, dg::SQRT<double>() );
+        }
+        return result;
+    };
+    auto write = [&]( unsigned k, const Result& result)
+    {
+        dg::file::NC_Error_Handle err;
+        size_t start2d_out[3] = {k, 0,0};
+        size_t start1d_out[2] = {k, 0};
+        err = nc_put_vara_double( ncid_out, tvarID, start2d_out, count2d, &result.time);
+        for( unsigned r=0; r<num_records; r++)
+        {
+            const std::string& name = record_names[r];
+            const Record& out = result.records[r];
+            err = nc_put_vara_double( ncid_out, id1d.at(name+"_fsa"),
+                start1d_out, count1d, out.fsa.data());
+            err = nc_put_vara_double( ncid_out, id2d.at(name+"_fsa2d"),
+                start2d_out, count2d, out.fsa2d.data() );
+            err = nc_put_vara_double( ncid_out, id2d.at(name+"_cta2d"),
+                start2d_out, count2d, out.cta2d.data() );
+            err = nc_put_vara_double( ncid_out, id2d.at(name+"_fluc2d"),
+                start2d_out, count2d, out.fluc2d.data() );
+            err = nc_put_vara_double( ncid_out, id1d.at(name+"_ifs"),
+                start1d_out, count1d, out.ifs.data());
+            //flux surface integral/derivative on last closed flux surface
+            err = nc_put_vara_double( ncid_out, id0d.at(name+"_ifs_lcfs"),
+                start2d_out, count2d, &out.ifs_lcfs );
+            err = nc_put_vara_double( ncid_out, id0d.at(name+"_ifs_norm"),
+                start2d_out, count2d, &out.ifs_norm );
+            err = nc_put_vara_double( ncid_out, id1d.at(name+"_std_fsa"),
+                start1d_out, count1d, out.std_fsa.data());
+        }
+    };
+    // A slice holds two input and four output fields per record and up to
+    // three batches (read, computed, written) are in memory at the same time.
+    // By default the batches are limited to about 4GB
+    const double slice_bytes = 6.*num_records*g2d_out.size()*sizeof(double);
+    if( batch_size == 0)
+        batch_size = std::max( 1u, std::min( feltor::SliceEngine::num_threads(),
+            (unsigned)( 4e9/3./slice_bytes)));
+    std::cout << "Process "<<slices.size()<<" slices with "
+              << feltor::SliceEngine::num_threads()<<" threads in batches of "
+              << batch_size<<" (about "<<3.*batch_size*slice_bytes/1e9<<"GB)\n";
+    {
+        feltor::SliceEngine engine( batch_size);
+        engine.run( slices.size(), read, compute, write);
     }
+    for( auto& in : inputs)
+        err = nc_close( in.ncid);
     err = nc_close(ncid_out);
 
     return 0;
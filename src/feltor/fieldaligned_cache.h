@@ -0,0 +1,364 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <iostream>
+
+#include "dg/file/nc_utilities.h"
+#include "dg/geometries/geometries.h"
+
+namespace feltor
+{
+
+/**
+ * @brief Store and load the expensive part of a \c dg::geo::Fieldaligned
+ * construction in a netcdf file
+ *
+ * The file holds the interpolation matrices and vectors of
+ * \c dg::geo::FieldalignedData together with the parameters that enter the
+ * field line integration (as text and as a hashed key attribute). A file
+ * whose parameters do not match or that cannot be read (e.g. because it is
+ * truncated) is ignored and overwritten. In MPI there is still only one file:
+ * the process with rank 0 reads and writes the data of all processes
+ * (one block per rank) and exchanges it with the others one at a time.
+ * A default constructed cache is disabled and never reads nor writes.
+ */
+struct FieldalignedCache
+{
+    ///@brief caching is disabled
+    FieldalignedCache() = default;
+    /**
+     * @brief Enable caching
+     * @param file_name the cache file to read from and write to
+     * @param parameters a textual representation of all parameters the
+     * data is computed with
+     */
+    FieldalignedCache( std::string file_name, std::string parameters):
+        m_file( file_name), m_parameters( parameters),
+        m_key( make_key( parameters)), m_active( true){}
+#ifdef MPI_VERSION
+    /**
+     * @brief Enable caching of distributed data
+     * @copydetails FieldalignedCache(std::string,std::string)
+     * @param comm all processes in \c comm must call \c read and \c write
+     * collectively, the data is stored in the order of the ranks in \c comm
+     */
+    FieldalignedCache( std::string file_name, std::string parameters,
+        MPI_Comm comm): FieldalignedCache( file_name, parameters)
+    {
+        m_comm = comm;
+    }
+#endif //MPI_VERSION
+    bool active() const{ return m_active;}
+
+    /**
+     * @brief Read data from file
+     *
+     * The matrices and vectors are read directly into \c data.
+     * @param data contains the cached data on output if true is returned
+     * (its content is unspecified if false is returned)
+     * @return false if the cache is disabled, the file does not exist or
+     * cannot be read or the parameters do not match (the same on all processes)
+     */
+    bool read( dg::geo::FieldalignedData& data) const
+    {
+        if( !m_active)
+            return false;
+        int rank = 0, size = 1;
+#ifdef MPI_VERSION
+        MPI_Comm_rank( m_comm, &rank);
+        MPI_Comm_size( m_comm, &size);
+#endif //MPI_VERSION
+        int ncid = -1, success = 0;
+        if( rank == 0 && nc_open( m_file.data(), NC_NOWRITE, &ncid) == NC_NOERR)
+        {
+            try{
+                //the key is a quick check before the full parameter string
+                success = get_attribute( ncid, "key") == m_key &&
+                    get_attribute( ncid, "parameters") == m_parameters;
+            }
+            catch( dg::file::NC_Error&)
+            {
+                success = 0;
+            }
+        }
+        for( int r=0; r<size; r++)
+        {
+            dg::geo::FieldalignedData block;
+            if( rank == 0 && success)
+            {
+                try{
+                    read_data( ncid, block_name( r), block);
+                }
+                catch( dg::file::NC_Error&)
+                {
+                    success = 0;
+                }
+            }
+#ifdef MPI_VERSION
+            MPI_Bcast( &success, 1, MPI_INT, 0, m_comm);
+            if( success && r != 0)
+            {
+                if( rank == 0)
+                    send_data( block, r, m_comm);
+                if( rank == r)
+                    recv_data( data, 0, m_comm);
+            }
+#endif //MPI_VERSION
+            if( !success)
+                break;
+            if( r == 0 && rank == 0)
+                data = std::move( block);
+        }
+        if( ncid != -1)
+            nc_close( ncid);
+        return success;
+    }
+    /**
+     * @brief Write data to file (overwrites any existing file)
+     *
+     * Does nothing if the cache is disabled. If the file cannot be written
+     * a warning is printed and the simulation continues. The key is written
+     * last such that an incomplete file is never read.
+     * @param data the result of \c dg::geo::Fieldaligned::make_data
+     */
+    void write( const dg::geo::FieldalignedData& data) const
+    {
+        if( !m_active)
+            return;
+        int rank = 0, size = 1;
+#ifdef MPI_VERSION
+        MPI_Comm_rank( m_comm, &rank);
+        MPI_Comm_size( m_comm, &size);
+#endif //MPI_VERSION
+        int ncid = -1;
+        bool success = ( rank == 0);
+        if( rank == 0)
+            success = nc_create( m_file.data(), NC_NETCDF4|NC_CLOBBER, &ncid) == NC_NOERR;
+        for( int r=0; r<size; r++)
+        {
+            dg::geo::FieldalignedData block;
+#ifdef MPI_VERSION
+            //the others keep sending even if writing failed
+            if( r != 0)
+            {
+                if( rank == r)
+                    send_data( data, 0, m_comm);
+                if( rank == 0)
+                    recv_data( block, r, m_comm);
+            }
+#endif //MPI_VERSION
+            if( !success)
+                continue;
+            try{
+                dg::file::NC_Error_Handle err;
+                if( r != 0)
+                    err = nc_redef( ncid);
+                write_data( ncid, block_name( r), r == 0 ? data : block);
+            }
+            catch( dg::file::NC_Error&)
+            {
+                success = false;
+            }
+        }
+        if( success)
+        {
+            try{
+                dg::file::NC_Error_Handle err;
+                err = nc_redef( ncid);
+                err = nc_put_att_text( ncid, NC_GLOBAL, "parameters",
+                    m_parameters.size(), m_parameters.data());
+                err = nc_put_att_text( ncid, NC_GLOBAL, "key", m_key.size(),
+                    m_key.data());
+            }
+            catch( dg::file::NC_Error&)
+            {
+                success = false;
+            }
+        }
+        if( ncid != -1)
+            nc_close( ncid);
+        if( rank == 0 && !success)
+            std::cerr << "WARNING: Could not write fieldaligned cache "<<m_file<<"\n";
+    }
+
+    /**
+     * @brief Hash a string of parameters into a key (64-bit FNV-1a)
+     * @param parameters a textual representation of all parameters
+     * @return hexadecimal hash followed by the size of \c parameters
+     */
+    static std::string make_key( const std::string& parameters)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for( unsigned char c : parameters)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash
+           << std::dec << "-" << parameters.size();
+        return ss.str();
+    }
+    private:
+    //throws dg::file::NC_Error if the attribute does not exist
+    static std::string get_attribute( int ncid, std::string name)
+    {
+        dg::file::NC_Error_Handle err;
+        size_t length;
+        err = nc_inq_attlen( ncid, NC_GLOBAL, name.data(), &length);
+        std::string value( length, 'x');
+        err = nc_get_att_text( ncid, NC_GLOBAL, name.data(), &value[0]);
+        return value;
+    }
+    static std::string block_name( int rank)
+    {
+        return "rank" + std::to_string( rank) + "_";
+    }
+    template<class Data>
+    static auto matrices( Data& data) -> std::array<decltype(&data.plus), 2>
+    {
+        return { &data.plus, &data.minus};
+    }
+    template<class Data>
+    static auto vectors( Data& data) -> std::array<decltype(&data.hp), 7>
+    {
+        return { &data.hp, &data.hm, &data.hbp, &data.hbm, &data.bbm,
+            &data.bbo, &data.bbp};
+    }
+    static void read_data( int ncid, std::string block, dg::geo::FieldalignedData& data)
+    {
+        dg::file::NC_Error_Handle err;
+        read_matrix( ncid, block+"plus", data.plus);
+        read_matrix( ncid, block+"minus", data.minus);
+        auto vecs = vectors( data);
+        int dimID, varID;
+        size_t size;
+        err = nc_inq_dimid( ncid, (block+"perp").data(), &dimID);
+        err = nc_inq_dimlen( ncid, dimID, &size);
+        for( unsigned i=0; i<vecs.size(); i++)
+        {
+            vecs[i]->resize( size);
+            err = nc_inq_varid( ncid, (block+vector_name(i)).data(), &varID);
+            err = nc_get_var_double( ncid, varID, thrust::raw_pointer_cast( vecs[i]->data()));
+        }
+    }
+    //ncid must be in define mode, leaves it in data mode
+    static void write_data( int ncid, std::string block, const dg::geo::FieldalignedData& data)
+    {
+        dg::file::NC_Error_Handle err;
+        int plusIDs[3], minusIDs[3], vecIDs[7], dimID;
+        define_matrix( ncid, block+"plus", data.plus, plusIDs);
+        define_matrix( ncid, block+"minus", data.minus, minusIDs);
+        auto vecs = vectors( data);
+        err = nc_def_dim( ncid, (block+"perp").data(), data.hp.size(), &dimID);
+        for( unsigned i=0; i<vecs.size(); i++)
+            err = nc_def_var( ncid, (block+vector_name(i)).data(), NC_DOUBLE, 1, &dimID, &vecIDs[i]);
+        err = nc_enddef( ncid);
+        write_matrix( ncid, plusIDs, data.plus);
+        write_matrix( ncid, minusIDs, data.minus);
+        for( unsigned i=0; i<vecs.size(); i++)
+            err = nc_put_var_double( ncid, vecIDs[i], thrust::raw_pointer_cast( vecs[i]->data()));
+    }
+#ifdef MPI_VERSION
+    static void send_data( const dg::geo::FieldalignedData& data, int dest, MPI_Comm comm)
+    {
+        for( auto m : matrices( data))
+        {
+            int shape[3] = { m->num_rows, m->num_cols, (int)m->num_entries};
+            MPI_Send( shape, 3, MPI_INT, dest, 0, comm);
+            MPI_Send( thrust::raw_pointer_cast( m->row_offsets.data()),
+                shape[0]+1, MPI_INT, dest, 0, comm);
+            MPI_Send( thrust::raw_pointer_cast( m->column_indices.data()),
+                shape[2], MPI_INT, dest, 0, comm);
+            MPI_Send( thrust::raw_pointer_cast( m->values.data()),
+                shape[2], MPI_DOUBLE, dest, 0, comm);
+        }
+        unsigned size = data.hp.size();
+        MPI_Send( &size, 1, MPI_UNSIGNED, dest, 0, comm);
+        for( auto v : vectors( data))
+            MPI_Send( thrust::raw_pointer_cast( v->data()), size, MPI_DOUBLE,
+                dest, 0, comm);
+    }
+    static void recv_data( dg::geo::FieldalignedData& data, int source, MPI_Comm comm)
+    {
+        MPI_Status status;
+        for( auto m : matrices( data))
+        {
+            int shape[3];
+            MPI_Recv( shape, 3, MPI_INT, source, 0, comm, &status);
+            m->resize( shape[0], shape[1], shape[2]);
+            MPI_Recv( thrust::raw_pointer_cast( m->row_offsets.data()),
+                shape[0]+1, MPI_INT, source, 0, comm, &status);
+            MPI_Recv( thrust::raw_pointer_cast( m->column_indices.data()),
+                shape[2], MPI_INT, source, 0, comm, &status);
+            MPI_Recv( thrust::raw_pointer_cast( m->values.data()),
+                shape[2], MPI_DOUBLE, source, 0, comm, &status);
+        }
+        unsigned size;
+        MPI_Recv( &size, 1, MPI_UNSIGNED, source, 0, comm, &status);
+        for( auto v : vectors( data))
+        {
+            v->resize( size);
+            MPI_Recv( thrust::raw_pointer_cast( v->data()), size, MPI_DOUBLE,
+                source, 0, comm, &status);
+        }
+    }
+#endif //MPI_VERSION
+    static void define_matrix( int ncid, std::string name,
+        const dg::IHMatrix& m, int* varIDs)
+    {
+        dg::file::NC_Error_Handle err;
+        int dimIDs[2];
+        err = nc_def_dim( ncid, (name+"_offsets").data(), m.num_rows+1, &dimIDs[0]);
+        err = nc_def_dim( ncid, (name+"_entries").data(), m.num_entries, &dimIDs[1]);
+        err = nc_def_var( ncid, (name+"_row_offsets").data(), NC_INT, 1, &dimIDs[0], &varIDs[0]);
+        err = nc_def_var( ncid, (name+"_column_indices").data(), NC_INT, 1, &dimIDs[1], &varIDs[1]);
+        err = nc_def_var( ncid, (name+"_values").data(), NC_DOUBLE, 1, &dimIDs[1], &varIDs[2]);
+        int shape[2] = { m.num_rows, m.num_cols};
+        err = nc_put_att_int( ncid, varIDs[0], "shape", NC_INT, 2, shape);
+    }
+    static void write_matrix( int ncid, const int* varIDs, const dg::IHMatrix& m)
+    {
+        dg::file::NC_Error_Handle err;
+        err = nc_put_var_int( ncid, varIDs[0], thrust::raw_pointer_cast( m.row_offsets.data()));
+        err = nc_put_var_int( ncid, varIDs[1], thrust::raw_pointer_cast( m.column_indices.data()));
+        err = nc_put_var_double( ncid, varIDs[2], thrust::raw_pointer_cast( m.values.data()));
+    }
+    static void read_matrix( int ncid, std::string name, dg::IHMatrix& m)
+    {
+        dg::file::NC_Error_Handle err;
+        int varIDs[3], dimID, shape[2];
+        size_t entries;
+        err = nc_inq_dimid( ncid, (name+"_entries").data(), &dimID);
+        err = nc_inq_dimlen( ncid, dimID, &entries);
+        err = nc_inq_varid( ncid, (name+"_row_offsets").data(), &varIDs[0]);
+        err = nc_inq_varid( ncid, (name+"_column_indices").data(), &varIDs[1]);
+        err = nc_inq_varid( ncid, (name+"_values").data(), &varIDs[2]);
+        err = nc_get_att_int( ncid, varIDs[0], "shape", shape);
+        size_t offsets;
+        err = nc_inq_dimid( ncid, (name+"_offsets").data(), &dimID);
+        err = nc_inq_dimlen( ncid, dimID, &offsets);
+        if( shape[0] < 0 || shape[1] < 0 || offsets != (size_t)shape[0]+1)
+            throw dg::file::NC_Error( NC_EINVAL);
+        m.resize( shape[0], shape[1], entries);
+        err = nc_get_var_int( ncid, varIDs[0], thrust::raw_pointer_cast( m.row_offsets.data()));
+        err = nc_get_var_int( ncid, varIDs[1], thrust::raw_pointer_cast( m.column_indices.data()));
+        err = nc_get_var_double( ncid, varIDs[2], thrust::raw_pointer_cast( m.values.data()));
+    }
+    static const char* vector_name( unsigned i)
+    {
+        static const char* names[7] = {"hp", "hm", "hbp", "hbm", "bbm", "bbo", "bbp"};
+        return names[i];
+    }
+    std::string m_file, m_parameters, m_key;
+    bool m_active = false;
+#ifdef MPI_VERSION
+    MPI_Comm m_comm = MPI_COMM_NULL;
+#endif //MPI_VERSION
+};
+
+}//namespace feltor
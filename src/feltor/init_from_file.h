@@ -7,17 +7,26 @@ namespace feltor
 {//We use the typedefs and MPI_OUT
 //
 //everyone reads their portion of the input data
+//(with p.output_mode == "parallel" all processes read collectively with parallel netcdf)
+//if the grid did not change the data is read directly without interpolation
 //don't forget to also read source profiles
 std::array<std::array<DVec,2>,2> init_from_file( std::string file_name, const Geometry& grid, const Parameters& p, double& time){
 #ifdef FELTOR_MPI
     int rank;
     MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    bool parallel_input = ( p.output_mode == "parallel");
 #endif
     std::array<std::array<DVec,2>,2> y0;
     ///////////////////read in and show inputfile
 
     dg::file::NC_Error_Handle errIN;
     int ncidIN;
+#ifdef FELTOR_MPI
+    if( parallel_input)
+        errIN = nc_open_par( file_name.data(), NC_NOWRITE|NC_MPIIO,
+            grid.communicator(), MPI_INFO_NULL, &ncidIN);
+    else
+#endif //FELTOR_MPI
     errIN = nc_open( file_name.data(), NC_NOWRITE, &ncidIN);
     Json::Value jsIN;
     size_t length;
@@ -41,19 +50,23 @@ std::array<std::array<DVec,2>,2> init_from_file( std::string file_name, const Ge
         , grid.communicator()
         #endif //FELTOR_MPI
         );
+    const bool same_grid = !pINsymmetric && pINn == grid.n() &&
+        pINNx == grid.Nx() && pINNy == grid.Ny() && pINNz == grid.Nz();
+    //only needed if we have to interpolate
     IHMatrix interpolateIN;
     HVec transferIN;
     if( pINsymmetric)
     {
-        std::unique_ptr< typename Geometry::perpendicular_grid> grid_perp ( static_cast<typename Geometry::perpendicular_grid*>(grid.perp_grid()));
+        std::unique_ptr< typename Geometry::perpendicular_grid> grid_perp ( static_cast<typename Geometry::perpendicular_grid*>(grid_IN.perp_grid()));
         interpolateIN = dg::create::interpolation( grid, *grid_perp);
         transferIN = dg::evaluate(dg::zero, *grid_perp);
     }
-    else
+    else if( !same_grid)
     {
         interpolateIN = dg::create::interpolation( grid, grid_IN);
         transferIN = dg::evaluate(dg::zero, grid_IN);
     }
+    MPI_OUT if( same_grid) std::cout << " Same grid: read without interpolation" << std::endl;
 
     #ifdef FELTOR_MPI
     int dimsIN[3],  coordsIN[3];
@@ -75,9 +88,26 @@ std::array<std::array<DVec,2>,2> init_from_file( std::string file_name, const Ge
         countIN[0] = 1;
         startIN[0] = 0;
     }
-    std::vector<HVec> transferOUTvec( 5, dg::evaluate( dg::zero, grid));
-
-    std::string namesIN[5] = {"restart_electrons", "restart_ions", "restart_Ue", "restart_Ui", "restart_induction"};
+    //read the local block of a field and interpolate it onto grid
+    auto read_field = [&]( std::string name, HVec& out)
+    {
+        int dataID;
+        errIN = nc_inq_varid( ncidIN, name.data(), &dataID);
+        #ifdef FELTOR_MPI
+        if( parallel_input)
+            errIN = nc_var_par_access( ncidIN, dataID, NC_COLLECTIVE);
+        #endif //FELTOR_MPI
+        HVec& target = same_grid ? out : transferIN;
+        errIN = nc_get_vara_double( ncidIN, dataID, startIN, countIN,
+            #ifdef FELTOR_MPI
+                target.data().data()
+            #else //FELTOR_MPI
+                target.data()
+            #endif //FELTOR_MPI
+            );
+        if( !same_grid)
+            dg::blas2::gemv( interpolateIN, transferIN, out);
+    };
 
     int timeIDIN;
     size_t size_time, count_time = 1;
@@ -88,32 +118,25 @@ std::array<std::array<DVec,2>,2> init_from_file( std::string file_name, const Ge
     size_time -= 1;
     errIN = nc_get_vara_double( ncidIN, timeIDIN, &size_time, &count_time, &time);
     MPI_OUT std::cout << " Current time = "<< time <<  std::endl;
-    for( unsigned i=0; i<5; i++)
-    {
-        int dataID;
-        errIN = nc_inq_varid( ncidIN, namesIN[i].data(), &dataID);
-        errIN = nc_get_vara_double( ncidIN, dataID, startIN, countIN,
-            #ifdef FELTOR_MPI
-                transferIN.data().data()
-            #else //FELTOR_MPI
-                transferIN.data()
-            #endif //FELTOR_MPI
-            );
-        dg::blas2::gemv( interpolateIN, transferIN, transferOUTvec[i]);
-    }
-    errIN = nc_close(ncidIN);
     /// ///////////////Now Construct initial fields ////////////////////////
     //
+    //the fields are read one after the other into one buffer
     //Convert to N-1 and W
-    dg::blas1::plus( transferOUTvec[0], -1.);
-    dg::blas1::plus( transferOUTvec[1], -1.);
-    dg::blas1::axpby( 1., transferOUTvec[2], 1./p.mu[0], transferOUTvec[4], transferOUTvec[2]);
-    dg::blas1::axpby( 1., transferOUTvec[3], 1./p.mu[1], transferOUTvec[4], transferOUTvec[3]);
-
-    dg::assign( transferOUTvec[0], y0[0][0]); //ne-1
-    dg::assign( transferOUTvec[1], y0[0][1]); //Ni-1
-    dg::assign( transferOUTvec[2], y0[1][0]); //We
-    dg::assign( transferOUTvec[3], y0[1][1]); //Wi
+    HVec transferOUT = dg::evaluate( dg::zero, grid), induction( transferOUT);
+    read_field( "restart_induction", induction);
+    read_field( "restart_electrons", transferOUT);
+    dg::blas1::plus( transferOUT, -1.);
+    dg::assign( transferOUT, y0[0][0]); //ne-1
+    read_field( "restart_ions", transferOUT);
+    dg::blas1::plus( transferOUT, -1.);
+    dg::assign( transferOUT, y0[0][1]); //Ni-1
+    read_field( "restart_Ue", transferOUT);
+    dg::blas1::axpby( 1., transferOUT, 1./p.mu[0], induction, transferOUT);
+    dg::assign( transferOUT, y0[1][0]); //We
+    read_field( "restart_Ui", transferOUT);
+    dg::blas1::axpby( 1., transferOUT, 1./p.mu[1], induction, transferOUT);
+    dg::assign( transferOUT, y0[1][1]); //Wi
+    errIN = nc_close(ncidIN);
     return y0;
 }
 }//namespace feltor
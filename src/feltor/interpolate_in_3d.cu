@@ -18,6 +18,7 @@ using IHMatrix = dg::IHMatrix;
 using Geometry = dg::CylindricalGrid3d;
 #define MPI_OUT
 #include "feltordiag.h"
+#include "slice_engine.h"
 
 thrust::host_vector<float> append( const thrust::host_vector<float>& in, const dg::aRealTopology3d<double>& g)
 {
@@ -181,47 +182,72 @@ int main( int argc, char* argv[])
 
 
     int timeID;
-    double time=0.;
 
     size_t steps;
     err = nc_inq_unlimdim( ncid_in, &timeID); //Attention: Finds first unlimited dim, which hopefully is time and not energy_time
     err = nc_inq_dimlen( ncid_in, timeID, &steps);
     size_t count3d_in[4]  = {1, g3d_in.Nz(), g3d_in.n()*g3d_in.Ny(), g3d_in.n()*g3d_in.Nx()};
     size_t count3d_out[4] = {1, g3d_out_periodic_equidistant.Nz(), g3d_out_equidistant.n()*g3d_out_equidistant.Ny(), g3d_out_equidistant.n()*g3d_out_equidistant.Nx()};
-    size_t start3d[4] = {0, 0, 0, 0};
-    ///////////////////////////////////////////////////////////////////////
-    for( unsigned i=0; i<steps; i+=10)//timestepping
+    std::vector<int> dataIDs; //-1 if not available
+    for( auto& record : feltor::diagnostics3d_list)
     {
-        std::cout << "Timestep = "<<i<< "/"<<steps;
-        start3d[0] = i;
-        // read and write time
-        err = nc_get_vara_double( ncid_in, timeID, start3d, count3d_in, &time);
-        std::cout << "  time = " << time << std::endl;
-        start3d[0] = i/10;
-        err = nc_put_vara_double( ncid_out, tvarID, start3d, count3d_out, &time);
-        for( auto& record : feltor::diagnostics3d_list)
+        int dataID = -1;
+        try{
+            err = nc_inq_varid(ncid_in, record.name.data(), &dataID);
+        } catch ( dg::file::NC_Error& error)
         {
-            std::string record_name = record.name;
-            int dataID =0;
-            bool available = true;
-            try{
-                err = nc_inq_varid(ncid_in, record.name.data(), &dataID);
-            } catch ( dg::file::NC_Error& error)
+            std::cerr << error.what() <<std::endl;
+            std::cerr << "Offending variable is "<<record.name<<"\n";
+            std::cerr << "Writing zeros ... \n";
+            dataID = -1;
+        }
+        dataIDs.push_back( dataID);
+    }
+    ///////////////////////////////////////////////////////////////////////
+    // Every 10th timestep is read and written in the IO thread of the engine
+    // and interpolated in parallel (fieldaligned and interpolate_in_2d are shared)
+    struct Slice
+    {
+        double time = 0.;
+        std::vector<dg::HVec> fields; //empty if not available
+    };
+    struct Result
+    {
+        double time = 0.;
+        std::vector<dg::fHVec> fields;
+    };
+    std::vector<dg::HVec> workspaces( feltor::SliceEngine::num_threads(), transferH);
+    auto read = [&]( unsigned k)
+    {
+        dg::file::NC_Error_Handle err;
+        size_t start3d[4] = {10*k, 0, 0, 0};
+        Slice slice;
+        std::cout << "Timestep = "<<10*k<< "/"<<steps;
+        // read time
+        err = nc_get_vara_double( ncid_in, timeID, start3d, count3d_in, &slice.time);
+        std::cout << "  time = " << slice.time << std::endl;
+        slice.fields.resize( dataIDs.size());
+        for( unsigned r=0; r<dataIDs.size(); r++)
+            if( dataIDs[r] != -1)
             {
-                if(  i == 0)
-                {
-                    std::cerr << error.what() <<std::endl;
-                    std::cerr << "Offending variable is "<<record.name<<"\n";
-                    std::cerr << "Writing zeros ... \n";
-                }
-                available = false;
+                slice.fields[r] = transferH_in;
+                err = nc_get_vara_double( ncid_in, dataIDs[r],
+                    start3d, count3d_in, slice.fields[r].data());
             }
-            if( available)
+        return slice;
+    };
+    auto compute = [&]( unsigned, Slice& slice, unsigned thread)
+    {
+        dg::HVec& transferH = workspaces[thread];
+        dg::fHVec transferH_out_float( transferH.size(), 0.f);
+        Result result;
+        result.time = slice.time;
+        for( auto& field : slice.fields)
+        {
+            if( !field.empty())
             {
-                err = nc_get_vara_double( ncid_in, dataID,
-                    start3d, count3d_in, transferH_in.data());
-                transferH_out = fieldaligned.interpolate_from_coarse_grid(
-                    g3d_in, transferH_in);
+                dg::HVec transferH_out = fieldaligned.interpolate_from_coarse_grid(
+                    g3d_in, field);
                 dg::blas2::symv( interpolate_in_2d, transferH_out, transferH);
                 dg::assign( transferH, transferH_out_float);
             }
@@ -229,10 +255,22 @@ int main( int argc, char* argv[])
             {
                 dg::blas1::scal( transferH_out_float, (float)0);
             }
-            err = nc_put_vara_float( ncid_out, id4d.at(record.name), start3d,
-                count3d_out, append(transferH_out_float, g3d_out_equidistant).data());
+            result.fields.push_back( append(transferH_out_float, g3d_out_equidistant));
         }
-
+        return result;
+    };
+    auto write = [&]( unsigned k, const Result& result)
+    {
+        dg::file::NC_Error_Handle err;
+        size_t start3d[4] = {k, 0, 0, 0};
+        err = nc_put_vara_double( ncid_out, tvarID, start3d, count3d_out, &result.time);
+        for( unsigned r=0; r<result.fields.size(); r++)
+            err = nc_put_vara_float( ncid_out, id4d.at(feltor::diagnostics3d_list[r].name),
+                start3d, count3d_out, result.fields[r].data());
+    };
+    {
+        feltor::SliceEngine engine;
+        engine.run( (steps+9)/10, read, compute, write);
     } //end timestepping
     err = nc_close(ncid_in);
     err = nc_close(ncid_out);
@@ -17,14 +17,20 @@ struct Parameters
     unsigned inner_loop;
     unsigned itstp;
     unsigned maxout;
+    unsigned output_buffer;
+    std::string output_mode;
 
     std::vector<double> eps_pol;
     double jfactor;
     double eps_gamma;
     double eps_time;
     unsigned stages;
+    std::string predictor;
+    unsigned predictor_max;
+    bool plane_cg;
     unsigned mx, my;
     double rk4eps;
+    std::string fa_cache;
 
     std::array<double,2> mu; // mu[0] = mu_e, m[1] = mu_i
     std::array<double,2> tau; // tau[0] = -1, tau[1] = tau_i
@@ -64,6 +70,16 @@ struct Parameters
         inner_loop = dg::file::get(mode, js, "inner_loop",1).asUInt();
         itstp   = dg::file::get( mode, js, "itstp", 0).asUInt();
         maxout  = dg::file::get( mode, js, "maxout", 0).asUInt();
+        output_buffer = dg::file::get( mode, js, "output_buffer", 1024).asUInt();
+        output_mode = dg::file::get( mode, js, "output_mode", "serial").asString();
+        if( output_mode != "serial" && output_mode != "parallel")
+        {
+            if( dg::file::error::is_throw == mode)
+                throw std::runtime_error( "Value "+output_mode+" for output_mode is invalid! Must be either serial or parallel\n");
+            else if ( dg::file::error::is_warning == mode)
+                std::cerr << "Value "+output_mode+" for output_mode is invalid!\n";
+            output_mode = "serial";
+        }
         eps_time    = dg::file::get( mode, js, "eps_time", 1e-10).asDouble();
 
         stages      = dg::file::get( mode, js, "stages", 3).asUInt();
@@ -77,10 +93,22 @@ struct Parameters
         jfactor     = dg::file::get( mode, js, "jumpfactor", 1).asDouble();
 
         eps_gamma   = dg::file::get( mode, js, "eps_gamma", 1e-6).asDouble();
+        predictor   = dg::file::get( mode, js, "predictor", "extrapolation").asString();
+        if( predictor != "extrapolation" && predictor != "projection")
+        {
+            if( dg::file::error::is_throw == mode)
+                throw std::runtime_error( "Value "+predictor+" for predictor is invalid! Must be either extrapolation or projection\n");
+            else if ( dg::file::error::is_warning == mode)
+                std::cerr << "Value "+predictor+" for predictor is invalid!\n";
+            predictor = "extrapolation";
+        }
+        predictor_max = dg::file::get( mode, js, "predictor_max", 8).asUInt();
+        plane_cg    = dg::file::get( mode, js, "plane_cg", false).asBool();
         mx          = dg::file::get_idx( mode, js,"FCI","refine", 0u, 1).asUInt();
         my          = dg::file::get_idx( mode, js,"FCI","refine", 1u, 1).asUInt();
         rk4eps      = dg::file::get( mode, js,"FCI", "rk4eps", 1e-6).asDouble();
         periodify   = dg::file::get( mode, js,"FCI", "periodify", true).asBool();
+        fa_cache    = dg::file::get( mode, js,"FCI", "cache", "").asString();
 
         mu[0]       = dg::file::get( mode, js, "mu", -0.000272121).asDouble();
         mu[1]       = +1.;
@@ -194,9 +222,12 @@ struct Parameters
             <<"     Jump scale factor:    "<<jfactor<<"\n"
             <<"     Accuracy Gamma CG:    "<<eps_gamma<<"\n"
             <<"     Accuracy Time  CG:    "<<eps_time<<"\n"
+            <<"     Initial guess:        "<<predictor<<" "<<predictor_max<<"\n"
+            <<"     Plane-wise CG:        "<<std::boolalpha<<plane_cg<<"\n"
             <<"     Accuracy Fieldline    "<<rk4eps<<"\n"
             <<"     Periodify FCI         "<<std::boolalpha<< periodify<<"\n"
             <<"     Refined FCI           "<<mx<<" "<<my<<"\n"
+            <<"     Cache FCI in          "<<(fa_cache.empty() ? "(disabled)" : fa_cache)<<"\n"
             <<"     explicit diffusion    "<<std::boolalpha<<explicit_diffusion<<"\n";
         for( unsigned i=1; i<stages; i++)
             os <<"     Factors for Multigrid "<<i<<" "<<eps_pol[i]<<"\n";
@@ -207,7 +238,9 @@ struct Parameters
             <<"     Nz_out =                 "<<Nz_out<<"\n"
             <<"     Steps between energies:  "<<inner_loop<<"\n"
             <<"     Energies between output: "<<itstp<<"\n"
-            <<"     Number of outputs:       "<<maxout<<"\n";
+            <<"     Number of outputs:       "<<maxout<<"\n"
+            <<"     Output buffer in MB:     "<<output_buffer<<"\n"
+            <<"     Output mode:             "<<output_mode<<"\n";
         os << "Boundary conditions are: \n"
             <<"     bc density x   = "<<dg::bc2str(bcxN)<<"\n"
             <<"     bc density y   = "<<dg::bc2str(bcyN)<<"\n"
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+
+namespace feltor
+{
+
+/**
+ * @brief Process the time slices of netcdf files in parallel
+ *
+ * The slices are processed in batches. The slices of a batch are distributed
+ * among OpenMP threads while a dedicated IO thread reads the next batch
+ * (prefetch) and writes the results of the previous batch. Since netcdf is
+ * not thread-safe \b all netcdf calls must be made in the IO thread, i.e. in
+ * the read and write functions given to \c run or in jobs queued with \c io.
+ * Results are written in the order of the slices.
+ *
+ * Read-only data (grids, interpolation matrices, ...) can be shared among
+ * threads, everything that is written to during the computation of a slice
+ * (temporaries, \c dg::Average, ...) must exist once per thread
+ * (cf. \c num_threads). Use vectors with \c dg::SerialTag (e.g. \c dg::HVec)
+ * in the computation, since \c dg::OmpTag vectors would distribute
+ * their work among the threads of the enclosing parallel region.
+ */
+struct SliceEngine
+{
+    /**
+     * @brief Start the IO thread
+     *
+     * @param batch_size number of slices that are read, computed and written
+     * together. If 0 the number of OpenMP threads is used.
+     * @note Up to three batches are held in memory at the same time (one is
+     * read, one computed and one written), so limit \c batch_size for large slices
+     */
+    SliceEngine( unsigned batch_size = 0): m_batch( batch_size)
+    {
+        if( m_batch == 0)
+            m_batch = num_threads();
+        m_thread = std::thread( [this](){ this->loop();});
+    }
+    SliceEngine( const SliceEngine&) = delete;
+    SliceEngine& operator=( const SliceEngine&) = delete;
+    ///@brief Finish all queued jobs and join the IO thread
+    ~SliceEngine()
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+    ///@brief Number of slices per batch
+    unsigned batch_size() const{ return m_batch;}
+    ///@brief Number of threads that compute slices (thread indices in \c run are smaller)
+    static unsigned num_threads(){
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif //_OPENMP
+    }
+
+    /**
+     * @brief Queue a job in the IO thread
+     *
+     * Jobs are executed in the order they are queued
+     * @param job callable without arguments
+     * @return future of the return value of \c job (an exception thrown in
+     * \c job is rethrown by \c get())
+     */
+    template<class Job>
+    std::future<decltype( std::declval<Job&>()())> io( Job job)
+    {
+        using result_type = decltype( job());
+        auto task = std::make_shared<std::packaged_task<result_type()>>(
+            std::move(job));
+        std::future<result_type> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock( m_mutex);
+            m_queue.push_back( [task](){ (*task)();});
+        }
+        m_cv.notify_all();
+        return future;
+    }
+
+    /**
+     * @brief Read, compute and write \c num_slices slices
+     *
+     * @param num_slices the slices \c 0,...,num_slices-1 are processed
+     * @param read <tt> Data read( unsigned slice) </tt>; called in the IO
+     * thread in the order of the slices
+     * @param compute <tt> Result compute( unsigned slice, Data& data, unsigned thread) </tt>;
+     * called concurrently in OpenMP threads, \c thread is the index of the
+     * calling thread (smaller than \c num_threads())
+     * @param write <tt> void write( unsigned slice, const Result& result) </tt>;
+     * called in the IO thread in the order of the slices
+     * @note \c Result must be default constructible
+     * @note An exception in any of the functions is rethrown after all
+     * queued jobs are finished
+     */
+    template<class Read, class Compute, class Write>
+    void run( unsigned num_slices, Read&& read, Compute&& compute, Write&& write)
+    {
+        using Data = std::decay_t<decltype( read( 0u))>;
+        using Result = std::decay_t<decltype( compute( 0u,
+            std::declval<Data&>(), 0u))>;
+        const unsigned batch = m_batch;
+        auto read_batch = [&]( unsigned first){
+            return io( [&read, first, batch, num_slices](){
+                std::vector<Data> data;
+                for( unsigned i=first; i<first+batch && i<num_slices; i++)
+                    data.push_back( read( i));
+                return data;
+            });
+        };
+        std::future<std::vector<Data>> next;
+        std::future<void> written;
+        try{
+            if( num_slices > 0)
+                next = read_batch( 0);
+            for( unsigned first=0; first<num_slices; first+=batch)
+            {
+                std::vector<Data> data = next.get();
+                if( first + batch < num_slices)
+                    next = read_batch( first+batch); //prefetch
+                int size = data.size();
+                auto results = std::make_shared<std::vector<Result>>( size);
+                std::exception_ptr error;
+#ifdef _OPENMP
+                #pragma omp parallel for schedule( dynamic, 1)
+#endif //_OPENMP
+                for( int k=0; k<size; k++)
+                {
+                    try{
+#ifdef _OPENMP
+                        unsigned thread = omp_get_thread_num();
+#else
+                        unsigned thread = 0;
+#endif //_OPENMP
+                        (*results)[k] = compute( first+k, data[k], thread);
+                    }
+                    catch( ...){
+#ifdef _OPENMP
+                        #pragma omp critical( feltor_slice_engine)
+#endif //_OPENMP
+                        error = std::current_exception();
+                    }
+                }
+                if( error)
+                    std::rethrow_exception( error);
+                //at most one batch of results waits for output
+                if( written.valid())
+                    written.get();
+                written = io( [&write, first, results](){
+                    for( unsigned k=0; k<results->size(); k++)
+                        write( first+k, (*results)[k]);
+                });
+            }
+            if( written.valid())
+                written.get();
+        }
+        catch( ...)
+        {
+            //the queued jobs reference read and write
+            if( next.valid())
+                next.wait();
+            if( written.valid())
+                written.wait();
+            throw;
+        }
+    }
+    private:
+    void loop()
+    {
+        while( true)
+        {
+            std::unique_lock<std::mutex> lock( m_mutex);
+            m_cv.wait( lock, [this]{ return !m_queue.empty() || m_stop;});
+            if( m_queue.empty()) // && m_stop
+                return;
+            std::function<void()> job = std::move( m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            job(); //exceptions are stored in the future
+        }
+    }
+    unsigned m_batch;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_queue;
+    bool m_stop = false;
+};
+
+}//namespace feltor
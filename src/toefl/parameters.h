@@ -23,7 +23,7 @@ struct Parameters
     double lx, ly;
     dg::bc bc_x, bc_y;
 
-    std::string init, equations;
+    std::string init, equations, output_mode;
     bool boussinesq;
 
     Parameters( const Json::Value& js) {
@@ -56,6 +56,7 @@ struct Parameters
         boussinesq = js.get("boussinesq", false).asBool();
         friction = js.get("friction", 0.).asDouble();
         jfactor = js.get("jfactor", 1.).asDouble();
+        output_mode = js.get("output_mode", "serial").asString();
     }
 
     void display( std::ostream& os = std::cout ) const
@@ -92,6 +93,7 @@ struct Parameters
             <<"scale for jump terms:    "<<jfactor<<"\n"
             <<"Stopping for Gamma CG:   "<<eps_gamma<<"\n"
             <<"Steps between output:    "<<itstp<<"\n"
-            <<"Number of outputs:       "<<maxout<<std::endl; //the endl is for the implicit flush
+            <<"Number of outputs:       "<<maxout<<"\n"
+            <<"Output mode:             "<<output_mode<<std::endl; //the endl is for the implicit flush
     }
 };
@@ -205,13 +205,12 @@ const container& Explicit<G, M, container>::compute_psi( double t, const contain
 template<class G, class M, class container>
 const container& Explicit<G, M, container>::polarisation( double t, const std::vector<container>& y)
 {
+    using namespace dg::blas1::lazy;
     //compute chi
     if(equations == "global" )
     {
-        dg::assign( y[1], chi);
-        dg::blas1::plus( chi, 1.);
-        dg::blas1::pointwiseDot( binv, chi, chi); //\chi = n_i
-        dg::blas1::pointwiseDot( binv, chi, chi); //\chi *= binv^2
+        //\chi = binv^2 n_i
+        dg::blas1::lazy::evaluate( _0 = _2*(_2*(_1 + 1.)), chi, y[1], binv);
         if( !boussinesq)
         {
             multigrid.project( chi, multi_chi);
@@ -222,8 +221,7 @@ const container& Explicit<G, M, container>::polarisation( double t, const std::v
     }
     else if(equations == "gravity_global" )
     {
-        dg::assign( y[0], chi);
-        dg::blas1::plus( chi, 1.);
+        dg::blas1::lazy::evaluate( _0 = _1 + 1., chi, y[0]);
         if( !boussinesq)
         {
             multigrid.project( chi, multi_chi);
@@ -234,10 +232,8 @@ const container& Explicit<G, M, container>::polarisation( double t, const std::v
     }
     else if( equations == "drift_global" )
     {
-        dg::assign( y[0], chi);
-        dg::blas1::plus( chi, 1.);
-        dg::blas1::pointwiseDot( binv, chi, chi); //\chi = n_e
-        dg::blas1::pointwiseDot( binv, chi, chi); //\chi *= binv^2
+        //\chi = binv^2 n_e
+        dg::blas1::lazy::evaluate( _0 = _2*(_2*(_1 + 1.)), chi, y[0], binv);
         if( !boussinesq)
         {
             multigrid.project( chi, multi_chi);
@@ -279,6 +275,7 @@ const container& Explicit<G, M, container>::polarisation( double t, const std::v
 template< class G, class M, class container>
 void Explicit<G, M, container>::operator()( double t, const std::vector<container>& y, std::vector<container>& yp)
 {
+    using namespace dg::blas1::lazy;
     //y[0] = N_e - 1
     //y[1] = N_i - 1 || y[1] = Omega
     assert( y.size() == 2);
@@ -289,8 +286,8 @@ void Explicit<G, M, container>::operator()( double t, const std::vector<containe
 
     for( unsigned i=0; i<y.size(); i++)
     {
-        dg::blas1::transform( y[i], ype[i], dg::PLUS<double>(1.));
-        dg::blas1::transform( ype[i], lny[i], dg::LN<double>());
+        dg::blas1::lazy::evaluate( ( _1 = _0 + 1., _2 = call( dg::LN<double>(), _1)),
+            y[i], ype[i], lny[i]);
         dg::blas2::symv( laplaceM, y[i], lapy[i]);
     }
 
@@ -21,6 +21,8 @@ using IDMatrix = dg::MIDMatrix;
 using IHMatrix = dg::MIHMatrix;
 using Geometry = dg::CartesianMPIGrid2d;
 #define MPI_OUT if(rank==0)
+//netcdf calls: in parallel output mode all processes access the file
+#define NC_OUT if(rank==0 || parallel_output)
 #else //TOEFL_MPI
 using HVec = dg::HVec;
 using DVec = dg::DVec;
@@ -30,6 +32,7 @@ using IDMatrix = dg::IDMatrix;
 using IHMatrix = dg::IHMatrix;
 using Geometry = dg::CartesianGrid2d;
 #define MPI_OUT
+#define NC_OUT
 #endif //TOEFL_MPI
 
 int main( int argc, char* argv[])
@@ -77,6 +80,10 @@ int main( int argc, char* argv[])
     MPI_OUT std::cout << js<<std::endl;
     const Parameters p( js);
     MPI_OUT p.display( std::cout);
+    bool parallel_output = false;
+#ifdef TOEFL_MPI
+    parallel_output = ( p.output_mode == "parallel");
+#endif //TOEFL_MPI
 
     ////////////////////////////////set up computations///////////////////////////
     Geometry grid( 0, p.lx, 0, p.ly, p.n, p.Nx, p.Ny, p.bc_x, p.bc_y
@@ -111,26 +118,52 @@ int main( int argc, char* argv[])
     /////////////////////////////set up netcdf/////////////////////////////////////
     dg::file::NC_Error_Handle err;
     int ncid;
+#ifdef TOEFL_MPI
+    if( parallel_output)
+        err = nc_create_par( argv[2], NC_NETCDF4|NC_MPIIO|NC_CLOBBER, comm,
+            MPI_INFO_NULL, &ncid);
+    else
+#endif //TOEFL_MPI
     MPI_OUT err = nc_create( argv[2],NC_NETCDF4|NC_CLOBBER, &ncid);
     std::string input = js.toStyledString();
-    MPI_OUT err = nc_put_att_text( ncid, NC_GLOBAL, "inputfile", input.size(), input.data());
+    NC_OUT err = nc_put_att_text( ncid, NC_GLOBAL, "inputfile", input.size(), input.data());
     int dim_ids[3], tvarID;
-    MPI_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, grid_out);
+    NC_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, grid_out);
     //field IDs
     std::string names[4] = {"electrons", "ions", "potential", "vorticity"};
     int dataIDs[4];
     for( unsigned i=0; i<4; i++){
-        MPI_OUT err = nc_def_var( ncid, names[i].data(), NC_DOUBLE, 3, dim_ids, &dataIDs[i]);}
+        NC_OUT err = nc_def_var( ncid, names[i].data(), NC_DOUBLE, 3, dim_ids, &dataIDs[i]);}
 
     //energy IDs
     int EtimeID, EtimevarID;
-    MPI_OUT err = dg::file::define_time( ncid, "energy_time", &EtimeID, &EtimevarID);
+    NC_OUT err = dg::file::define_time( ncid, "energy_time", &EtimeID, &EtimevarID);
     int energyID, massID, dissID, dEdtID;
-    MPI_OUT err = nc_def_var( ncid, "energy",      NC_DOUBLE, 1, &EtimeID, &energyID);
-    MPI_OUT err = nc_def_var( ncid, "mass",        NC_DOUBLE, 1, &EtimeID, &massID);
-    MPI_OUT err = nc_def_var( ncid, "dissipation", NC_DOUBLE, 1, &EtimeID, &dissID);
-    MPI_OUT err = nc_def_var( ncid, "dEdt",        NC_DOUBLE, 1, &EtimeID, &dEdtID);
-    MPI_OUT err = nc_enddef(ncid);
+    NC_OUT err = nc_def_var( ncid, "energy",      NC_DOUBLE, 1, &EtimeID, &energyID);
+    NC_OUT err = nc_def_var( ncid, "mass",        NC_DOUBLE, 1, &EtimeID, &massID);
+    NC_OUT err = nc_def_var( ncid, "dissipation", NC_DOUBLE, 1, &EtimeID, &dissID);
+    NC_OUT err = nc_def_var( ncid, "dEdt",        NC_DOUBLE, 1, &EtimeID, &dEdtID);
+    NC_OUT err = nc_enddef(ncid);
+#ifdef TOEFL_MPI
+    //writes to unlimited variables must be collective in parallel mode
+    if( parallel_output)
+        for( int id : {tvarID, EtimevarID, energyID, massID, dissID, dEdtID})
+            err = nc_var_par_access( ncid, id, NC_COLLECTIVE);
+#endif //TOEFL_MPI
+    //open the file for output (in parallel mode on all processes)
+    auto open_output = [&]( )
+    {
+#ifdef TOEFL_MPI
+        if( parallel_output)
+        {
+            err = nc_open_par( argv[2], NC_WRITE|NC_MPIIO, comm, MPI_INFO_NULL, &ncid);
+            for( int id : {tvarID, EtimevarID, energyID, massID, dissID, dEdtID})
+                err = nc_var_par_access( ncid, id, NC_COLLECTIVE);
+            return;
+        }
+#endif //TOEFL_MPI
+        MPI_OUT err = nc_open( argv[2], NC_WRITE, &ncid);
+    };
     DVec transfer( dg::evaluate( dg::zero, grid));
     ///////////////////////////////////first output/////////////////////////
     size_t start = 0, count = 1;
@@ -147,10 +180,10 @@ int main( int argc, char* argv[])
     for( int k=0;k<4; k++)
     {
         dg::assign( transferD[k], transferH);
-        dg::file::put_vara_double( ncid, dataIDs[k], start, grid_out, transferH);
+        dg::file::put_vara_double( ncid, dataIDs[k], start, grid_out, transferH, parallel_output);
     }
-    MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
-    MPI_OUT err = nc_close(ncid);
+    NC_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+    NC_OUT err = nc_close(ncid);
     ///////////////////////////////////////Timeloop/////////////////////////////////
     const double mass0 = exp.mass(), mass_blob0 = mass0 - grid.lx()*grid.ly();
     double E0 = exp.energy(), E1 = 0, diff = 0;
@@ -183,14 +216,14 @@ int main( int argc, char* argv[])
             }
             Estart[0] += 1;
             {
-                MPI_OUT err = nc_open(argv[2], NC_WRITE, &ncid);
+                open_output();
                 double ener=exp.energy(), mass=exp.mass(), diff=exp.mass_diffusion(), dEdt=exp.energy_diffusion();
-                MPI_OUT err = nc_put_vara_double( ncid, EtimevarID, Estart, Ecount, &time);
-                MPI_OUT err = nc_put_vara_double( ncid, energyID,   Estart, Ecount, &ener);
-                MPI_OUT err = nc_put_vara_double( ncid, massID,     Estart, Ecount, &mass);
-                MPI_OUT err = nc_put_vara_double( ncid, dissID,     Estart, Ecount, &diff);
-                MPI_OUT err = nc_put_vara_double( ncid, dEdtID,     Estart, Ecount, &dEdt);
-                MPI_OUT err = nc_close(ncid);
+                NC_OUT err = nc_put_vara_double( ncid, EtimevarID, Estart, Ecount, &time);
+                NC_OUT err = nc_put_vara_double( ncid, energyID,   Estart, Ecount, &ener);
+                NC_OUT err = nc_put_vara_double( ncid, massID,     Estart, Ecount, &mass);
+                NC_OUT err = nc_put_vara_double( ncid, dissID,     Estart, Ecount, &diff);
+                NC_OUT err = nc_put_vara_double( ncid, dEdtID,     Estart, Ecount, &dEdt);
+                NC_OUT err = nc_close(ncid);
             }
         }
         //////////////////////////write fields////////////////////////
@@ -200,14 +233,14 @@ int main( int argc, char* argv[])
         dg::blas2::symv( interpolate, exp.potential()[0], transferD[2]);
         dg::blas2::symv( imp.laplacianM(), exp.potential()[0], transfer);
         dg::blas2::symv( interpolate, transfer, transferD[3]);
-        MPI_OUT err = nc_open(argv[2], NC_WRITE, &ncid);
+        open_output();
         for( int k=0;k<4; k++)
         {
             dg::assign( transferD[k], transferH);
-            dg::file::put_vara_double( ncid, dataIDs[k], start, grid_out, transferH);
+            dg::file::put_vara_double( ncid, dataIDs[k], start, grid_out, transferH, parallel_output);
         }
-        MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
-        MPI_OUT err = nc_close(ncid);
+        NC_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+        NC_OUT err = nc_close(ncid);
 
 #ifdef DG_BENCHMARK
         ti.toc();